@@ -17,6 +17,7 @@
 #include <gauxc/basisset_map.hpp>
 #include <gauxc/shell_pair.hpp>
 #include <gauxc/xc_task.hpp>
+#include <gauxc/task_cost_model.hpp>
 #include <gauxc/util/timer.hpp>
 #include <gauxc/runtime_environment.hpp>
 #include <gauxc/enums.hpp>
@@ -34,6 +35,27 @@ struct LoadBalancerState {
     ///< Whether the load balancer currently stores partitioned weights
   XCWeightAlg weight_alg = XCWeightAlg::NOTPARTITIONED; 
     ///< Weight partitioning scheme used by this LoadBalancer
+  bool retain_unpartitioned_weights = false;
+    ///< Whether modify_weights keeps a copy of the unpartitioned weights 
+    ///< (required by update_geometry after the weights were modified)
+  bool partition_weights_on_the_fly = false;
+    ///< Whether the (host) integrators partition the unmodified task weights
+    ///< with weight_alg per task rather than reading stored weights
+};
+
+
+/// Target task granularity of LoadBalancer::refine_tasks (0 = derived)
+struct TaskGranularitySettings {
+  double max_cost = 0.;
+    ///< Tasks above this (exc-vxc) cost are split by point ranges. Derived
+    ///< as 1/(8 x nthreads) of the local cost, which bounds the idle tail 
+    ///< of a dynamically scheduled task loop
+  size_t min_npts_x_nbe = 0;
+    ///< Tasks below this size are merged. Derived such that the collocation
+    ///< and gradient (4 x npts x nbe) of a task fills the L2 cache
+  double max_nbe_overhead = 0.25;
+    ///< Largest relative increase of the npts x nbe^2 work of the merged
+    ///< tasks (due to the union of their shell lists)
 };
 
 
@@ -67,11 +89,31 @@ public:
   /// Destruct LoadBalancer instance (defaulted)
   ~LoadBalancer() noexcept;
 
-  /// Get underlying (local) quadrature tasks for this process (cost)
+  /// Get underlying (local) quadrature tasks for this process (const,
+  /// throws while compacted)
   const std::vector<XCTask>& get_tasks() const;
-  /// Get underlying (local) quadrature tasks for this process (non-cost)
+  /// Get underlying (local) quadrature tasks for this process (non-const,
+  /// expands compacted tasks)
         std::vector<XCTask>& get_tasks()      ;
 
+  /** Store the local tasks in compact form until they are next accessed
+   *
+   *  Points (SoA) and weights are held in shared arenas, equal shell lists
+   *  are stored once and coulomb screening data only for tasks which carry
+   *  any. Derived screening data (submatrix maps) is dropped. The tasks are
+   *  expanded to XCTask by the next non-const get_tasks (e.g. the next
+   *  integrator evaluation) and stay expanded, const get_tasks throws while
+   *  compacted. Intended to reduce the footprint of load balancers which
+   *  are kept but not currently in use.
+   */
+  void compact_tasks();
+
+  /// Whether the local tasks are currently compacted
+  bool tasks_are_compact() const;
+
+  /// Bytes held by the local tasks (compact or not)
+  size_t tasks_volume() const;
+
   /// Rebalance quadrature batches according to weight-only cost
   void rebalance_weights();
 
@@ -118,6 +160,102 @@ public:
   /// Return the load balancer state (non-const)
   LoadBalancerState& state();
 
+  /** Attach a measured task cost model
+   *
+   *  Host integrators record per-task wall times into the model and refit
+   *  it collectively after every evaluation, and the initial task
+   *  assignment (if tasks have not yet been created) as well as
+   *  rebalance_exc_vxc / rebalance_exx use its calibrated predictions.
+   *  These require the same model on every rank: attach it on all ranks
+   *  (models imported from a file must be identical). The model may be
+   *  shared between LoadBalancer instances.
+   */
+  void set_cost_model( std::shared_ptr<TaskCostModel> model );
+
+  /// Return the attached task cost model (null if none)
+  std::shared_ptr<TaskCostModel> cost_model() const;
+
+  /** Identifier of the refine_tasks / rebalance_* calls applied to the
+   *  local tasks since they were generated (0 if none)
+   *
+   *  Depends only on the sequence of calls (and their requested settings),
+   *  not on the tasks, such that it may be stored to reload a task cache.
+   */
+  uint64_t task_layout() const;
+
+  /** Identifier of the current contents of the local tasks (0 if no tasks
+   *  have been created)
+   *
+   *  Unique within the process. Changes whenever the tasks are created or
+   *  replaced (refine_tasks, rebalance_*, load_task_cache, expansion of
+   *  compacted tasks), by update_geometry and by mark_tasks_modified, such
+   *  that data derived from the tasks (e.g. integrator execution plans)
+   *  may be reused while it is unchanged.
+   */
+  size_t tasks_generation() const;
+
+  /// Signal that the local tasks were modified through the non-const
+  /// get_tasks (assigns a new tasks_generation)
+  void mark_tasks_modified();
+
+  /** Write the local tasks (incl. partitioned weights) and state to disk
+   *
+   *  Generates the tasks if needed. Each rank writes its own file
+   *  `<prefix>.<key>.rank<rank>.gtc`, where `key` hashes the load balancer
+   *  kernel and generation mode (replicated / distributed), rank layout, 
+   *  molecule, basis, grid, the weight scheme of the stored weights and the
+   *  task_layout().
+   */
+  void save_task_cache( const std::string& prefix );
+
+  /** Load the local tasks from a task cache written by save_task_cache
+   *
+   *  Collective: the cached tasks are only adopted if they exist on every
+   *  rank.
+   *
+   *  @param[in] prefix      File prefix passed to save_task_cache
+   *  @param[in] weight_alg  Partitioning scheme of the requested weights
+   *                         (NOTPARTITIONED for the raw quadrature weights)
+   *  @param[in] task_layout task_layout() of the saving LoadBalancer
+   *                         (0 for the tasks as generated)
+   *
+   *  @returns false (and leaves the LoadBalancer untouched) if no cache 
+   *           exists for this setup on any rank
+   *
+   *  Throws on ranks whose cache file is corrupt, after taking part in the
+   *  collective (the other ranks return false).
+   */
+  bool load_task_cache( const std::string& prefix, 
+    XCWeightAlg weight_alg = XCWeightAlg::NOTPARTITIONED,
+    uint64_t task_layout = 0 );
+
+  /** Adapt the granularity of the local tasks to the host task loops
+   *
+   *  Splits tasks whose cost exceeds the target by point ranges and merges
+   *  small tasks of the same parent atom with similar shell lists into
+   *  tasks over the union of their shells (within the nbe overhead bound).
+   *  Generates the tasks if needed, preserves points and weights.
+   */
+  void refine_tasks( const TaskGranularitySettings& settings = 
+    TaskGranularitySettings{} );
+
+  /** Move the atoms to a new geometry, reusing the existing tasks
+   *
+   *  Grid points follow their parent atom and basis shells their center,
+   *  only the basis screening of the tasks is updated (tasks whose screening
+   *  can not have changed are skipped). Weights are reset to the
+   *  unpartitioned quadrature weights, molecular weights have to be
+   *  recomputed by MolecularWeights::modify_weights afterwards.
+   *
+   *  @param[in] mol Molecule with the same atoms (count, order and Z) at
+   *                 the new positions
+   *
+   *  If the weights have already been modified, this requires
+   *  LoadBalancerState::retain_unpartitioned_weights to have been set
+   *  before modify_weights. Only supported by host load balancers.
+   */
+  void update_geometry( const Molecule& mol );
+
   /// Check equality of LoadBalancer instances
   bool operator==( const LoadBalancer& ) const;
 
@@ -151,6 +289,13 @@ public:
    *                           This gurantees contiguous memory access but leads
    *                           to significantly more work. Not advised for general 
    *                           usage
+   *    - "DISTRIBUTED": Read as "DISTRIBUTED-PETITE"
+   *    - "DISTRIBUTED-PETITE"/"DISTRIBUTED-FILLIN": Same screening as the 
+   *                           REPLICATED variants, but batches are partitioned
+   *                           across ranks by an a-priori cost estimate such
+   *                           that each rank only generates its own batches.
+   *                           Call rebalance_exc_vxc (or rebalance_weights)
+   *                           afterwards to remove residual imbalance.
    * 
    *    Currently accepted values for Device execution space:
    *      - "DEFAULT": Read as "REPLICATED"
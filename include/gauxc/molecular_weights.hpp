@@ -24,6 +24,8 @@ namespace detail {
 struct MolecularWeightsSettings { 
     XCWeightAlg weight_alg = XCWeightAlg::SSF; ///< Weight partitioning scheme
     bool becke_size_adjustment = false; ///< Whether to use Becke size adjustments
+    bool on_the_fly = false; ///< Defer the partitioning to the integrator task
+                             ///< loops, weights are never stored (Host only)
 };
 
 
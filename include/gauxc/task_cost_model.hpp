@@ -0,0 +1,145 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/xc_task.hpp>
+#include <gauxc/runtime_environment/fwd.hpp>
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+#include <iosfwd>
+
+namespace GauXC {
+
+/// Workload class of a quadrature task
+enum class TaskCostClass : int {
+  LDA       = 0, ///< LDA EXC/VXC
+  GGA       = 1, ///< GGA EXC/VXC
+  MGGA      = 2, ///< meta-GGA EXC/VXC (tau only)
+  MGGA_LAPL = 3, ///< meta-GGA EXC/VXC (tau + Laplacian)
+  EXX       = 4  ///< seminumerical exact exchange
+};
+
+/// Spin mode of a quadrature task
+enum class TaskCostSpin : int {
+  RKS = 0,
+  UKS = 1,
+  GKS = 2
+};
+
+/** Measured cost model for quadrature tasks
+ *
+ *  The host integrators record the wall time of every task they evaluate.
+ *  Per (workload class, spin mode) the model fits
+ *
+ *    t(task) = sum_k c_k f_k(task),   c_k >= 0
+ *
+ *  by least squares, where f are the dominant scalings of the workload:
+ *    - EXC/VXC: (npts*nbe^2, npts*nbe, npts)
+ *    - EXX:     (npts*nbe*nbe_cou, npts*nshell_pairs, npts*nbe)
+ *
+ *  Only the sufficient statistics of the fit are stored, such that a model
+ *  may be exported after a run and imported (and further refined) by later
+ *  runs on the same hardware. Predictions for keys without a calibrated fit
+ *  fall back to the analytic XCTask heuristics.
+ *
+ *  Recorded times are pending until the next fit. The load balancer task
+ *  assignment requires identical models on all ranks, models attached to a
+ *  LoadBalancer are therefore refit collectively (fit(RuntimeEnvironment))
+ *  by the integrators after every evaluation.
+ *
+ *  record / fit are not thread safe.
+ */
+class TaskCostModel {
+
+public:
+
+  static constexpr int nfeatures = 3;
+
+  using key_type     = std::pair<TaskCostClass, TaskCostSpin>;
+  using feature_type = std::array<double, nfeatures>;
+
+  /// Number of samples required before a key is considered calibrated
+  size_t min_samples = 16;
+
+  /// Feature vector of a task for a given workload class
+  static feature_type features( TaskCostClass cls, const XCTask& task );
+
+  /// Add a measured task wall time (seconds) to the pending statistics of
+  /// `key`
+  void record( key_type key, const XCTask& task, double seconds );
+
+  /// Merge the pending statistics and (re)fit the coefficients of all keys
+  void fit();
+
+  /// Merge the pending statistics of all ranks of `rt` and (re)fit, such
+  /// that all ranks hold the same model (collective)
+  void fit( const RuntimeEnvironment& rt );
+
+  /// Whether `key` has a fitted model
+  bool calibrated( key_type key ) const;
+
+  /// Fitted coefficients of `key` (throws if not calibrated)
+  const feature_type& coefficients( key_type key ) const;
+
+  /// Predicted wall time (seconds) of `task` (throws if not calibrated)
+  double predict( key_type key, const XCTask& task ) const;
+
+  /** Integral cost of `task` for load balancing
+   *
+   *  Predicted time in nanoseconds if `key` is calibrated, otherwise the
+   *  analytic XCTask heuristic of the workload class. Costs of different
+   *  keys must not be mixed.
+   */
+  size_t cost( key_type key, const XCTask& task ) const;
+
+  /// Key of the most recently recorded EXC/VXC workload (as of the last fit)
+  inline key_type xc_key() const { return xc_key_; }
+
+  /// Drop all statistics (incl. pending) and fits
+  void clear();
+
+  /// Export / import the model statistics (plain text, pending statistics
+  /// are not exported)
+  void write( std::ostream& ) const;
+  void read( std::istream& );
+  void save( const std::string& fname ) const;
+  void load( const std::string& fname );
+
+private:
+
+  struct stats_type {
+    size_t                                    nsamples = 0;
+    std::array<double, nfeatures * nfeatures> xtx = {};
+    feature_type                              xty = {};
+    double                                    yty = 0.;
+    bool                                      fitted = false;
+    feature_type                              coeff = {};
+  };
+
+  std::map<key_type, stats_type> stats_;
+  std::map<key_type, stats_type> pending_; ///< Recorded since the last fit
+  key_type xc_key_ = { TaskCostClass::GGA, TaskCostSpin::RKS };
+  int      pending_xc_key_ = -1; ///< key_index of the last recorded EXC/VXC key
+
+  static constexpr int nclasses = 5, nspins = 3;
+  static inline int key_index( key_type key ) {
+    return int(key.first) * nspins + int(key.second);
+  }
+
+  /// Fold pending_ into stats_ and refit
+  void merge_pending_and_fit_();
+
+};
+
+}
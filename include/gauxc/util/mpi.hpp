@@ -126,6 +126,7 @@ public:
 
   auto* buffer() { return buffer_.data(); }
   size_t size()  { return buffer_.size(); }
+  int position() const { return internal_position_; }
 
   template <typename T>
   void pack( const T* ptr, size_t n ) {
@@ -87,6 +87,8 @@ public:
 
   dd_psi_type eval_dd_psi( const MatrixType&, unsigned );
   dd_psi_potential_type eval_dd_psi_potential( const MatrixType&, unsigned );
+  dd_psi_potential_type eval_dd_psi_potential( const MatrixType&, unsigned,
+                                               const IntegratorSettingsXC& );
 
   const util::Timer& get_timings() const;
   const LoadBalancer& load_balancer() const;
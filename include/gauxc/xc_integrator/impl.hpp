@@ -127,7 +127,15 @@ template <typename MatrixType>
 typename XCIntegrator<MatrixType>::dd_psi_potential_type
   XCIntegrator<MatrixType>::eval_dd_psi_potential(const MatrixType& X, unsigned max_Ylm) {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
-  return pimpl_->eval_dd_psi_potential(X, max_Ylm);
+  return pimpl_->eval_dd_psi_potential(X, max_Ylm, IntegratorSettingsXC{});
+}
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::dd_psi_potential_type
+  XCIntegrator<MatrixType>::eval_dd_psi_potential(const MatrixType& X, unsigned max_Ylm,
+                                                   const IntegratorSettingsXC& ks_settings) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_dd_psi_potential(X, max_Ylm, ks_settings);
 }
 
 
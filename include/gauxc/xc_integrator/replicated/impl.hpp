@@ -253,14 +253,15 @@ typename ReplicatedXCIntegrator<MatrixType>::dd_psi_type
 
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::dd_psi_potential_type
-  ReplicatedXCIntegrator<MatrixType>::eval_dd_psi_potential_( const MatrixType& X, unsigned max_Ylm ) {
+  ReplicatedXCIntegrator<MatrixType>::eval_dd_psi_potential_( const MatrixType& X, unsigned max_Ylm, 
+                                                              const IntegratorSettingsXC& ks_settings ) {
 
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
 
   const size_t nbf = pimpl_->load_balancer().basis().nbf();
   matrix_type Vddx(nbf, nbf);
   Vddx.setZero(); 
-  pimpl_->eval_dd_psi_potential(X.rows(), X.cols(), X.data(), max_Ylm, Vddx.data());
+  pimpl_->eval_dd_psi_potential(X.rows(), X.cols(), X.data(), max_Ylm, Vddx.data(), ks_settings);
   return Vddx;                      
 
 }
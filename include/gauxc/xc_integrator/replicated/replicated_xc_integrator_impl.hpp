@@ -39,6 +39,9 @@ protected:
 
   util::Timer timer_;
 
+  /// Refit the cost model attached to the load balancer (if any) from the
+  /// task times recorded on all ranks (collective)
+  void fit_cost_model_();
 
   virtual void integrate_den_( int64_t m, int64_t n, const value_type* P,
                                int64_t ldp, value_type* N_EL ) = 0;
@@ -101,7 +104,7 @@ protected:
   virtual void eval_dd_psi_( int64_t m, int64_t n, const value_type* P, int64_t ldp, unsigned max_Ylm, 
                              value_type* ddPsi, int64_t ldPsi ) = 0;
   virtual void eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm,
-                             value_type* Vddx) = 0;
+                             value_type* Vddx, const IntegratorSettingsXC& ks_settings ) = 0;
 
 public:
 
@@ -181,7 +184,7 @@ public:
                      int64_t ldp, unsigned max_Ylm, 
                      value_type* ddPsi, int64_t ldPsi );
   void eval_dd_psi_potential( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, 
-                      value_type* Vddx );
+                      value_type* Vddx, const IntegratorSettingsXC& ks_settings );
 
   inline const util::Timer& get_timings() const { return timer_; }
 
@@ -60,7 +60,7 @@ private:
   fxc_contraction_type_rks  eval_fxc_contraction_ ( const MatrixType&, const MatrixType&, const IntegratorSettingsXC& ) override;
   fxc_contraction_type_uks  eval_fxc_contraction_ ( const MatrixType&, const MatrixType&, const MatrixType&, const MatrixType&, const IntegratorSettingsXC&) override;
   dd_psi_type   eval_dd_psi_( const MatrixType& , unsigned ) override;
-  dd_psi_potential_type   eval_dd_psi_potential_( const MatrixType& , unsigned ) override;
+  dd_psi_potential_type   eval_dd_psi_potential_( const MatrixType& , unsigned, const IntegratorSettingsXC& ) override;
   const util::Timer& get_timings_() const override;
   const LoadBalancer& get_load_balancer_() const override;
   LoadBalancer& get_load_balancer_() override;
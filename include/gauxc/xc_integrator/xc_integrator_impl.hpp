@@ -57,7 +57,8 @@ protected:
 
 
   virtual dd_psi_type   eval_dd_psi_( const MatrixType& P, unsigned max_Ylm ) = 0;
-  virtual dd_psi_potential_type   eval_dd_psi_potential_( const MatrixType& X, unsigned max_Ylm ) = 0;
+  virtual dd_psi_potential_type   eval_dd_psi_potential_( const MatrixType& X, unsigned max_Ylm, 
+                                                          const IntegratorSettingsXC& ks_settings ) = 0;
   virtual const util::Timer& get_timings_() const = 0;
   virtual const LoadBalancer& get_load_balancer_() const = 0;
   virtual LoadBalancer& get_load_balancer_() = 0;
@@ -189,10 +190,12 @@ public:
    *
    *  @param[in] X        The local ASC coefficients, (nharmonics, atom) array in column-major ordering.
    *  @param[in] max_Ylm  The max "l" degree for Ylm
+   *  @param[in] ks_settings KS integration settings (host accumulation strategy)
    *  @returns   fock contributions
    */   
-  dd_psi_potential_type eval_dd_psi_potential( const MatrixType& X, unsigned max_Ylm ) {
-    return eval_dd_psi_potential_(X,max_Ylm);
+  dd_psi_potential_type eval_dd_psi_potential( const MatrixType& X, unsigned max_Ylm,
+                                               const IntegratorSettingsXC& ks_settings ) {
+    return eval_dd_psi_potential_(X,max_Ylm,ks_settings);
   }
 
   /** Get internal timers
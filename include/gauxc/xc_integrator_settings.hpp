@@ -10,19 +10,57 @@
  * See LICENSE.txt for details
  */
 #pragma once
+#include <cstddef>
 
 namespace GauXC {
 
+/**
+ *  @brief Strategy used by the host integrators to accumulate the per-task
+ *  matrix contributions (VXC, FXC, K, ...) into the local integrand
+ */
+enum class HostAccumulation {
+  Atomic,       ///< Scatter directly into the integrand with element-wise atomics
+  ThreadPrivate ///< Scatter into per-thread private copies, tree-reduced after the task loop
+};
+
+/**
+ *  @brief Storage precision of the host collocation cache
+ */
+enum class CollocationCacheStorage {
+  FP64, ///< Store collocation matrices in double precision (exact reuse)
+  FP32  ///< Store collocation matrices in single precision (2x capacity, ~1e-7 relative error)
+};
+
 struct IntegratorSettingsEXX { virtual ~IntegratorSettingsEXX() noexcept = default; };
 struct IntegratorSettingsSNLinK : public IntegratorSettingsEXX {
   bool screen_ek = true;
   double energy_tol = 1e-10;
   double k_tol      = 1e-10;
+  HostAccumulation host_accumulation = HostAccumulation::Atomic;
+  bool deterministic_accumulation = false; // static task schedule + fixed summation order (ThreadPrivate only)
+  size_t host_accumulation_max_bytes = 0;  // bound on the private copies of each integrand (0 unbounded), ThreadPrivate falls back to Atomic if exceeded
 };
 
 struct IntegratorSettingsXC { virtual ~IntegratorSettingsXC() noexcept = default; };
 struct IntegratorSettingsKS : public IntegratorSettingsXC {
   double gks_dtol = 1e-12;
+  HostAccumulation host_accumulation = HostAccumulation::Atomic;
+  bool deterministic_accumulation = false; // static task schedule + fixed summation order (ThreadPrivate only)
+  size_t host_accumulation_max_bytes = 0;  // bound on the private copies of each integrand (0 unbounded), ThreadPrivate falls back to Atomic if exceeded
+  size_t collocation_cache_bytes = 0; // per-process budget for reusing collocation across calls (0 disables, Host only)
+  CollocationCacheStorage collocation_cache_storage = CollocationCacheStorage::FP64;
+  // RKS LDA/GGA: only rebuild tasks whose density matrix block changed since the previous call (Host only).
+  // Takes precedence: incremental builds ignore density_screening_tol, point_density_tol, mixed_precision and
+  // point_chunk_size, and record no TaskCostModel timings
+  bool   incremental_vxc     = false;
+  double incremental_vxc_tol = 1e-10; // accumulated max |P - P_prev| over a task's basis block below which it is skipped
+  double density_screening_tol = 0.; // drop shells with negligible density / VXC contributions per task (0 disables, Host LDA/GGA RKS/UKS only)
+  double point_density_tol     = 0.; // drop grid points with total density below this before the functional evaluation (0 disables, Host LDA/GGA RKS/UKS only)
+  bool   mixed_precision           = false; // FP32 X-matrix / VXC products, FP64 functional and accumulation (Host LDA/GGA RKS/UKS only)
+  double mixed_precision_scf_error = 0.;    // caller supplied SCF error estimate (e.g. max |FPS - SPF|)
+  double mixed_precision_threshold = 1e-4;  // FP32 is only used while mixed_precision_scf_error exceeds this
+  bool   packed_vxc = false; // reduce only the lower triangle(s) of VXC / FXC in packed storage, unpacked once at the end (Host only)
+  size_t point_chunk_size = 0; // points per cache blocked sub-batch of a task in EXC/VXC builds (0 derives it from nbe and the L2 cache size, Host only)
 };
 
 struct IntegratorSettingsEXC_GRAD : public IntegratorSettingsKS {
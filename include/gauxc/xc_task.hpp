@@ -29,6 +29,10 @@ struct XCTask {
   std::vector< double  >               weights;
   int32_t                              npts = 0;
 
+  /// Quadrature weights prior to partitioning (only retained if requested
+  /// through LoadBalancerState::retain_unpartitioned_weights)
+  std::vector< double  >               unpartitioned_weights;
+
   double                               dist_nearest;
   double                               max_weight = std::numeric_limits<double>::infinity();
 
@@ -54,7 +58,7 @@ struct XCTask {
 
   inline size_t volume() const {
     return 2 * sizeof(int32_t) +
-      (3*points.size() + weights.size() + 2) * sizeof(double) +
+      (3*points.size() + weights.size() + unpartitioned_weights.size() + 2) * sizeof(double) +
       bfn_screening.volume() + cou_screening.volume();
   }
 
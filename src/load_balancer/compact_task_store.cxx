@@ -0,0 +1,166 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "compact_task_store.hpp"
+#include <algorithm>
+
+namespace GauXC  {
+namespace detail {
+
+namespace {
+
+inline size_t hash_shell_list( const std::vector<int32_t>& list ) {
+  size_t h = list.size();
+  for( auto i : list ) h ^= size_t(i) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  return h;
+}
+
+inline bool has_screening( const XCTask::screening_data& s ) {
+  return s.nbe or s.shell_list.size() or s.shell_pair_list.size() or
+    s.shell_pair_idx_list.size() or s.submat_block.size() or s.submat_map.size();
+}
+
+}
+
+CompactTaskStore::CompactTaskStore( std::vector<XCTask>&& tasks ) {
+
+  const size_t ntasks = tasks.size();
+  size_t npts_total = 0;
+  bool unpartitioned = ntasks > 0;
+  for( const auto& task : tasks ) {
+    if( task.weights.size() != task.points.size() )
+      GAUXC_GENERIC_EXCEPTION("CompactTaskStore: Inconsistent Task Weights");
+    npts_total += task.points.size();
+    unpartitioned = unpartitioned and
+      task.unpartitioned_weights.size() == task.points.size();
+  }
+
+  records_.resize( ntasks );
+  coords_.reserve( 3 * npts_total );
+  weights_.reserve( npts_total );
+  if( unpartitioned ) unpartitioned_weights_.reserve( npts_total );
+
+  std::unordered_map<size_t, std::vector<int32_t>> interned; // hash -> ids
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = tasks[iT];
+    auto& rec  = records_[iT];
+    const size_t npts = task.points.size();
+
+    rec.iParent      = task.iParent;
+    rec.npts         = npts;
+    rec.nbe          = task.bfn_screening.nbe;
+    rec.dist_nearest = task.dist_nearest;
+    rec.max_weight   = task.max_weight;
+    rec.offset       = weights_.size();
+
+    for( int d = 0; d < 3; ++d )
+    for( const auto& p : task.points ) coords_.emplace_back( p[d] );
+    weights_.insert( weights_.end(), task.weights.begin(), task.weights.end() );
+    if( unpartitioned )
+      unpartitioned_weights_.insert( unpartitioned_weights_.end(),
+        task.unpartitioned_weights.begin(), task.unpartitioned_weights.end() );
+
+    // Intern the shell list
+    auto& list = task.bfn_screening.shell_list;
+    auto& ids  = interned[ hash_shell_list(list) ];
+    auto it = std::find_if( ids.begin(), ids.end(),
+      [&]( auto id ){ return shell_lists_[id] == list; } );
+    if( it != ids.end() ) rec.shell_list_id = *it;
+    else {
+      rec.shell_list_id = shell_lists_.size();
+      ids.emplace_back( rec.shell_list_id );
+      shell_lists_.emplace_back( std::move(list) );
+    }
+
+    if( has_screening( task.cou_screening ) )
+      cou_screening_.emplace( iT, std::move(task.cou_screening) );
+
+    task = XCTask(); // Release the task storage
+  }
+
+  tasks.clear();
+  tasks.shrink_to_fit();
+
+}
+
+CompactTaskStore::task_view CompactTaskStore::view( size_t iT ) const {
+  const auto& rec = records_[iT];
+  const double* x = coords_.data() + 3 * rec.offset;
+  auto cou = cou_screening_.find( iT );
+  return task_view{ rec.iParent, rec.npts, x, x + rec.npts, x + 2*rec.npts,
+    weights_.data() + rec.offset,
+    unpartitioned_weights_.size() ? unpartitioned_weights_.data() + rec.offset : nullptr,
+    shell_lists_[rec.shell_list_id], rec.nbe, rec.dist_nearest, rec.max_weight,
+    cou != cou_screening_.end() ? &cou->second : nullptr };
+}
+
+XCTask CompactTaskStore::task( size_t iT ) const {
+
+  const auto v = view( iT );
+  XCTask task;
+  task.iParent = v.iParent;
+  task.npts    = v.npts;
+  task.points.resize( v.npts );
+  for( int32_t i = 0; i < v.npts; ++i )
+    task.points[i] = { v.x[i], v.y[i], v.z[i] };
+  task.weights.assign( v.weights, v.weights + v.npts );
+  if( v.unpartitioned_weights )
+    task.unpartitioned_weights.assign( v.unpartitioned_weights,
+      v.unpartitioned_weights + v.npts );
+  task.dist_nearest = v.dist_nearest;
+  task.max_weight   = v.max_weight;
+  task.bfn_screening.shell_list = v.shell_list;
+  task.bfn_screening.nbe        = v.nbe;
+  if( v.cou_screening ) task.cou_screening = *v.cou_screening;
+  return task;
+
+}
+
+std::vector<XCTask> CompactTaskStore::tasks() const {
+  std::vector<XCTask> tasks( size() );
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < tasks.size(); ++iT ) tasks[iT] = task( iT );
+  return tasks;
+}
+
+size_t CompactTaskStore::volume() const {
+  size_t vol = records_.size() * sizeof(record_type) +
+    (coords_.size() + weights_.size() + unpartitioned_weights_.size()) * sizeof(double);
+  for( const auto& l : shell_lists_ ) vol += l.size() * sizeof(int32_t);
+  for( const auto& [iT, s] : cou_screening_ ) vol += s.volume();
+  return vol;
+}
+
+size_t CompactTaskStore::total_npts() const {
+  return weights_.size();
+}
+
+size_t CompactTaskStore::max_npts() const {
+  size_t m = 0;
+  for( const auto& rec : records_ ) m = std::max<size_t>( m, rec.npts );
+  return m;
+}
+
+size_t CompactTaskStore::max_nbe() const {
+  size_t m = 0;
+  for( const auto& rec : records_ ) m = std::max<size_t>( m, rec.nbe );
+  return m;
+}
+
+size_t CompactTaskStore::max_npts_x_nbe() const {
+  size_t m = 0;
+  for( const auto& rec : records_ ) m = std::max<size_t>( m, size_t(rec.npts) * rec.nbe );
+  return m;
+}
+
+}
+}
@@ -0,0 +1,98 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/xc_task.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/** Compact storage of a set of XCTasks
+ *
+ *  Task data is held in a few shared arenas rather than in per-task vectors:
+ *    - coordinates as SoA (x, y and z of a task are contiguous blocks) and
+ *      weights in one arena each,
+ *    - interned basis function shell lists (tasks with equal lists share a
+ *      single copy),
+ *    - coulomb screening data only for tasks which carry any (none for pure
+ *      XC workloads).
+ *
+ *  Derived screening data (submatrix maps, shell pair lists of the basis
+ *  function screening) is not stored and is regenerated by its consumers.
+ *  Tasks are accessed through lightweight views or materialized as XCTask.
+ */
+class CompactTaskStore {
+
+  struct record_type {
+    int32_t  iParent;
+    int32_t  npts;
+    int32_t  nbe;
+    int32_t  shell_list_id;
+    double   dist_nearest;
+    double   max_weight;
+    size_t   offset;         ///< Offset of the points of the task in the arenas
+  };
+
+  std::vector<record_type>          records_;
+  std::vector<double>               coords_;   ///< (x | y | z) per task
+  std::vector<double>               weights_;
+  std::vector<double>               unpartitioned_weights_; ///< Empty if not retained
+  std::vector<std::vector<int32_t>> shell_lists_;
+  std::unordered_map<size_t, XCTask::screening_data> cou_screening_;
+
+public:
+
+  /// Read-only view of a stored task
+  struct task_view {
+    int32_t        iParent;
+    int32_t        npts;
+    const double*  x;
+    const double*  y;
+    const double*  z;
+    const double*  weights;
+    const double*  unpartitioned_weights; ///< nullptr if not retained
+    const std::vector<int32_t>& shell_list;
+    int32_t        nbe;
+    double         dist_nearest;
+    double         max_weight;
+    const XCTask::screening_data* cou_screening; ///< nullptr if not present
+  };
+
+  CompactTaskStore() = default;
+
+  /// Pack tasks (consumed task by task to bound the peak memory)
+  CompactTaskStore( std::vector<XCTask>&& tasks );
+
+  inline size_t size() const { return records_.size(); }
+  inline size_t nshell_lists() const { return shell_lists_.size(); }
+
+  task_view view( size_t iT ) const;
+
+  /// Materialize a single task / all tasks in storage order
+  XCTask task( size_t iT ) const;
+  std::vector<XCTask> tasks() const;
+
+  /// Bytes held by the store (cf. XCTask::volume)
+  size_t volume() const;
+
+  size_t total_npts()     const;
+  size_t max_npts()       const;
+  size_t max_nbe()        const;
+  size_t max_npts_x_nbe() const;
+
+};
+
+}
+}
@@ -10,7 +10,6 @@
  * See LICENSE.txt for details
  */
 #include "fillin_replicated_load_balancer.hpp"
-#include <gauxc/util/geometry.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -35,26 +34,14 @@ std::pair<std::vector<int32_t>,size_t> FillInHostReplicatedLoadBalancer::micro_b
 ) const {
 
 
-  int32_t first_shell = -1;
-  int32_t last_shell  = -1;
-  for(auto iSh = 0ul; iSh < bs.size(); ++iSh) {
-
-    const auto& center = bs[iSh].O();
-    const auto  crad   = bs[iSh].cutoff_radius();
-    const bool intersect = 
-      geometry::cube_sphere_intersect( box_lo, box_up, center, crad );
-    
-    if( intersect ) {
-      if( first_shell < 0 ) first_shell = iSh;
-      last_shell = iSh;
-    }
-
-  }
-
-  if( first_shell < 0 ) {
+  const auto intersect = intersecting_shells_( bs, box_lo, box_up );
+  if( intersect.empty() ) {
     return std::pair( std::vector<int32_t>{}, 0ul );
   }
 
+  // Fill in all shells between the first and last intersecting shell
+  const int32_t first_shell = intersect.front();
+  const int32_t last_shell  = intersect.back();
   int32_t nshells = last_shell - first_shell + 1;
   std::vector<int32_t> shell_list(nshells);
   std::iota( shell_list.begin(), shell_list.end(), first_shell );
@@ -25,10 +25,14 @@ std::shared_ptr<LoadBalancer> LoadBalancerHostFactory::get_shared_instance(
     kernel_name.begin(), ::toupper );
 
 
+  // DISTRIBUTED-* kernels only differ in how the tasks are generated
+  const bool distributed = kernel_name.rfind("DISTRIBUTED", 0) == 0;
+  if( distributed ) kernel_name.replace(0, 11, "REPLICATED");
+
   if( kernel_name == "DEFAULT" or kernel_name == "REPLICATED" ) 
     kernel_name = "REPLICATED-PETITE";
 
-  std::unique_ptr<detail::LoadBalancerImpl> ptr = nullptr;
+  std::unique_ptr<detail::HostReplicatedLoadBalancer> ptr = nullptr;
   if( kernel_name == "REPLICATED-PETITE" )
     ptr = std::make_unique<detail::PetiteHostReplicatedLoadBalancer>(
       rt, mol, mg, basis
@@ -40,6 +44,7 @@ std::shared_ptr<LoadBalancer> LoadBalancerHostFactory::get_shared_instance(
     );
 
   if( ! ptr ) GAUXC_GENERIC_EXCEPTION("Load Balancer Kernel Not Recognized: " + kernel_name);
+  ptr->set_distributed_generation( distributed );
 
   return std::make_shared<LoadBalancer>(std::move(ptr));
 
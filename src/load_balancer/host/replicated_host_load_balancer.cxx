@@ -10,18 +10,134 @@
  * See LICENSE.txt for details
  */
 #include "replicated_host_load_balancer.hpp"
+#include <limits>
 
 namespace GauXC {
 namespace detail {
 
-HostReplicatedLoadBalancer::HostReplicatedLoadBalancer( const HostReplicatedLoadBalancer& ) = default;
+namespace {
+
+/// Bounding box of the points of a task (tasks may be merged batches)
+std::pair< std::array<double,3>, std::array<double,3> > 
+  point_extent( const XCTask& task ) {
+  std::array<double,3> lo, up;
+  lo.fill(  std::numeric_limits<double>::infinity() );
+  up.fill( -std::numeric_limits<double>::infinity() );
+  for( const auto& p : task.points )
+  for( int d = 0; d < 3; ++d ) {
+    lo[d] = std::min( lo[d], p[d] );
+    up[d] = std::max( up[d], p[d] );
+  }
+  return { lo, up };
+}
+
+}
+
+// Screening margins are keyed on the task buffers of other, they are not copied
+HostReplicatedLoadBalancer::HostReplicatedLoadBalancer( 
+  const HostReplicatedLoadBalancer& other ) :
+  LoadBalancerImpl( other ), 
+  distributed_generation_( other.distributed_generation_ ),
+  shell_index_( other.shell_index_ ) { }
+
 HostReplicatedLoadBalancer::HostReplicatedLoadBalancer( HostReplicatedLoadBalancer&& ) noexcept = default;
 
 HostReplicatedLoadBalancer::~HostReplicatedLoadBalancer() noexcept = default;
 
-std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
+std::vector<int32_t> HostReplicatedLoadBalancer::intersecting_shells_( 
+  const BasisSet<double>& bs, const std::array<double,3>& lo, 
+  const std::array<double,3>& up ) const {
+
+  // The index is built for basis_, other basis sets require a new one
+  if( &bs == basis_.get() and shell_index_ ) return shell_index_->query( lo, up );
+  return ShellSpatialIndex( bs ).query( lo, up );
+
+}
 
-  const int32_t n_deriv = 1; // Effects cost heuristic
+bool HostReplicatedLoadBalancer::generate_task_( batcher_type& batcher,
+  size_t ibatch, int32_t iAtom, XCTask& task ) const {
+
+  // Generate the batch (non-negligible cost)
+  auto [lo, up, points, weights] = batcher.at(ibatch);
+
+  if( points.size() == 0 ) return false;
+
+  // Microbatch Screening
+  auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
+
+  // Course grain screening
+  if( not shell_list.size() ) return false; 
+
+  // Copy task data
+  task.iParent    = iAtom;
+  // This enables lazy assignment of points vector (see CUDA impl)
+  task.npts       = points.size(); 
+  task.points     = std::move( points );
+  task.weights    = std::move( weights );
+  task.bfn_screening.shell_list = std::move(shell_list);
+  task.bfn_screening.nbe        = nbe;
+  task.dist_nearest = molmeta_->dist_nearest()[iAtom];
+
+  return true;
+
+}
+
+void HostReplicatedLoadBalancer::screen_task_points_( XCTask& task ) const {
+  const auto [lo, up] = point_extent( task );
+  auto [shell_list, nbe] = micro_batch_screen( *basis_, lo, up );
+  task.bfn_screening = XCTask::screening_data();
+  task.bfn_screening.shell_list = std::move( shell_list );
+  task.bfn_screening.nbe        = nbe;
+}
+
+void HostReplicatedLoadBalancer::rescreen_tasks_( double max_disp, 
+  size_t prev_generation ) {
+
+  shell_index_ = std::make_shared<ShellSpatialIndex>( *basis_ );
+
+  // Margins of tasks that have been replaced since the last update are stale
+  if( screen_margins_generation_ != prev_generation ) screen_margins_.clear();
+
+  // Shells and points move by at most max_disp each. Screening results can
+  // only change once a task has used up its margin.
+  const double   rel_disp = 2. * max_disp;
+  const double   reach    = 1.; // Largest margin worth tracking (bohr)
+  const size_t   ntasks   = local_tasks_.size();
+  std::vector<double> margin( ntasks, -1. );
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    auto it = screen_margins_.find( local_tasks_[iT].points.data() );
+    if( it != screen_margins_.end() ) margin[iT] = it->second - rel_disp;
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    if( margin[iT] > 0. ) continue;
+    auto& task = local_tasks_[iT];
+
+    screen_task_points_( task );
+    const auto [lo, up] = point_extent( task );
+    margin[iT] = shell_index_->margin( lo, up, reach );
+  }
+
+  // Tasks which no longer overlap any shell keep their points and weights
+  // (they may overlap shells again after later updates), the integrators
+  // skip them
+  screen_margins_.clear();
+  for( size_t iT = 0; iT < ntasks; ++iT )
+    screen_margins_[ local_tasks_[iT].points.data() ] = margin[iT];
+  screen_margins_generation_ = tasks_generation_;
+
+}
+
+std::vector< XCTask > HostReplicatedLoadBalancer::create_replicated_tasks_() const  {
+
+  // Collocation derivative order (effects cost heuristic), taken from the
+  // workload of the attached cost model if any
+  int32_t n_deriv = 1;
+  if( cost_model_ ) {
+    const auto cls = cost_model_->xc_key().first;
+    n_deriv = cls == TaskCostClass::LDA ? 0 : cls == TaskCostClass::MGGA_LAPL ? 2 : 1;
+  }
 
   int32_t world_rank = runtime_.comm_rank();
   int32_t world_size = runtime_.comm_size();
@@ -54,27 +170,8 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
     
       size_t batch_idx = ibatch + batch_idx_offset;
 
-      // Generate the batch (non-negligible cost)
-      auto [lo, up, points, weights] = batcher.at(ibatch);
-
-      if( points.size() == 0 ) continue;
-
-      // Microbatch Screening
-      auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
-
-      // Course grain screening
-      if( not shell_list.size() ) continue; 
-
-      // Copy task data
       XCTask task;
-      task.iParent    = iCurrent;
-      // This enables lazy assignment of points vector (see CUDA impl)
-      task.npts       = points.size(); 
-      task.points     = std::move( points );
-      task.weights    = std::move( weights );
-      task.bfn_screening.shell_list = std::move(shell_list);
-      task.bfn_screening.nbe        = nbe;
-      task.dist_nearest = molmeta_->dist_nearest()[iCurrent];
+      if( not generate_task_( batcher, ibatch, iCurrent, task ) ) continue;
 
       #pragma omp critical
       temp_tasks.push_back( 
@@ -108,8 +205,13 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
           std::min_element( global_workload.begin(), global_workload.end() );
         int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
 
-        // Compute cost heuristic and increment total work
-        global_workload[ min_rank ] += task.cost( n_deriv, natoms );
+        // Compute cost (measured model if calibrated, heuristic otherwise)
+        // and increment total work. Every rank replays this assignment, the
+        // model is identical on all ranks (fit collectively).
+        global_workload[ min_rank ] += 
+          (cost_model_ and cost_model_->calibrated( cost_model_->xc_key() )) ?
+            cost_model_->cost( cost_model_->xc_key(), task ) :
+            task.cost( n_deriv, natoms );
 
         if( world_rank == min_rank ) 
           local_work.push_back( std::move(task) );
@@ -127,7 +229,113 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
 
   } // Loop over Atoms
 
-// return local_work;
+  return local_work;
+
+}
+
+std::vector< XCTask > HostReplicatedLoadBalancer::create_distributed_tasks_() const  {
+
+  const int32_t world_rank = runtime_.comm_rank();
+  const int32_t world_size = runtime_.comm_size();
+
+  const auto&   mol    = *this->mol_;
+  const auto&   basis  = *this->basis_;
+  const int32_t natoms = mol.natoms();
+
+  // A-priori cost estimate of each atomic grid: npts * nbe * (1 + nbe), where
+  // nbe counts the basis functions whose cutoff sphere contains the nucleus.
+  // The cost is spread evenly over the batches of the atom (the points are
+  // not generated to determine the batch sizes).
+  std::vector<double> batch_cost( natoms );
+  std::vector<size_t> atom_nbatches( natoms );
+  for( int32_t iA = 0; iA < natoms; ++iA ) {
+    auto& batcher = mg_->get_grid(mol[iA].Z).batcher();
+    atom_nbatches[iA] = batcher.nbatches();
+
+    const std::array<double,3> center = { mol[iA].x, mol[iA].y, mol[iA].z };
+    double nbe = 0.;
+    for( const auto& sh : basis ) {
+      const auto* O = sh.O_data();
+      const double dx = O[0] - center[0];
+      const double dy = O[1] - center[1];
+      const double dz = O[2] - center[2];
+      const double r  = sh.cutoff_radius();
+      if( dx*dx + dy*dy + dz*dz <= r*r ) nbe += sh.size();
+    }
+
+    const double npts = batcher.quadrature().npts();
+    batch_cost[iA] = atom_nbatches[iA] ? 
+      npts * std::max(nbe,1.) * (1. + nbe) / atom_nbatches[iA] : 0.;
+  }
+
+  // Contiguous partition of the (atom-major) batch sequence into world_size
+  // chunks of equal estimated cost. A batch is owned by the rank whose chunk
+  // contains its cost midpoint.
+  const double total_cost = std::inner_product( batch_cost.begin(), 
+    batch_cost.end(), atom_nbatches.begin(), 0. );
+
+  auto owner = [&]( double prefix ) {
+    if( total_cost <= 0. ) return 0;
+    return std::min<int32_t>( world_size - 1, 
+      int32_t( prefix * world_size / total_cost ) );
+  };
+
+  std::vector< XCTask > local_work;
+  double prefix = 0.;
+  for( int32_t iA = 0; iA < natoms; ++iA ) {
+
+    const size_t nbatches = atom_nbatches[iA];
+    const double c = batch_cost[iA];
+
+    // Locally owned batch range of this atom
+    size_t ib_st = nbatches, ib_en = nbatches;
+    for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
+      const int32_t r = owner( prefix + (ibatch + 0.5) * c );
+      if( r == world_rank and ib_st == nbatches ) ib_st = ibatch;
+      if( r >  world_rank ) { ib_en = ibatch; break; }
+    }
+    prefix += nbatches * c;
+    if( ib_st >= ib_en ) continue;
+
+    const std::array<double,3> center = { mol[iA].x, mol[iA].y, mol[iA].z };
+    auto& batcher = mg_->get_grid(mol[iA].Z).batcher();
+    batcher.quadrature().recenter( center );
+
+    std::vector< std::pair<size_t, XCTask> > temp_tasks;
+
+    #pragma omp parallel for
+    for( size_t ibatch = ib_st; ibatch < ib_en; ++ibatch ) {
+
+      XCTask task;
+      if( not generate_task_( batcher, ibatch, iA, task ) ) continue;
+
+      #pragma omp critical
+      temp_tasks.push_back( 
+        std::pair(ibatch,std::move( task )) 
+      );
+
+    }
+
+    // Deterministic task order
+    std::sort( temp_tasks.begin(), temp_tasks.end(), 
+      []( const auto& a, const auto& b ) {
+        return a.first < b.first;
+      } );
+    for( auto& [_, task] : temp_tasks ) 
+      local_work.emplace_back( std::move(task) );
+
+  }
+
+  return local_work;
+
+}
+
+std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
+
+  auto local_work = distributed_generation_ ? 
+    create_distributed_tasks_() : create_replicated_tasks_();
+
+  if( local_work.empty() ) return local_work;
 
   // Lexicographic ordering of tasks
   auto task_order = []( const auto& a, const auto& b ) {
@@ -12,6 +12,8 @@
 #pragma once
 
 #include "load_balancer_impl.hpp"
+#include "shell_spatial_index.hpp"
+#include <unordered_map>
 
 namespace GauXC  {
 namespace detail {
@@ -23,18 +25,54 @@ protected:
   using basis_type = BasisSet<double>;
   std::vector< XCTask > create_local_tasks_() const override;
 
+  bool distributed_generation_ = false; 
+    ///< Only generate the batches owned by this rank (see create_distributed_tasks_)
+
+  /// Generate all batches, assign by min-workload (redundant on all ranks)
+  std::vector< XCTask > create_replicated_tasks_() const;
+
+  /// Generate the locally owned batches of an a-priori cost partition
+  std::vector< XCTask > create_distributed_tasks_() const;
+
+  std::shared_ptr<const ShellSpatialIndex> shell_index_; ///< Index over basis_
+
+  /// Sorted list of shells of `bs` whose cutoff sphere intersects [lo,up]
+  std::vector<int32_t> intersecting_shells_( const BasisSet<double>& bs,
+    const std::array<double,3>& lo, const std::array<double,3>& up ) const;
+
+  /// Generate and screen a single batch, false if it is negligible
+  bool generate_task_( batcher_type& batcher, size_t ibatch, int32_t iAtom,
+    XCTask& task ) const;
+
+  /// Relative shell / point displacement each task's screening tolerates,
+  /// keyed on the task points (valid for screen_margins_generation_)
+  std::unordered_map<const void*, double> screen_margins_;
+  size_t screen_margins_generation_ = 0;
+
+  void rescreen_tasks_( double max_disp, size_t prev_generation ) override;
+  void screen_task_points_( XCTask& task ) const override;
+  bool supports_geometry_update_() const override { return true; }
+  bool uses_distributed_generation_() const override { 
+    return distributed_generation_; 
+  }
+
 public:
 
   HostReplicatedLoadBalancer() = delete;
   template <typename... Args>
   HostReplicatedLoadBalancer( Args&&... args ):
-    LoadBalancerImpl( std::forward<Args>(args)... ) { }
+    LoadBalancerImpl( std::forward<Args>(args)... ) { 
+    shell_index_ = std::make_shared<ShellSpatialIndex>( *basis_ );
+  }
 
   HostReplicatedLoadBalancer( const HostReplicatedLoadBalancer& );
   HostReplicatedLoadBalancer( HostReplicatedLoadBalancer&& ) noexcept;
 
   virtual ~HostReplicatedLoadBalancer() noexcept;
 
+  /// Toggle distributed task generation
+  inline void set_distributed_generation( bool d ) { distributed_generation_ = d; }
+
   virtual std::pair< std::vector<int32_t>, size_t > micro_batch_screen(
     const BasisSet<double>&, const std::array<double,3>&,
     const std::array<double,3>& ) const = 0;
@@ -0,0 +1,170 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "shell_spatial_index.hpp"
+#include <gauxc/util/geometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace GauXC  {
+namespace detail {
+
+ShellSpatialIndex::ShellSpatialIndex( const BasisSet<double>& basis ) {
+
+  const size_t nshells = basis.size();
+  centers_.resize( nshells );
+  radii_.resize( nshells );
+
+  double rmin = std::numeric_limits<double>::infinity();
+  for( size_t iSh = 0; iSh < nshells; ++iSh ) {
+    centers_[iSh] = basis[iSh].O();
+    radii_[iSh]   = basis[iSh].cutoff_radius();
+    if( radii_[iSh] > 0. ) rmin = std::min( rmin, radii_[iSh] );
+  }
+  if( not nshells ) return;
+  if( not std::isfinite(rmin) ) rmin = 1.;
+
+  // Radius levels: r in (rmin*2^(k-1), rmin*2^k]
+  auto level_idx = [&]( double r ) {
+    return r > rmin ? int( std::ceil( std::log2( r / rmin ) ) ) : 0;
+  };
+  std::vector<std::vector<int32_t>> level_shells;
+  for( size_t iSh = 0; iSh < nshells; ++iSh ) {
+    const auto k = level_idx( radii_[iSh] );
+    if( k >= (int)level_shells.size() ) level_shells.resize( k+1 );
+    level_shells[k].emplace_back( iSh );
+  }
+
+  for( auto& shells : level_shells ) if( shells.size() ) {
+
+    auto& lvl = levels_.emplace_back();
+
+    lvl.rmax = 0.;
+    std::array<double,3> hi;
+    lvl.lo.fill(  std::numeric_limits<double>::infinity() );
+    hi.fill    ( -std::numeric_limits<double>::infinity() );
+    for( auto iSh : shells ) {
+      lvl.rmax = std::max( lvl.rmax, radii_[iSh] );
+      for( int d = 0; d < 3; ++d ) {
+        lvl.lo[d] = std::min( lvl.lo[d], centers_[iSh][d] );
+        hi[d]     = std::max( hi[d],     centers_[iSh][d] );
+      }
+    }
+
+    // Cell size ~ rmax, coarsened to at most 8 cells per shell
+    lvl.h = std::max( lvl.rmax, 1e-8 );
+    const int64_t max_cells = 8 * shells.size();
+    while( true ) {
+      int64_t ncell_tot = 1;
+      for( int d = 0; d < 3; ++d ) {
+        lvl.ncell[d] = int64_t( (hi[d] - lvl.lo[d]) / lvl.h ) + 1;
+        ncell_tot *= lvl.ncell[d];
+      }
+      if( ncell_tot <= max_cells ) break;
+      lvl.h *= 2.;
+    }
+
+    auto cell_idx = [&]( const std::array<double,3>& c ) {
+      int64_t idx[3];
+      for( int d = 0; d < 3; ++d )
+        idx[d] = std::clamp<int64_t>( (c[d] - lvl.lo[d]) / lvl.h, 0, lvl.ncell[d]-1 );
+      return idx[0] + lvl.ncell[0] * (idx[1] + lvl.ncell[1] * idx[2]);
+    };
+
+    // Counting sort of the shells into cells (shell order is kept per cell)
+    const int64_t ncell_tot = lvl.ncell[0] * lvl.ncell[1] * lvl.ncell[2];
+    lvl.cell_ptr.assign( ncell_tot + 1, 0 );
+    for( auto iSh : shells ) lvl.cell_ptr[ cell_idx(centers_[iSh]) + 1 ]++;
+    std::partial_sum( lvl.cell_ptr.begin(), lvl.cell_ptr.end(), lvl.cell_ptr.begin() );
+
+    lvl.shells.resize( shells.size() );
+    std::vector<int32_t> fill( lvl.cell_ptr.begin(), lvl.cell_ptr.end() - 1 );
+    for( auto iSh : shells ) lvl.shells[ fill[ cell_idx(centers_[iSh]) ]++ ] = iSh;
+
+  }
+
+}
+
+std::vector<int32_t> ShellSpatialIndex::query( const std::array<double,3>& box_lo,
+  const std::array<double,3>& box_up ) const {
+
+  std::vector<int32_t> shell_list;
+  for( const auto& lvl : levels_ ) {
+
+    // A candidate center lies within rmax of the box in every dimension
+    int64_t st[3], en[3];
+    bool empty = false;
+    for( int d = 0; d < 3; ++d ) {
+      const double l = (box_lo[d] - lvl.rmax - lvl.lo[d]) / lvl.h;
+      const double u = (box_up[d] + lvl.rmax - lvl.lo[d]) / lvl.h;
+      if( u < 0. or l >= lvl.ncell[d] ) { empty = true; break; }
+      st[d] = std::max<int64_t>( 0, std::floor(l) );
+      en[d] = std::min<int64_t>( lvl.ncell[d]-1, std::floor(u) );
+    }
+    if( empty ) continue;
+
+    for( int64_t k = st[2]; k <= en[2]; ++k )
+    for( int64_t j = st[1]; j <= en[1]; ++j ) {
+      const int64_t row = lvl.ncell[0] * (j + lvl.ncell[1] * k);
+      for( int32_t p = lvl.cell_ptr[row + st[0]]; p < lvl.cell_ptr[row + en[0] + 1]; ++p ) {
+        const auto iSh = lvl.shells[p];
+        if( geometry::cube_sphere_intersect( box_lo, box_up, centers_[iSh], radii_[iSh] ) )
+          shell_list.emplace_back( iSh );
+      }
+    }
+
+  }
+
+  std::sort( shell_list.begin(), shell_list.end() );
+  return shell_list;
+
+}
+
+double ShellSpatialIndex::margin( const std::array<double,3>& box_lo,
+  const std::array<double,3>& box_up, double reach ) const {
+
+  double margin = reach;
+  for( const auto& lvl : levels_ ) {
+
+    // Shells beyond rmax + reach in any dimension are further than reach
+    // from their intersection boundary
+    int64_t st[3], en[3];
+    bool empty = false;
+    for( int d = 0; d < 3; ++d ) {
+      const double l = (box_lo[d] - lvl.rmax - reach - lvl.lo[d]) / lvl.h;
+      const double u = (box_up[d] + lvl.rmax + reach - lvl.lo[d]) / lvl.h;
+      if( u < 0. or l >= lvl.ncell[d] ) { empty = true; break; }
+      st[d] = std::max<int64_t>( 0, std::floor(l) );
+      en[d] = std::min<int64_t>( lvl.ncell[d]-1, std::floor(u) );
+    }
+    if( empty ) continue;
+
+    for( int64_t k = st[2]; k <= en[2]; ++k )
+    for( int64_t j = st[1]; j <= en[1]; ++j ) {
+      const int64_t row = lvl.ncell[0] * (j + lvl.ncell[1] * k);
+      for( int32_t p = lvl.cell_ptr[row + st[0]]; p < lvl.cell_ptr[row + en[0] + 1]; ++p ) {
+        const auto iSh = lvl.shells[p];
+        const double dist = geometry::cube_point_dist_closest<3>( box_lo.data(),
+          box_up.data(), centers_[iSh].data() );
+        margin = std::min( margin, std::abs( dist - radii_[iSh] ) );
+      }
+    }
+
+  }
+
+  return margin;
+
+}
+
+}
+}
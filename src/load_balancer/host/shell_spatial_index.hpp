@@ -0,0 +1,66 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+#include <array>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/** Spatial index over the cutoff spheres of the shells of a basis
+ *
+ *  Shells are binned into levels of similar cutoff radius (factors of 2),
+ *  and the centers of each level are stored in a uniform cell grid with a
+ *  cell size of the largest radius of that level. A box query visits only
+ *  the cells within reach of the box for each level and applies the exact
+ *  geometry::cube_sphere_intersect test to the candidates, such that the
+ *  result is identical to testing every shell.
+ */
+class ShellSpatialIndex {
+
+  struct level_type {
+    double                  rmax;     ///< Largest cutoff radius of the level
+    double                  h;        ///< Cell size
+    std::array<double,3>    lo;       ///< Lower corner of the cell grid
+    std::array<int64_t,3>   ncell;    ///< Cells per dimension
+    std::vector<int32_t>    cell_ptr; ///< CSR offsets into shells (ncell+1)
+    std::vector<int32_t>    shells;   ///< Shell indices, ordered by cell
+  };
+
+  std::vector<std::array<double,3>> centers_;
+  std::vector<double>               radii_;
+  std::vector<level_type>           levels_;
+
+public:
+
+  ShellSpatialIndex( const BasisSet<double>& basis );
+
+  /// Sorted indices of the shells whose cutoff sphere intersects [lo,up]
+  std::vector<int32_t> query( const std::array<double,3>& lo,
+    const std::array<double,3>& up ) const;
+
+  /** Distance by which [lo,up] and the shells may move relative to each
+   *  other without changing the result of query (capped at `reach`)
+   *
+   *  min_sh | dist([lo,up], center_sh) - cutoff_radius_sh |
+   */
+  double margin( const std::array<double,3>& lo, const std::array<double,3>& up,
+    double reach ) const;
+
+  inline size_t nshells() const { return centers_.size(); }
+
+};
+
+}
+}
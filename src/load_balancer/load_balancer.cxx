@@ -106,6 +106,67 @@ LoadBalancerState& LoadBalancer::state() {
   return pimpl_->state();
 }
 
+void LoadBalancer::set_cost_model( std::shared_ptr<TaskCostModel> model ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->set_cost_model( model );
+}
+
+std::shared_ptr<TaskCostModel> LoadBalancer::cost_model() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->cost_model();
+}
+
+void LoadBalancer::compact_tasks() {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->compact_tasks();
+}
+
+bool LoadBalancer::tasks_are_compact() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->tasks_are_compact();
+}
+
+size_t LoadBalancer::tasks_volume() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->tasks_volume();
+}
+
+void LoadBalancer::refine_tasks( const TaskGranularitySettings& settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->refine_tasks( settings );
+}
+
+void LoadBalancer::update_geometry( const Molecule& mol ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->update_geometry( mol );
+}
+
+void LoadBalancer::save_task_cache( const std::string& prefix ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->save_task_cache( prefix );
+}
+
+uint64_t LoadBalancer::task_layout() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->task_layout();
+}
+
+size_t LoadBalancer::tasks_generation() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->tasks_generation();
+}
+
+void LoadBalancer::mark_tasks_modified() {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->mark_tasks_modified();
+}
+
+bool LoadBalancer::load_task_cache( const std::string& prefix, 
+  XCWeightAlg weight_alg, uint64_t task_layout ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->load_task_cache( prefix, weight_alg, task_layout );
+}
+
 const RuntimeEnvironment& LoadBalancer::runtime() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
   return pimpl_->runtime();
@@ -10,6 +10,11 @@
  * See LICENSE.txt for details
  */
 #include "load_balancer_impl.hpp"
+#include "task_cache.hpp"
+#include <gauxc/util/mpi.hpp>
+#include <atomic>
+#include <exception>
+#include <typeinfo>
 
 namespace GauXC::detail {
 
@@ -40,20 +45,35 @@ LoadBalancerImpl::LoadBalancerImpl( LoadBalancerImpl&& ) noexcept = default;
 LoadBalancerImpl::~LoadBalancerImpl() noexcept = default;
 
 const std::vector<XCTask>& LoadBalancerImpl::get_tasks() const {
-  if( not local_tasks_.size() ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
+  if( not tasks_created_ ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
+  if( compact_tasks_ ) 
+    GAUXC_GENERIC_EXCEPTION("Tasks Are Compacted (Expanded by Non-Const get_tasks)");
   return local_tasks_;
 }
 
 std::vector<XCTask>& LoadBalancerImpl::get_tasks() {
 
-  if( not local_tasks_.size() ) {
+  if( not tasks_created_ ) {
     auto create_tasks_st = std::chrono::high_resolution_clock::now();
     local_tasks_ = create_local_tasks_();
+    tasks_created_ = true;
+    tasks_generation_ = next_tasks_generation_();
+    task_layout_ = 0;
     auto create_tasks_en = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> create_tasks_dr = create_tasks_en - create_tasks_st; 
     timer_.add_timing("LoadBalancer.CreateTasks", create_tasks_dr);
   }
 
+  if( compact_tasks_ ) {
+    auto expand_st = std::chrono::high_resolution_clock::now();
+    local_tasks_ = compact_tasks_->tasks();
+    compact_tasks_.reset();
+    tasks_generation_ = next_tasks_generation_();
+    auto expand_en = std::chrono::high_resolution_clock::now();
+    timer_.add_timing("LoadBalancer.ExpandTasks", 
+      std::chrono::duration<double>(expand_en - expand_st));
+  }
+
 
   return local_tasks_;
 }
@@ -65,6 +85,8 @@ const util::Timer& LoadBalancerImpl::get_timings() const {
 
 size_t LoadBalancerImpl::total_npts() const {
 
+  if( compact_tasks_ ) return compact_tasks_->total_npts();
+
   return std::accumulate( local_tasks_.cbegin(), local_tasks_.cend(), 0ul,
     []( const auto& a, const auto& b ) {
       return a + b.points.size();
@@ -73,6 +95,7 @@ size_t LoadBalancerImpl::total_npts() const {
 }
 size_t LoadBalancerImpl::max_npts() const {
 
+  if( compact_tasks_ ) return compact_tasks_->max_npts();
   if( not local_tasks_.size() ) return 0ul;
 
   return std::max_element( local_tasks_.cbegin(), local_tasks_.cend(),
@@ -83,6 +106,7 @@ size_t LoadBalancerImpl::max_npts() const {
 }
 size_t LoadBalancerImpl::max_nbe() const {
 
+  if( compact_tasks_ ) return compact_tasks_->max_nbe();
   if( not local_tasks_.size() ) return 0ul;
 
   return std::max_element( local_tasks_.cbegin(), local_tasks_.cend(),
@@ -93,6 +117,7 @@ size_t LoadBalancerImpl::max_nbe() const {
 }
 size_t LoadBalancerImpl::max_npts_x_nbe() const {
 
+  if( compact_tasks_ ) return compact_tasks_->max_npts_x_nbe();
   if( not local_tasks_.size() ) return 0ul;
 
   auto it = std::max_element( local_tasks_.cbegin(), local_tasks_.cend(),
@@ -140,4 +165,180 @@ LoadBalancerState& LoadBalancerImpl::state() {
   return state_;
 }
 
+void LoadBalancerImpl::set_cost_model( std::shared_ptr<TaskCostModel> model ) {
+  cost_model_ = model;
+}
+
+std::shared_ptr<TaskCostModel> LoadBalancerImpl::cost_model() const {
+  return cost_model_;
+}
+
+void LoadBalancerImpl::compact_tasks() {
+  auto& tasks = get_tasks();
+  auto compact_st = std::chrono::high_resolution_clock::now();
+  compact_tasks_ = std::make_shared<const CompactTaskStore>( std::move(tasks) );
+  local_tasks_ = std::vector<XCTask>();
+  auto compact_en = std::chrono::high_resolution_clock::now();
+  timer_.add_timing("LoadBalancer.CompactTasks", 
+    std::chrono::duration<double>(compact_en - compact_st));
+}
+
+bool LoadBalancerImpl::tasks_are_compact() const {
+  return bool(compact_tasks_);
+}
+
+size_t LoadBalancerImpl::tasks_volume() const {
+  if( compact_tasks_ ) return compact_tasks_->volume();
+  return std::accumulate( local_tasks_.begin(), local_tasks_.end(), 0ul,
+    []( auto v, const auto& task ) { return v + task.volume(); } );
+}
+
+void LoadBalancerImpl::rescreen_tasks_( double, size_t ) {
+  GAUXC_GENERIC_EXCEPTION("Geometry Updates Are Not Supported By This LoadBalancer");
+}
+
+void LoadBalancerImpl::update_geometry( const Molecule& mol ) {
+
+  auto update_st = std::chrono::high_resolution_clock::now();
+
+  if( not supports_geometry_update_() )
+    GAUXC_GENERIC_EXCEPTION("Geometry Updates Are Not Supported By This LoadBalancer");
+  if( compact_tasks_ ) get_tasks(); // Expand
+
+  const size_t natoms = mol_->natoms();
+  if( mol.natoms() != natoms )
+    GAUXC_GENERIC_EXCEPTION("update_geometry: Number of Atoms Changed");
+  for( size_t iA = 0; iA < natoms; ++iA )
+  if( mol[iA].Z != (*mol_)[iA].Z )
+    GAUXC_GENERIC_EXCEPTION("update_geometry: Atomic Numbers Changed");
+
+  if( tasks_created_ and state_.modified_weights_are_stored )
+  for( const auto& task : local_tasks_ )
+  if( task.unpartitioned_weights.size() != task.weights.size() )
+    GAUXC_GENERIC_EXCEPTION("update_geometry: Unpartitioned Weights Not Retained "
+      "(set LoadBalancerState::retain_unpartitioned_weights before modify_weights)");
+
+  // Atomic displacements
+  std::vector<std::array<double,3>> disp( natoms );
+  double max_disp = 0.;
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    disp[iA] = { mol[iA].x - (*mol_)[iA].x, mol[iA].y - (*mol_)[iA].y,
+                 mol[iA].z - (*mol_)[iA].z };
+    max_disp = std::max( max_disp, std::sqrt( disp[iA][0]*disp[iA][0] +
+      disp[iA][1]*disp[iA][1] + disp[iA][2]*disp[iA][2] ) );
+  }
+
+  // Shells follow their atoms (shells not centered on an atom stay fixed).
+  // New objects are created such that dependent caches keyed on them are
+  // invalidated.
+  auto basis = std::make_shared<basis_type>( *basis_ );
+  for( size_t iSh = 0; iSh < basis->size(); ++iSh ) {
+    const auto iA = basis_map_->shell_to_center( iSh );
+    if( iA < 0 ) continue;
+    auto& O = basis->at(iSh).O();
+    for( int d = 0; d < 3; ++d ) O[d] += disp[iA][d];
+  }
+
+  mol_         = std::make_shared<Molecule>( mol );
+  molmeta_     = std::make_shared<MolMeta>( mol );
+  basis_       = basis;
+  basis_map_   = std::make_shared<basis_map_type>( *basis_, mol );
+  shell_pairs_ = nullptr;
+
+  if( tasks_created_ ) {
+
+    // Translate points with their parent atom, restore unpartitioned weights
+    const auto& dist_nearest = molmeta_->dist_nearest();
+    #pragma omp parallel for schedule(dynamic)
+    for( size_t iT = 0; iT < local_tasks_.size(); ++iT ) {
+      auto& task = local_tasks_[iT];
+      const auto& d = disp[task.iParent];
+      for( auto& p : task.points ) {
+        p[0] += d[0]; p[1] += d[1]; p[2] += d[2];
+      }
+      if( state_.modified_weights_are_stored ) 
+        task.weights = task.unpartitioned_weights;
+      task.dist_nearest  = dist_nearest[task.iParent];
+      task.cou_screening = XCTask::screening_data(); // Geometry dependent
+    }
+
+  }
+
+  const auto prev_generation = tasks_generation_;
+  if( tasks_created_ ) tasks_generation_ = next_tasks_generation_();
+  rescreen_tasks_( max_disp, prev_generation );
+
+  state_.modified_weights_are_stored = false;
+  if( not state_.partition_weights_on_the_fly ) // Weights follow the geometry
+    state_.weight_alg = XCWeightAlg::NOTPARTITIONED;
+
+  auto update_en = std::chrono::high_resolution_clock::now();
+  timer_.add_timing("LoadBalancer.UpdateGeometry", 
+    std::chrono::duration<double>(update_en - update_st));
+
+}
+
+uint64_t LoadBalancerImpl::task_layout() const { return task_layout_; }
+
+size_t LoadBalancerImpl::next_tasks_generation_() {
+  static std::atomic<size_t> generation{0};
+  return ++generation;
+}
+
+size_t LoadBalancerImpl::tasks_generation() const { return tasks_generation_; }
+
+void LoadBalancerImpl::mark_tasks_modified() {
+  if( tasks_created_ ) tasks_generation_ = next_tasks_generation_();
+}
+
+void LoadBalancerImpl::save_task_cache( const std::string& prefix ) {
+  auto& tasks = get_tasks();
+  const auto key = TaskCache::key( typeid(*this).name(), 
+    uses_distributed_generation_(), runtime_, *mol_, *basis_, *mg_, 
+    state_.weight_alg, task_layout_ );
+  TaskCache::write( TaskCache::file_name( prefix, key, runtime_.comm_rank() ),
+    key, state_, tasks );
+}
+
+bool LoadBalancerImpl::load_task_cache( const std::string& prefix, 
+  XCWeightAlg weight_alg, uint64_t task_layout ) {
+
+  auto load_st = std::chrono::high_resolution_clock::now();
+  const auto key = TaskCache::key( typeid(*this).name(), 
+    uses_distributed_generation_(), runtime_, *mol_, *basis_, *mg_, 
+    weight_alg, task_layout );
+  LoadBalancerState state = state_;
+  std::vector<XCTask> tasks;
+  // A failed read (corrupt file) counts as a miss until all ranks have
+  // taken part in the reduction below, it is rethrown afterwards
+  int hit = 0;
+  std::exception_ptr read_error;
+  try {
+    hit = TaskCache::read( TaskCache::file_name( prefix, key, 
+      runtime_.comm_rank() ), key, state, tasks );
+  } catch(...) {
+    read_error = std::current_exception();
+  }
+
+  // The cached tasks of a rank are only a valid partition together with
+  // those of all other ranks, adopt them only if every rank hit
+#ifdef GAUXC_HAS_MPI
+  MPI_Allreduce( MPI_IN_PLACE, &hit, 1, MPI_INT, MPI_MIN, runtime_.comm() );
+#endif
+  if( read_error ) std::rethrow_exception( read_error );
+  if( not hit ) return false;
+
+  local_tasks_   = std::move(tasks);
+  compact_tasks_.reset();
+  tasks_generation_ = next_tasks_generation_();
+  tasks_created_ = true;
+  task_layout_   = task_layout;
+  state_         = state;
+  auto load_en = std::chrono::high_resolution_clock::now();
+  timer_.add_timing("LoadBalancer.LoadTaskCache", 
+    std::chrono::duration<double>(load_en - load_st));
+  return true;
+
+}
+
 }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <gauxc/load_balancer.hpp>
+#include "compact_task_store.hpp"
 
 namespace GauXC  {
 namespace detail {
@@ -35,6 +36,16 @@ protected:
   std::shared_ptr<shell_pair_type> shell_pairs_;
 
   std::vector< XCTask >     local_tasks_;
+  bool                      tasks_created_ = false; ///< local_tasks_ may be empty
+  size_t                    tasks_generation_ = 0;  
+    ///< Contents of local_tasks_ (see next_tasks_generation_)
+  uint64_t                  task_layout_ = 0;
+    ///< Refinements / rebalances applied since the tasks were generated (see TaskCache)
+
+  std::shared_ptr<const CompactTaskStore> compact_tasks_; 
+    ///< Local tasks while compacted (local_tasks_ is empty)
+
+  std::shared_ptr<TaskCostModel> cost_model_; ///< Measured task costs (optional)
 
   LoadBalancerState         state_;
 
@@ -42,6 +53,33 @@ protected:
 
   virtual std::vector< XCTask > create_local_tasks_() const = 0;
 
+  /// New process-wide unique task generation (assign to tasks_generation_
+  /// whenever local_tasks_ is replaced or modified)
+  static size_t next_tasks_generation_();
+
+  /** Update the basis screening of the local tasks after a geometry update
+   *
+   *  @param[in] max_disp        Largest atomic displacement of the update
+   *  @param[in] prev_generation Task generation before the update
+   *
+   *  Called with the points already translated, basis_ updated and the
+   *  new task generation assigned (also if no tasks have been created yet).
+   */
+  virtual void rescreen_tasks_( double max_disp, size_t prev_generation );
+
+  /** Tighten the basis screening of a task to the extent of its points
+   *
+   *  Used on tasks created by splitting a larger task. The default keeps
+   *  the (conservative) shell list of the original task.
+   */
+  virtual void screen_task_points_( XCTask& ) const { }
+
+  /// Whether rescreen_tasks_ is implemented (update_geometry throws if not)
+  virtual bool supports_geometry_update_() const { return false; }
+
+  /// Whether each rank only generates the tasks it owns
+  virtual bool uses_distributed_generation_() const { return false; }
+
 public:
 
   LoadBalancerImpl() = delete;
@@ -82,6 +120,23 @@ public:
 
   LoadBalancerState& state();
 
+  void set_cost_model( std::shared_ptr<TaskCostModel> model );
+  std::shared_ptr<TaskCostModel> cost_model() const;
+
+  void compact_tasks();
+  bool tasks_are_compact() const;
+  size_t tasks_volume() const;
+
+  void refine_tasks( const TaskGranularitySettings& settings );
+  void update_geometry( const Molecule& mol );
+
+  uint64_t task_layout() const;
+  size_t tasks_generation() const;
+  void mark_tasks_modified();
+  void save_task_cache( const std::string& prefix );
+  bool load_task_cache( const std::string& prefix, XCWeightAlg weight_alg,
+    uint64_t task_layout );
+
   virtual std::unique_ptr<LoadBalancerImpl> clone() const = 0;
 
 };
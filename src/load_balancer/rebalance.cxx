@@ -10,351 +10,220 @@
  * See LICENSE.txt for details
  */
 #include "load_balancer_impl.hpp"
+#include "task_cache.hpp"
 #include <gauxc/util/mpi.hpp>
 #include <gauxc/util/div_ceil.hpp>
-#include <fstream>
+#include <memory>
+#include <limits>
 
 namespace GauXC::detail {
 
 #ifdef GAUXC_HAS_MPI
-template <typename TaskIterator, typename CostFunctor>
-auto rebalance(TaskIterator begin, TaskIterator end, const CostFunctor& cost, MPI_Comm comm) {
 
-  using hrt_t = std::chrono::high_resolution_clock;
-  using dur_t = std::chrono::duration<double, std::milli>;
+namespace {
+
+/// Serialize the fields of a task which are required after migration
+template <typename Archive>
+void pack_task( Archive& ar, const XCTask& task ) {
+  ar.pack(task.iParent);
+  ar.pack(task.npts);
+  ar.pack(task.points);
+  ar.pack(task.weights);
+  ar.pack(task.unpartitioned_weights);
+  ar.pack(task.bfn_screening.shell_list);
+  ar.pack(task.bfn_screening.nbe);
+  ar.pack(task.cou_screening.shell_list);
+  ar.pack(task.cou_screening.shell_pair_list);
+  ar.pack(task.cou_screening.shell_pair_idx_list);
+  ar.pack(task.cou_screening.nbe);
+  ar.pack(task.dist_nearest);
+  ar.pack(task.max_weight);
+}
+
+void unpack_task( MPI_Packed_Buffer& ar, XCTask& task ) {
+  ar.unpack(task.iParent);
+  ar.unpack(task.npts);
+  ar.unpack(task.points);
+  ar.unpack(task.weights);
+  ar.unpack(task.unpartitioned_weights);
+  ar.unpack(task.bfn_screening.shell_list);
+  ar.unpack(task.bfn_screening.nbe);
+  ar.unpack(task.cou_screening.shell_list);
+  ar.unpack(task.cou_screening.shell_pair_list);
+  ar.unpack(task.cou_screening.shell_pair_idx_list);
+  ar.unpack(task.cou_screening.nbe);
+  ar.unpack(task.dist_nearest);
+  ar.unpack(task.max_weight);
+}
+
+/// Upper bound of the MPI_Pack size of a set of data (same interface as
+/// MPI_Packed_Buffer::pack)
+class MPI_Packed_Size {
+  MPI_Comm comm_;
+  size_t   size_ = 0;
+public:
+  MPI_Packed_Size( MPI_Comm comm ) : comm_(comm) {}
+  size_t size() const { return size_; }
+
+  template <typename T>
+  void pack( const T*, size_t n ) {
+    int sz; MPI_Pack_size( n * sizeof(T), MPI_BYTE, comm_, &sz );
+    size_ += sz;
+  }
+  template <typename T>
+  void pack( const T& data ) { pack( &data, 1 ); }
+  template <typename T>
+  void pack( const std::vector<T>& data ) {
+    pack( data.size() );
+    if( data.size() ) pack( data.data(), data.size() );
+  }
+};
+
+}
+
+/**
+ *  Redistribute tasks such that every rank holds (up to task granularity)
+ *  the same total cost.
+ *
+ *  The migration plan is a function of the per-rank loads only, and is
+ *  computed redundantly on every rank: ranks above the average load (donors)
+ *  are matched to ranks below it (receivers) in rank order, such that only
+ *  the excess load of each donor is moved (the minimal migration volume),
+ *  with at most (comm_size - 1) messages in total, for arbitrary imbalance.
+ *  Donors fill their outgoing quotas with their most expensive tasks first.
+ *
+ *  Tasks are exchanged as sparse all-to-allv: message sizes are exchanged
+ *  through MPI_Alltoall, the packed tasks through nonblocking point-to-point
+ *  messages between the ranks which actually exchange work.
+ */
+template <typename TaskIterator, typename CostFunctor>
+std::vector<XCTask> rebalance(TaskIterator begin, TaskIterator end,
+  const CostFunctor& cost, MPI_Comm comm) {
 
   int world_rank, world_size;
   MPI_Comm_rank(comm, &world_rank);
   MPI_Comm_size(comm, &world_size);
 
-  MPI_Barrier(MPI_COMM_WORLD);
-  printf(
-  "RANK %d BEFORE REBALNACE: LW = %lu\n",
-    world_rank,
-    std::accumulate(begin, end, 0ul,
-      [=](const auto& a, const auto& b){ return a + cost(b); })
-  );
-
   // Compute local task costs
-  size_t ntask_local = std::distance(begin, end);
+  const size_t ntask_local = std::distance(begin, end);
   std::vector<size_t> local_task_cost(ntask_local);
   std::transform(begin, end, local_task_cost.begin(),
     [&](const auto& task){ return cost(task); });
+  const size_t local_load = std::accumulate( local_task_cost.begin(),
+    local_task_cost.end(), size_t(0) );
 
-  // Compute task prefix sum
-  auto prefix_st = hrt_t::now();
-  std::vector<size_t> local_prefix_sum(ntask_local);
-  auto [local_task_sum, prefix_seed] =
-    mpi_prefix_sum(local_task_cost.begin(), local_task_cost.end(),
-      local_prefix_sum.begin(), comm);
-
-  // Compute total/avg cost
-  auto total_task_sum = allreduce( local_task_sum, MPI_SUM, comm );
-  size_t task_avg = util::div_ceil(total_task_sum, world_size);
+  // Gather the loads of all ranks
+  std::vector<size_t> loads(world_size);
+  MPI_Allgather( &local_load, 1, mpi_data_type<size_t>(), loads.data(), 1,
+    mpi_data_type<size_t>(), comm );
+  const size_t total_load = std::accumulate(loads.begin(), loads.end(), size_t(0));
 
-
-  // Generate outgoing messages
-  struct task_message {
-    int dst;
-    size_t idx_st, idx_en, vol;
+  auto target = [&](int i) -> size_t {
+    return total_load / world_size + (size_t(i) < total_load % world_size);
   };
 
-  std::vector<task_message> task_outgoing;
-  auto it = local_prefix_sum.begin();
-  for( int i = 0; i < world_size; ++i) {
-    auto n_it = std::lower_bound(it, local_prefix_sum.end(), (size_t)i,
-      [=](auto a, auto b) { return a / task_avg < b+1; });
-    size_t st_idx = std::distance(local_prefix_sum.begin(), it  );
-    size_t en_idx = std::distance(local_prefix_sum.begin(), n_it);
-    if(st_idx != en_idx and i != world_rank) {
-      size_t vol = 0;
-      for( size_t t = st_idx; t < en_idx; ++t ) {
-        vol += (begin + t)->volume();
+  // Match donors to receivers (rank order) and extract the local
+  // outgoing quotas
+  std::vector<std::pair<int, int64_t>> quota; // (dst, load to send)
+  {
+    int d = 0, r = 0;
+    size_t d_rem = 0, r_rem = 0;
+    auto next_donor = [&]() {
+      for( ; d < world_size; ++d ) if( loads[d] > target(d) ) {
+        d_rem = loads[d] - target(d); return;
       }
-      task_outgoing.push_back({i,st_idx,en_idx,vol});
-      size_t work_to_send = 0;
-      for( size_t t = st_idx; t < en_idx; ++t ) {
-        work_to_send += cost(*(begin + t));
+    };
+    auto next_receiver = [&]() {
+      for( ; r < world_size; ++r ) if( loads[r] < target(r) ) {
+        r_rem = target(r) - loads[r]; return;
       }
-      printf("RANK %d SENDING %lu to RANK %d\n", world_rank, work_to_send, i);
+    };
+    next_donor(); next_receiver();
+    while( d < world_size and r < world_size ) {
+      const size_t flow = std::min( d_rem, r_rem );
+      if( d == world_rank ) quota.emplace_back( r, int64_t(flow) );
+      d_rem -= flow; r_rem -= flow;
+      if( not d_rem ) { ++d; next_donor();    }
+      if( not r_rem ) { ++r; next_receiver(); }
     }
-    it = n_it;
   }
 
-  auto prefix_en = hrt_t::now();
-
-  // Sanity check
-  if(task_outgoing.size() > 2 )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank) + " SZ = " + std::to_string(task_outgoing.size()));
-
-  MPI_Barrier(comm);
-  ring_execute(
-  [&]() {
-    printf("RANK %d MESSAGES:\n", world_rank);
-    for(auto& msg : task_outgoing) {
-      printf("  DST %d ST %lu EN %lu V %lu\n",
-        msg.dst, msg.idx_st, msg.idx_en, msg.vol);
+  // Fill the quotas, most expensive tasks first. A task is sent if at least
+  // half of its cost fits into the remaining quota of a destination.
+  std::vector<int> task_dst( ntask_local, world_rank );
+  if( quota.size() ) {
+    std::vector<size_t> order(ntask_local);
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(), [&](size_t a, size_t b) {
+      return local_task_cost[a] > local_task_cost[b];
+    });
+
+    for( auto i : order ) {
+      auto q = std::max_element( quota.begin(), quota.end(),
+        [](const auto& a, const auto& b){ return a.second < b.second; } );
+      if( q->second <= 0 ) break;
+      const int64_t c = local_task_cost[i];
+      if( 2 * q->second < c ) continue;
+      task_dst[i] = q->first;
+      q->second  -= c;
     }
-  } , comm);
-  MPI_Barrier(comm);
-
-  std::vector<MPI_Request> packed_req; packed_req.reserve(8);
-
-  // Ask neighbors if they're sending messages
-  int recv_from_backward = 0;
-  int recv_from_forward = 0;
-  int send_forward = 0;
-  int send_backward = 0;
-  if(world_rank) {
-    auto& req = packed_req.emplace_back();
-    MPI_Irecv( &recv_from_backward, 1, MPI_INT, world_rank-1, 0, comm, &req );
-  }
-  if(world_rank < world_size-1) {
-    auto& req = packed_req.emplace_back();
-    MPI_Irecv( &recv_from_forward, 1, MPI_INT, world_rank+1, 1, comm, &req );
   }
-  if(world_rank < world_size-1) {
-    auto& req = packed_req.emplace_back();
-    for(auto& msg : task_outgoing) send_forward |= (msg.dst == world_rank+1);
-    MPI_Isend( &send_forward, 1, MPI_INT, world_rank+1, 0, comm, &req );
-  }
-  if(world_rank) {
-    auto& req = packed_req.emplace_back();
-    for(auto& msg : task_outgoing) send_backward |= (msg.dst == world_rank-1);
-    MPI_Isend( &send_backward, 1, MPI_INT, world_rank-1, 1, comm, &req );
-  }
-
-
 
-  // Wait for messages to complete
-  if(packed_req.size()) {
-    MPI_Waitall(packed_req.size(), packed_req.data(), MPI_STATUS_IGNORE);
+  // Pack outgoing tasks
+  std::vector<int> send_bytes(world_size, 0), recv_bytes(world_size, 0);
+  std::vector<std::unique_ptr<MPI_Packed_Buffer>> send_buffers(world_size);
+  for( const auto& [dst, _] : quota ) {
+    MPI_Packed_Size sz(comm);
+    sz.pack( size_t(0) );
+    for( size_t i = 0; i < ntask_local; ++i )
+      if( task_dst[i] == dst ) pack_task( sz, *(begin + i) );
+    if( sz.size() > size_t(std::numeric_limits<int>::max()) )
+      GAUXC_GENERIC_EXCEPTION("Rebalance Message Exceeds INT_MAX Bytes");
+
+    const size_t ntask_send =
+      std::count( task_dst.begin(), task_dst.end(), dst );
+    if( not ntask_send ) continue;
+
+    auto& buffer = send_buffers[dst] =
+      std::make_unique<MPI_Packed_Buffer>( sz.size(), comm );
+    buffer->pack( ntask_send );
+    for( size_t i = 0; i < ntask_local; ++i )
+      if( task_dst[i] == dst ) pack_task( *buffer, *(begin + i) );
+    send_bytes[dst] = buffer->position();
   }
-  // Reset messages
-  packed_req.clear();
 
-  printf("RANK %d, BW %d, FW %d\n", world_rank, recv_from_backward, recv_from_forward );
-  MPI_Barrier(MPI_COMM_WORLD);
-
-
-#if 0
-  // Sanity check
-  if( world_rank < world_size - 1 and task_outgoing.size() != 1 )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank));
-  if( world_rank == world_size - 1 and task_outgoing.size() )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank));
-#endif
-
-  // Allocate incoming and outgoing buffers = 64 MiB
-  constexpr size_t packed_buffer_size = 64 * 1024 * 1024;
-  MPI_Packed_Buffer packed_outgoing_forward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_incoming_forward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_outgoing_backward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_incoming_backward( packed_buffer_size, comm );
-
-  // Post receives
-  if(recv_from_backward) {
-    auto& packed_recv_req = packed_req.emplace_back();
-    MPI_Irecv( packed_incoming_backward.buffer(), packed_buffer_size, MPI_PACKED,
-      world_rank-1, 0, comm, &packed_recv_req );
+  // Exchange message sizes
+  MPI_Alltoall( send_bytes.data(), 1, MPI_INT, recv_bytes.data(), 1, MPI_INT,
+    comm );
+
+  // Post receives / sends
+  std::vector<MPI_Request> requests;
+  std::vector<std::unique_ptr<MPI_Packed_Buffer>> recv_buffers(world_size);
+  for( int i = 0; i < world_size; ++i ) if( recv_bytes[i] ) {
+    recv_buffers[i] = std::make_unique<MPI_Packed_Buffer>( recv_bytes[i], comm );
+    MPI_Irecv( recv_buffers[i]->buffer(), recv_bytes[i], MPI_PACKED, i, 0,
+      comm, &requests.emplace_back() );
   }
-  if(recv_from_forward) {
-    auto& packed_recv_req = packed_req.emplace_back();
-    MPI_Irecv( packed_incoming_forward.buffer(), packed_buffer_size, MPI_PACKED,
-      world_rank+1, 0, comm, &packed_recv_req );
+  for( int i = 0; i < world_size; ++i ) if( send_bytes[i] ) {
+    MPI_Isend( send_buffers[i]->buffer(), send_bytes[i], MPI_PACKED, i, 0,
+      comm, &requests.emplace_back() );
   }
 
-  auto pack_st = hrt_t::now();
-  {
-
-  //std::ofstream ofile("task_send." + std::to_string(world_rank) + ".txt");
+  // Move retained tasks while messages are in flight
+  std::vector<XCTask> local_work;
+  for( size_t i = 0; i < ntask_local; ++i )
+    if( task_dst[i] == world_rank ) local_work.emplace_back( std::move(*(begin + i)) );
 
-  auto pack_msg = [&](const auto& msg, auto& mpi_buffer) {
-    size_t ntask_send = msg.idx_en - msg.idx_st;
-    //ofile << "DEST " << msg.dst << std::endl;
-    mpi_buffer.pack(ntask_send); //ofile << ntask_send << std::endl;
-    for(size_t i = msg.idx_st; i < msg.idx_en; ++i) {
-      const auto& task = *(begin + i);
-      mpi_buffer.pack(task.iParent);
-      mpi_buffer.pack(task.npts);
-      mpi_buffer.pack(task.points);
-      mpi_buffer.pack(task.weights);
-      mpi_buffer.pack(task.bfn_screening.shell_list);
-      mpi_buffer.pack(task.bfn_screening.nbe);
-      mpi_buffer.pack(task.cou_screening.shell_list);
-      mpi_buffer.pack(task.cou_screening.shell_pair_list);
-      mpi_buffer.pack(task.cou_screening.shell_pair_idx_list);
-      mpi_buffer.pack(task.cou_screening.nbe);
-      mpi_buffer.pack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() <<
-      //  ", " << task.cou_screening.nbe << ", " << task.cou_screening.shell_list.size() <<
-      //  ", " << task.cou_screening.shell_pair_list.size() << ", " << task.cou_screening.shell_pair_idx_list.size()
-      //  << std::endl;
-    }
+  if( requests.size() )
+    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
 
-    // Send data to neighbor
-    auto& packed_send_req = packed_req.emplace_back();
-    auto* buffer = mpi_buffer.buffer();
-    MPI_Isend(buffer, packed_buffer_size, MPI_PACKED, msg.dst, 0,
-      comm, &packed_send_req);
-  };
-
-  // Pack and send to neighbor
-  #if 0
-  if(send_backward or send_forward) {
-    // Pack Data
-    auto& msg = task_outgoing[0];
-    if( msg.dst != world_rank+1 )
-      GAUXC_GENERIC_EXCEPTION("Invalid Destination Rank");
-
-    size_t ntask_send = msg.idx_en - msg.idx_st;
-
-    //std::ofstream ofile("task_send." + std::to_string(world_rank) + ".txt");
-
-    packed_outgoing.pack(ntask_send); //ofile << ntask_send << std::endl;
-    //printf("RANK = %d SEND = %lu\n", world_rank, ntask_send);
-    for(size_t i = msg.idx_st; i < msg.idx_en; ++i) {
-      const auto& task = *(begin + i);
-      packed_outgoing.pack(task.iParent);
-      packed_outgoing.pack(task.npts);
-      packed_outgoing.pack(task.points);
-      packed_outgoing.pack(task.weights);
-      packed_outgoing.pack(task.bfn_screening.shell_list);
-      packed_outgoing.pack(task.bfn_screening.nbe);
-      packed_outgoing.pack(task.cou_screening.shell_list);
-      packed_outgoing.pack(task.cou_screening.shell_pair_list);
-      packed_outgoing.pack(task.cou_screening.shell_pair_idx_list);
-      packed_outgoing.pack(task.cou_screening.nbe);
-      packed_outgoing.pack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() << std::endl;
-    }
-
-    // Send data to neighbor
-    auto& packed_send_req = packed_req.emplace_back();
-    auto* buffer = packed_outgoing.buffer();
-    MPI_Isend(buffer, packed_buffer_size, MPI_PACKED, world_rank+1, 0,
-      comm, &packed_send_req);
-
-  }
-  #else
-  for( auto& msg : task_outgoing ) {
-    if(msg.dst == world_rank + 1)
-      pack_msg(msg, packed_outgoing_forward);
-    else
-      pack_msg(msg, packed_outgoing_backward);
-  }
-  #endif
-  }
-
-  auto pack_en = hrt_t::now();
-
-  // Local task storage
-  std::vector< XCTask > local_work;
-
-  // Move local tasks to task storage
-  {
-    auto func = [=](auto a, auto b) { return a / task_avg < b+1; };
-    auto lps_begin = local_prefix_sum.begin();
-    auto lps_end   = local_prefix_sum.end();
-    auto local_begin =
-      world_rank ? std::lower_bound(lps_begin,lps_end,(size_t)(world_rank-1),func) : lps_begin;
-    auto local_end = std::lower_bound(local_begin, lps_end, (size_t)world_rank,func);
-    size_t st_idx = std::distance(lps_begin, local_begin);
-    size_t en_idx = std::distance(lps_begin, local_end  );
-
-    size_t local_cost = 0;
-    for(size_t i = st_idx; i < en_idx; ++i) {
-      local_work.emplace_back( std::move(*(begin + i)) );
-      local_cost += cost(local_work.back());
-    }
-    printf("RANK %d LC %lu\n", world_rank, local_cost);
-  }
-
-
-  // Wait on sends and receives
-  auto wait_st = hrt_t::now();
-  if(packed_req.size()) {
-    MPI_Waitall(packed_req.size(), packed_req.data(), MPI_STATUS_IGNORE);
-  }
-  auto wait_en = hrt_t::now();
-
-
-  auto unpack_st  = hrt_t::now();
-
-  {
-
-  //std::ofstream ofile("task_recv." + std::to_string(world_rank) + ".txt");
-  auto unpack_msg = [&](auto& mpi_buffer) {
-    size_t ntask_recv = 0;
-    //if(&mpi_buffer == &packed_incoming_backward) ofile << "SRC " << world_rank - 1 << std::endl;
-    //else ofile << "SRC " << world_rank + 1 << std::endl;
-
-    mpi_buffer.unpack(ntask_recv); //ofile << ntask_recv << std::endl;
-    for(size_t i = 0; i < ntask_recv; ++i) {
-      auto& task = local_work.emplace_back();
-      mpi_buffer.unpack(task.iParent);
-      mpi_buffer.unpack(task.npts);
-      mpi_buffer.unpack(task.points);
-      mpi_buffer.unpack(task.weights);
-      mpi_buffer.unpack(task.bfn_screening.shell_list);
-      mpi_buffer.unpack(task.bfn_screening.nbe);
-      mpi_buffer.unpack(task.cou_screening.shell_list);
-      mpi_buffer.unpack(task.cou_screening.shell_pair_list);
-      mpi_buffer.unpack(task.cou_screening.shell_pair_idx_list);
-      mpi_buffer.unpack(task.cou_screening.nbe);
-      mpi_buffer.unpack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() <<
-      //  ", " << task.cou_screening.nbe << ", " << task.cou_screening.shell_list.size() <<
-      //  ", " << task.cou_screening.shell_pair_list.size() << ", " << task.cou_screening.shell_pair_idx_list.size()
-      //  << std::endl;
-    }
-  };
-  #if 0
-  // Unpack
-  if(world_rank) {
+  // Unpack incoming tasks (source rank order)
+  for( int i = 0; i < world_size; ++i ) if( recv_buffers[i] ) {
     size_t ntask_recv = 0;
-    packed_incoming.unpack(ntask_recv); 
-    for(size_t i = 0; i < ntask_recv; ++i) {
-      auto& task = local_work.emplace_back();
-      packed_incoming.unpack(task.iParent);
-      packed_incoming.unpack(task.npts);
-      packed_incoming.unpack(task.points);
-      packed_incoming.unpack(task.weights);
-      packed_incoming.unpack(task.bfn_screening.shell_list);
-      packed_incoming.unpack(task.bfn_screening.nbe);
-      packed_incoming.unpack(task.cou_screening.shell_list);
-      packed_incoming.unpack(task.cou_screening.shell_pair_list);
-      packed_incoming.unpack(task.cou_screening.shell_pair_idx_list);
-      packed_incoming.unpack(task.cou_screening.nbe);
-      packed_incoming.unpack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() << std::endl;
-    }
-
-  }
-  #else
-  if(recv_from_backward) unpack_msg(packed_incoming_backward);
-  if(recv_from_forward ) unpack_msg(packed_incoming_forward );
-  #endif
+    recv_buffers[i]->unpack( ntask_recv );
+    for( size_t t = 0; t < ntask_recv; ++t )
+      unpack_task( *recv_buffers[i], local_work.emplace_back() );
   }
-  auto unpack_en  = hrt_t::now();
-
-
-  MPI_Barrier(MPI_COMM_WORLD);
-  printf(
-  "RANK %d AFTER REBALNACE: PREFIX_DUR = %f PACK_DUR = %f WAIT_DUR = %f UNPACK_DUR = %f LW = %lu\n",
-    world_rank,
-    dur_t(prefix_en-prefix_st).count(),
-    dur_t(pack_en-pack_st).count(),
-    dur_t(wait_en-wait_st).count(),
-    dur_t(unpack_en-unpack_st).count(),
-    //local_work.size()
-    std::accumulate(local_work.begin(),local_work.end(),0ul,
-      [=](const auto& a, const auto& b){ return a + cost(b); })
-  );
 
   return local_work;
 
@@ -369,25 +238,37 @@ void LoadBalancerImpl::rebalance_weights() {
   auto cost = [=](const auto& task){ return task.cost(1,natoms); };
   auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
   tasks = std::move(new_tasks);
+  tasks_generation_ = next_tasks_generation_();
+  task_layout_ = TaskCache::rebalanced_layout( task_layout_, "weights" );
 #endif
 }
 
 void LoadBalancerImpl::rebalance_exc_vxc() {
 #ifdef GAUXC_HAS_MPI
   auto& tasks = get_tasks();
-  auto cost = [=](const auto& task){ return task.cost_exc_vxc(1); };
+  auto model = cost_model_;
+  auto cost = [=](const auto& task){ 
+    return model ? model->cost( model->xc_key(), task ) : task.cost_exc_vxc(1); 
+  };
   auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
   tasks = std::move(new_tasks);
+  tasks_generation_ = next_tasks_generation_();
+  task_layout_ = TaskCache::rebalanced_layout( task_layout_, "exc_vxc" );
 #endif
 }
 
 void LoadBalancerImpl::rebalance_exx() {
 #ifdef GAUXC_HAS_MPI
   auto& tasks = get_tasks();
-  auto cost = [=](const auto& task){ return task.cost_exx(); };
+  auto model = cost_model_;
+  const TaskCostModel::key_type exx_key = { TaskCostClass::EXX, TaskCostSpin::RKS };
+  auto cost = [=](const auto& task){ 
+    return model ? model->cost( exx_key, task ) : task.cost_exx(); 
+  };
   auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
   local_tasks_ = std::move(new_tasks);
-  MPI_Barrier(MPI_COMM_WORLD);
+  tasks_generation_ = next_tasks_generation_();
+  task_layout_ = TaskCache::rebalanced_layout( task_layout_, "exx" );
 #endif
 }
 
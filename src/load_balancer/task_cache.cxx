@@ -0,0 +1,319 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "task_cache.hpp"
+#include <gauxc/exceptions.hpp>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <set>
+
+#if __has_include(<sys/mman.h>)
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #define GAUXC_TASK_CACHE_HAS_MMAP
+#endif
+
+namespace GauXC  {
+namespace detail {
+
+namespace {
+
+constexpr char    cache_magic[8] = { 'G','A','U','X','C','T','S','K' };
+constexpr int     narrays        = 13;
+
+struct header_type {
+  char     magic[8];
+  uint32_t version;
+  int32_t  weight_alg;
+  uint64_t key;
+  uint64_t ntasks;
+  uint64_t modified_weights;
+  uint64_t data_size;
+};
+
+struct record_type {
+  int32_t  iParent;
+  int32_t  npts;
+  int32_t  bfn_nbe;
+  int32_t  cou_nbe;
+  double   dist_nearest;
+  double   max_weight;
+  uint64_t offset;           ///< Byte offset of the task arrays in the data section
+  uint64_t size[narrays];    ///< Number of elements of each task array
+};
+
+inline uint64_t align8( uint64_t n ) { return (n + 7) & ~uint64_t(7); }
+
+/// Apply op to every array of a task (in storage order)
+template <typename Task, typename Op>
+void for_each_array( Task& task, const Op& op ) {
+  op( task.points );
+  op( task.weights );
+  op( task.unpartitioned_weights );
+  for( auto* scr : { &task.bfn_screening, &task.cou_screening } ) {
+    op( scr->shell_list );
+    op( scr->shell_pair_list );
+    op( scr->shell_pair_idx_list );
+    op( scr->submat_block );
+    op( scr->submat_map );
+  }
+}
+
+/// 64-bit FNV-1a
+class fnv1a {
+  uint64_t h_ = 14695981039346656037ull;
+public:
+  void add( const void* data, size_t n ) {
+    auto* p = static_cast<const unsigned char*>(data);
+    for( size_t i = 0; i < n; ++i ) { h_ ^= p[i]; h_ *= 1099511628211ull; }
+  }
+  template <typename T> void add( const T& v ) { add( &v, sizeof(T) ); }
+  void add( const std::string& s ) { add( s.data(), s.size() ); }
+  uint64_t value() const { return h_; }
+};
+
+/// Read-only view of a file (mmap'd if available)
+class file_view {
+  const char*       data_ = nullptr;
+  size_t            size_ = 0;
+  std::vector<char> buffer_;
+#ifdef GAUXC_TASK_CACHE_HAS_MMAP
+  void*             map_  = nullptr;
+#endif
+public:
+  file_view( const std::string& fname ) {
+#ifdef GAUXC_TASK_CACHE_HAS_MMAP
+    int fd = ::open( fname.c_str(), O_RDONLY );
+    if( fd < 0 ) return;
+    struct stat st;
+    if( ::fstat( fd, &st ) == 0 and st.st_size > 0 ) {
+      map_ = ::mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( map_ == MAP_FAILED ) map_ = nullptr;
+      else { data_ = static_cast<const char*>(map_); size_ = st.st_size; }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( fname, std::ios::binary | std::ios::ate );
+    if( not in ) return;
+    buffer_.resize( in.tellg() );
+    in.seekg( 0 );
+    in.read( buffer_.data(), buffer_.size() );
+    data_ = buffer_.data(); size_ = buffer_.size();
+#endif
+  }
+  ~file_view() noexcept {
+#ifdef GAUXC_TASK_CACHE_HAS_MMAP
+    if( map_ ) ::munmap( map_, size_ );
+#endif
+  }
+  file_view( const file_view& ) = delete;
+
+  inline const char* data() const { return data_; }
+  inline size_t      size() const { return size_; }
+};
+
+}
+
+uint64_t TaskCache::key( const std::string& kernel, bool distributed,
+  const RuntimeEnvironment& rt, const Molecule& mol,
+  const BasisSet<double>& basis, const MolGrid& mg, XCWeightAlg weight_alg,
+  uint64_t task_layout ) {
+
+  fnv1a h;
+  h.add( version );
+  h.add( kernel );
+  h.add( distributed );
+  h.add( rt.comm_size() );
+  h.add( rt.comm_rank() );
+  h.add( weight_alg );
+  h.add( task_layout );
+
+  for( const auto& atom : mol ) {
+    h.add( atom.Z.get() );
+    h.add( atom.x ); h.add( atom.y ); h.add( atom.z );
+  }
+
+  for( const auto& sh : basis ) {
+    h.add( sh.l() ); h.add( sh.pure() ); h.add( sh.nprim() );
+    h.add( sh.alpha_data(), sh.nprim() * sizeof(double) );
+    h.add( sh.coeff_data(), sh.nprim() * sizeof(double) );
+    h.add( sh.O_data(), 3 * sizeof(double) );
+    h.add( sh.cutoff_radius() );
+  }
+
+  // Atomic grids in order of first appearance. Points are omitted as they
+  // depend on the last recentering of the quadrature.
+  std::set<int64_t> seen;
+  for( const auto& atom : mol ) if( seen.insert( atom.Z.get() ).second ) {
+    const auto& batcher = mg.get_grid( atom.Z ).batcher();
+    const auto& weights = batcher.quadrature().weights();
+    h.add( atom.Z.get() );
+    h.add( batcher.nbatches() );
+    h.add( weights.size() );
+    h.add( weights.data(), weights.size() * sizeof(double) );
+  }
+
+  return h.value();
+
+}
+
+uint64_t TaskCache::refined_layout( uint64_t layout,
+  const TaskGranularitySettings& settings ) {
+  fnv1a h;
+  h.add( layout );
+  h.add( std::string("refine") );
+  h.add( settings.max_cost );
+  h.add( settings.min_npts_x_nbe );
+  h.add( settings.max_nbe_overhead );
+  return h.value();
+}
+
+uint64_t TaskCache::rebalanced_layout( uint64_t layout,
+  const std::string& kind ) {
+  fnv1a h;
+  h.add( layout );
+  h.add( std::string("rebalance_") + kind );
+  return h.value();
+}
+
+std::string TaskCache::file_name( const std::string& prefix, uint64_t key,
+  int rank ) {
+  std::stringstream ss;
+  ss << prefix << "." << std::hex << std::setw(16) << std::setfill('0') << key
+     << std::dec << ".rank" << rank << ".gtc";
+  return ss.str();
+}
+
+void TaskCache::write( const std::string& fname, uint64_t key,
+  const LoadBalancerState& state, const std::vector<XCTask>& tasks ) {
+
+  const size_t ntasks = tasks.size();
+  std::vector<record_type> records( ntasks );
+
+  uint64_t offset = 0;
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    const auto& task = tasks[iT];
+    auto& rec = records[iT];
+    rec.iParent      = task.iParent;
+    rec.npts         = task.npts;
+    rec.bfn_nbe      = task.bfn_screening.nbe;
+    rec.cou_nbe      = task.cou_screening.nbe;
+    rec.dist_nearest = task.dist_nearest;
+    rec.max_weight   = task.max_weight;
+    rec.offset       = offset;
+    int i = 0;
+    for_each_array( task, [&]( const auto& v ) {
+      rec.size[i++] = v.size();
+      offset += align8( v.size() * sizeof(v[0]) );
+    });
+  }
+
+  header_type header;
+  std::memcpy( header.magic, cache_magic, sizeof(cache_magic) );
+  header.version          = version;
+  header.weight_alg       = int32_t(state.weight_alg);
+  header.key              = key;
+  header.ntasks           = ntasks;
+  header.modified_weights = state.modified_weights_are_stored;
+  header.data_size        = offset;
+
+  std::ofstream out( fname, std::ios::binary );
+  if( not out ) GAUXC_GENERIC_EXCEPTION("TaskCache: Could Not Open " + fname);
+
+  const char zeros[8] = {};
+  out.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+  out.write( reinterpret_cast<const char*>(records.data()),
+    ntasks * sizeof(record_type) );
+  for( const auto& task : tasks )
+  for_each_array( task, [&]( const auto& v ) {
+    const size_t nbytes = v.size() * sizeof(v[0]);
+    out.write( reinterpret_cast<const char*>(v.data()), nbytes );
+    out.write( zeros, align8(nbytes) - nbytes );
+  });
+
+  if( not out ) GAUXC_GENERIC_EXCEPTION("TaskCache: Failed to Write " + fname);
+
+}
+
+bool TaskCache::read( const std::string& fname, uint64_t key,
+  LoadBalancerState& state, std::vector<XCTask>& tasks ) {
+
+  file_view file( fname );
+  if( not file.data() ) return false;
+
+  header_type header;
+  if( file.size() < sizeof(header) )
+    GAUXC_GENERIC_EXCEPTION("TaskCache: Truncated File " + fname);
+  std::memcpy( &header, file.data(), sizeof(header) );
+
+  if( std::memcmp( header.magic, cache_magic, sizeof(cache_magic) ) )
+    GAUXC_GENERIC_EXCEPTION("TaskCache: Not a Task Cache " + fname);
+  if( header.version != version or header.key != key ) return false;
+
+  const size_t ntasks   = header.ntasks;
+  const size_t rec_size = ntasks * sizeof(record_type);
+  if( file.size() != sizeof(header) + rec_size + header.data_size )
+    GAUXC_GENERIC_EXCEPTION("TaskCache: Truncated File " + fname);
+
+  const auto* records =
+    reinterpret_cast<const record_type*>( file.data() + sizeof(header) );
+  const char* data = file.data() + sizeof(header) + rec_size;
+
+  // Validate the array extents before touching the data section
+  {
+    XCTask extents;
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      uint64_t end = records[iT].offset; int i = 0;
+      for_each_array( extents, [&]( const auto& v ) {
+        end += align8( records[iT].size[i++] * sizeof(v[0]) );
+      });
+      if( end > header.data_size )
+        GAUXC_GENERIC_EXCEPTION("TaskCache: Corrupt Task Record in " + fname);
+    }
+  }
+
+  std::vector<XCTask> new_tasks( ntasks );
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    const auto& rec = records[iT];
+    auto& task = new_tasks[iT];
+    task.iParent           = rec.iParent;
+    task.npts              = rec.npts;
+    task.bfn_screening.nbe = rec.bfn_nbe;
+    task.cou_screening.nbe = rec.cou_nbe;
+    task.dist_nearest      = rec.dist_nearest;
+    task.max_weight        = rec.max_weight;
+
+    const char* ptr = data + rec.offset;
+    int i = 0;
+    for_each_array( task, [&]( auto& v ) {
+      v.resize( rec.size[i++] );
+      const size_t nbytes = v.size() * sizeof(v[0]);
+      if( nbytes ) std::memcpy( (void*)v.data(), ptr, nbytes );
+      ptr += align8( nbytes );
+    });
+  }
+
+  state.modified_weights_are_stored = header.modified_weights;
+  if( header.modified_weights ) state.partition_weights_on_the_fly = false;
+  state.weight_alg                  = XCWeightAlg(header.weight_alg);
+  tasks = std::move( new_tasks );
+
+  return true;
+
+}
+
+}
+}
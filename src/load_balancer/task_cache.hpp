@@ -0,0 +1,72 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/load_balancer.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/** Per-rank binary store of the local tasks of a LoadBalancer
+ *
+ *  Layout (native endianness, all sections 8 byte aligned):
+ *    - header:  magic, version, key, ntasks, LoadBalancerState
+ *    - records: one fixed size record per task (scalars + array extents)
+ *    - data:    the task arrays (points, weights, screening lists) back to
+ *               back, in record order
+ *
+ *  Files are read through mmap, every task array is filled by a single copy
+ *  out of the mapping (tasks in parallel).
+ */
+struct TaskCache {
+
+  static constexpr uint32_t version = 2;
+
+  /** Hash identifying the task generation inputs
+   *
+   *  Covers the load balancer kernel and its generation mode (replicated or
+   *  distributed), the rank layout, the molecule, the basis (incl. shell
+   *  cutoffs), the atomic grids (batching and weights), the weight
+   *  partitioning scheme and the task layout (refinements / rebalances
+   *  applied after generation).
+   */
+  static uint64_t key( const std::string& kernel, bool distributed,
+    const RuntimeEnvironment& rt, const Molecule& mol,
+    const BasisSet<double>& basis, const MolGrid& mg, XCWeightAlg weight_alg,
+    uint64_t task_layout );
+
+  /// Task layout after refine_tasks( settings ) (0 = tasks as generated)
+  static uint64_t refined_layout( uint64_t layout,
+    const TaskGranularitySettings& settings );
+
+  /// Task layout after a rebalance of the given kind (0 = tasks as generated)
+  static uint64_t rebalanced_layout( uint64_t layout, const std::string& kind );
+
+  /// Per-rank file name of the cache for `key`
+  static std::string file_name( const std::string& prefix, uint64_t key,
+    int rank );
+
+  static void write( const std::string& fname, uint64_t key,
+    const LoadBalancerState& state, const std::vector<XCTask>& tasks );
+
+  /// Read a cache file, false if it does not exist or was written for
+  /// another key (throws on corrupt files)
+  static bool read( const std::string& fname, uint64_t key,
+    LoadBalancerState& state, std::vector<XCTask>& tasks );
+
+};
+
+}
+}
@@ -0,0 +1,300 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include <gauxc/task_cost_model.hpp>
+#include <gauxc/exceptions.hpp>
+#include <gauxc/runtime_environment.hpp>
+#include <gauxc/util/mpi.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace GauXC {
+
+namespace {
+
+constexpr const char* model_header = "GAUXC_TASK_COST_MODEL";
+constexpr int         model_version = 1;
+
+/// Solve the (n,n) system A x = b in place (partial pivoting), false if singular
+bool dense_solve( int n, double* A, double* b ) {
+  for( int k = 0; k < n; ++k ) {
+    int piv = k;
+    for( int i = k+1; i < n; ++i )
+      if( std::abs(A[i*n+k]) > std::abs(A[piv*n+k]) ) piv = i;
+    if( std::abs(A[piv*n+k]) < 1e-12 ) return false;
+    if( piv != k ) {
+      for( int j = 0; j < n; ++j ) std::swap( A[k*n+j], A[piv*n+j] );
+      std::swap( b[k], b[piv] );
+    }
+    for( int i = k+1; i < n; ++i ) {
+      const double f = A[i*n+k] / A[k*n+k];
+      for( int j = k; j < n; ++j ) A[i*n+j] -= f * A[k*n+j];
+      b[i] -= f * b[k];
+    }
+  }
+  for( int k = n-1; k >= 0; --k ) {
+    for( int j = k+1; j < n; ++j ) b[k] -= A[k*n+j] * b[j];
+    b[k] /= A[k*n+k];
+  }
+  return true;
+}
+
+}
+
+TaskCostModel::feature_type TaskCostModel::features( TaskCostClass cls,
+  const XCTask& task ) {
+
+  const double npts = std::max<size_t>( task.npts, task.points.size() );
+  const double nbe  = task.bfn_screening.nbe;
+
+  if( cls == TaskCostClass::EXX ) {
+    const double nbe_cou = task.cou_screening.nbe;
+    const double npairs  = task.cou_screening.shell_pair_list.size();
+    return { npts * nbe * nbe_cou, npts * npairs, npts * nbe };
+  }
+
+  return { npts * nbe * nbe, npts * nbe, npts };
+
+}
+
+void TaskCostModel::record( key_type key, const XCTask& task, double seconds ) {
+
+  const auto f = features( key.first, task );
+  auto& s = pending_[key];
+  s.nsamples++;
+  for( int i = 0; i < nfeatures; ++i ) {
+    for( int j = 0; j < nfeatures; ++j ) s.xtx[i*nfeatures + j] += f[i] * f[j];
+    s.xty[i] += f[i] * seconds;
+  }
+  s.yty += seconds * seconds;
+
+  if( key.first != TaskCostClass::EXX ) pending_xc_key_ = key_index(key);
+
+}
+
+void TaskCostModel::fit() {
+  merge_pending_and_fit_();
+}
+
+void TaskCostModel::fit( const RuntimeEnvironment& rt ) {
+
+#ifdef GAUXC_HAS_MPI
+  // Sum the pending statistics over a fixed layout of all keys
+  // (nsamples, xtx, xty, yty), such that ranks without samples take part
+  constexpr int nstat = 2 + nfeatures * nfeatures + nfeatures;
+  std::vector<double> buf( nclasses * nspins * nstat, 0. );
+  for( const auto& [key, s] : pending_ ) {
+    auto* b = buf.data() + key_index(key) * nstat;
+    b[0] = s.nsamples;
+    std::copy( s.xtx.begin(), s.xtx.end(), b + 1 );
+    std::copy( s.xty.begin(), s.xty.end(), b + 1 + nfeatures * nfeatures );
+    b[nstat-1] = s.yty;
+  }
+  MPI_Allreduce( MPI_IN_PLACE, buf.data(), buf.size(), MPI_DOUBLE, MPI_SUM,
+    rt.comm() );
+  MPI_Allreduce( MPI_IN_PLACE, &pending_xc_key_, 1, MPI_INT, MPI_MAX,
+    rt.comm() );
+
+  pending_.clear();
+  for( int cls = 0; cls < nclasses; ++cls )
+  for( int spin = 0; spin < nspins; ++spin ) {
+    const key_type key = { TaskCostClass(cls), TaskCostSpin(spin) };
+    const auto* b = buf.data() + key_index(key) * nstat;
+    if( b[0] == 0. ) continue;
+    auto& s = pending_[key];
+    s.nsamples = std::llround( b[0] );
+    std::copy( b + 1, b + 1 + nfeatures * nfeatures, s.xtx.begin() );
+    std::copy( b + 1 + nfeatures * nfeatures, b + nstat - 1, s.xty.begin() );
+    s.yty = b[nstat-1];
+  }
+#else
+  (void)rt;
+#endif
+
+  merge_pending_and_fit_();
+
+}
+
+void TaskCostModel::merge_pending_and_fit_() {
+
+  for( const auto& [key, p] : pending_ ) {
+    auto& s = stats_[key];
+    s.nsamples += p.nsamples;
+    for( int i = 0; i < nfeatures * nfeatures; ++i ) s.xtx[i] += p.xtx[i];
+    for( int i = 0; i < nfeatures; ++i ) s.xty[i] += p.xty[i];
+    s.yty += p.yty;
+  }
+  pending_.clear();
+
+  if( pending_xc_key_ >= 0 ) 
+    xc_key_ = { TaskCostClass(pending_xc_key_ / nspins), 
+                TaskCostSpin(pending_xc_key_ % nspins) };
+  pending_xc_key_ = -1;
+
+  for( auto& [key, s] : stats_ ) {
+
+    s.fitted = false;
+    if( s.nsamples < min_samples ) continue;
+
+    // Diagonal scaling (features span many orders of magnitude)
+    feature_type d;
+    for( int i = 0; i < nfeatures; ++i ) d[i] = std::sqrt( s.xtx[i*nfeatures+i] );
+
+    // Non-negative least squares by enumeration of the active set
+    double best_rss = std::numeric_limits<double>::infinity();
+    for( int mask = 1; mask < (1 << nfeatures); ++mask ) {
+
+      std::array<int, nfeatures> idx; int n = 0;
+      bool valid = true;
+      for( int i = 0; i < nfeatures; ++i ) if( mask & (1 << i) ) {
+        valid = valid and d[i] > 0.;
+        idx[n++] = i;
+      }
+      if( not valid ) continue;
+
+      std::array<double, nfeatures * nfeatures> A;
+      feature_type b;
+      for( int i = 0; i < n; ++i ) {
+        for( int j = 0; j < n; ++j )
+          A[i*n+j] = s.xtx[idx[i]*nfeatures + idx[j]] / (d[idx[i]] * d[idx[j]]);
+        b[i] = s.xty[idx[i]] / d[idx[i]];
+      }
+      if( not dense_solve( n, A.data(), b.data() ) ) continue;
+
+      feature_type c = {};
+      bool nonneg = true;
+      for( int i = 0; i < n; ++i ) {
+        c[idx[i]] = b[i] / d[idx[i]];
+        nonneg = nonneg and c[idx[i]] >= 0.;
+      }
+      if( not nonneg ) continue;
+
+      // rss = y'y - 2 c'X'y + c'X'X c
+      double rss = s.yty;
+      for( int i = 0; i < nfeatures; ++i ) {
+        rss -= 2. * c[i] * s.xty[i];
+        for( int j = 0; j < nfeatures; ++j )
+          rss += c[i] * s.xtx[i*nfeatures + j] * c[j];
+      }
+
+      if( rss < best_rss ) {
+        best_rss = rss;
+        s.coeff  = c;
+        s.fitted = true;
+      }
+
+    }
+
+  }
+
+}
+
+bool TaskCostModel::calibrated( key_type key ) const {
+  auto it = stats_.find(key);
+  return it != stats_.end() and it->second.fitted;
+}
+
+const TaskCostModel::feature_type& TaskCostModel::coefficients( key_type key ) const {
+  if( not calibrated(key) )
+    GAUXC_GENERIC_EXCEPTION("TaskCostModel: Requested Key Is Not Calibrated");
+  return stats_.at(key).coeff;
+}
+
+double TaskCostModel::predict( key_type key, const XCTask& task ) const {
+  const auto& c = coefficients(key);
+  const auto  f = features( key.first, task );
+  double t = 0.;
+  for( int i = 0; i < nfeatures; ++i ) t += c[i] * f[i];
+  return t;
+}
+
+size_t TaskCostModel::cost( key_type key, const XCTask& task ) const {
+
+  if( calibrated(key) ) return size_t( std::llround( 1e9 * predict(key, task) ) );
+
+  switch( key.first ) {
+    case TaskCostClass::LDA:       return task.cost_exc_vxc(0);
+    case TaskCostClass::GGA:       return task.cost_exc_vxc(1);
+    case TaskCostClass::MGGA:      return task.cost_exc_vxc(1);
+    case TaskCostClass::MGGA_LAPL: return task.cost_exc_vxc(2);
+    case TaskCostClass::EXX:       return task.cost_exx();
+  }
+  return task.cost_exc_vxc(1);
+
+}
+
+void TaskCostModel::clear() {
+  stats_.clear();
+  pending_.clear();
+  pending_xc_key_ = -1;
+}
+
+void TaskCostModel::write( std::ostream& out ) const {
+
+  out << model_header << " " << model_version << "\n";
+  out << std::setprecision(17);
+  out << "XC_KEY " << int(xc_key_.first) << " " << int(xc_key_.second) << "\n";
+  for( const auto& [key, s] : stats_ ) {
+    out << "KEY " << int(key.first) << " " << int(key.second) << " "
+        << s.nsamples;
+    for( auto x : s.xtx ) out << " " << x;
+    for( auto x : s.xty ) out << " " << x;
+    out << " " << s.yty << "\n";
+  }
+
+}
+
+void TaskCostModel::read( std::istream& in ) {
+
+  std::string header; int version;
+  in >> header >> version;
+  if( not in or header != model_header or version != model_version )
+    GAUXC_GENERIC_EXCEPTION("TaskCostModel: Invalid Model Header");
+
+  stats_.clear();
+  std::string tag;
+  while( in >> tag ) {
+    int cls, spin;
+    in >> cls >> spin;
+    const key_type key = { TaskCostClass(cls), TaskCostSpin(spin) };
+    if( tag == "XC_KEY" ) { xc_key_ = key; continue; }
+    if( tag != "KEY" )
+      GAUXC_GENERIC_EXCEPTION("TaskCostModel: Unrecognized Entry " + tag);
+
+    auto& s = stats_[key];
+    in >> s.nsamples;
+    for( auto& x : s.xtx ) in >> x;
+    for( auto& x : s.xty ) in >> x;
+    in >> s.yty;
+    if( not in ) GAUXC_GENERIC_EXCEPTION("TaskCostModel: Truncated Model Entry");
+  }
+
+  fit();
+
+}
+
+void TaskCostModel::save( const std::string& fname ) const {
+  std::ofstream out( fname );
+  if( not out ) GAUXC_GENERIC_EXCEPTION("TaskCostModel: Could Not Open " + fname);
+  write( out );
+}
+
+void TaskCostModel::load( const std::string& fname ) {
+  std::ifstream in( fname );
+  if( not in ) GAUXC_GENERIC_EXCEPTION("TaskCostModel: Could Not Open " + fname);
+  read( in );
+}
+
+}
@@ -0,0 +1,225 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "load_balancer_impl.hpp"
+#include "task_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#if __has_include(<unistd.h>)
+  #include <unistd.h>
+#endif
+
+namespace GauXC::detail {
+
+namespace {
+
+size_t l2_cache_bytes() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  const long sz = ::sysconf( _SC_LEVEL2_CACHE_SIZE );
+  if( sz > 0 ) return sz;
+#endif
+  return 1ul << 20;
+}
+
+/// Task over the points [st,en) of task (with the screening of task)
+XCTask task_slice( const XCTask& task, size_t st, size_t en ) {
+  XCTask t;
+  t.iParent      = task.iParent;
+  t.points.assign ( task.points.begin()  + st, task.points.begin()  + en );
+  t.weights.assign( task.weights.begin() + st, task.weights.begin() + en );
+  if( task.unpartitioned_weights.size() == task.points.size() )
+    t.unpartitioned_weights.assign( task.unpartitioned_weights.begin() + st,
+      task.unpartitioned_weights.begin() + en );
+  t.npts         = t.points.size();
+  t.dist_nearest = task.dist_nearest;
+  t.max_weight   = task.max_weight;
+  t.bfn_screening.shell_list = task.bfn_screening.shell_list;
+  t.bfn_screening.nbe        = task.bfn_screening.nbe;
+  return t;
+}
+
+/// Merge [begin,end) (same parent) into a task over the union of their shells
+template <typename TaskIt>
+XCTask task_union( TaskIt begin, TaskIt end, std::vector<int32_t> shell_list,
+  int32_t nbe ) {
+
+  XCTask t;
+  t.iParent      = begin->iParent;
+  t.dist_nearest = begin->dist_nearest;
+  t.max_weight   = -std::numeric_limits<double>::infinity();
+
+  bool unpartitioned = true;
+  size_t npts = 0;
+  for( auto it = begin; it != end; ++it ) {
+    npts += it->points.size();
+    unpartitioned = unpartitioned and
+      it->unpartitioned_weights.size() == it->points.size();
+    t.max_weight = std::max( t.max_weight, it->max_weight );
+  }
+
+  t.points.reserve( npts );
+  t.weights.reserve( npts );
+  if( unpartitioned ) t.unpartitioned_weights.reserve( npts );
+  for( auto it = begin; it != end; ++it ) {
+    t.points.insert ( t.points.end(),  it->points.begin(),  it->points.end()  );
+    t.weights.insert( t.weights.end(), it->weights.begin(), it->weights.end() );
+    if( unpartitioned )
+      t.unpartitioned_weights.insert( t.unpartitioned_weights.end(),
+        it->unpartitioned_weights.begin(), it->unpartitioned_weights.end() );
+  }
+  t.npts = npts;
+
+  t.bfn_screening.shell_list = std::move( shell_list );
+  t.bfn_screening.nbe        = nbe;
+  return t;
+
+}
+
+}
+
+void LoadBalancerImpl::refine_tasks( const TaskGranularitySettings& settings ) {
+
+  auto refine_st = std::chrono::high_resolution_clock::now();
+
+  auto& tasks = get_tasks();
+
+  #ifdef _OPENMP
+  const size_t nthreads = omp_get_max_threads();
+  #else
+  const size_t nthreads = 1;
+  #endif
+
+  auto model = cost_model_;
+  auto cost = [&]( const XCTask& task ) -> double {
+    return model ? model->cost( model->xc_key(), task ) : task.cost_exc_vxc(1);
+  };
+
+  // Split threshold: a single task may not exceed a fraction of the work of
+  // a thread (no splitting is required for serial task loops)
+  double max_cost = settings.max_cost;
+  if( max_cost <= 0. ) {
+    double total_cost = 0.;
+    for( const auto& task : tasks ) total_cost += cost( task );
+    max_cost = nthreads > 1 ? total_cost / (8 * nthreads) :
+      std::numeric_limits<double>::infinity();
+  }
+
+  const size_t min_npts_x_nbe = settings.min_npts_x_nbe ?
+    settings.min_npts_x_nbe : l2_cache_bytes() / (4 * sizeof(double));
+
+  // Split tasks over the cost threshold into contiguous point ranges
+  std::vector<XCTask> refined;
+  refined.reserve( tasks.size() );
+  std::vector<size_t> split_idx;
+  for( auto& task : tasks ) {
+    const size_t npts    = task.points.size();
+    const size_t npieces = std::min<size_t>( npts, std::ceil( cost(task) / max_cost ) );
+    if( npieces <= 1 ) { refined.emplace_back( std::move(task) ); continue; }
+    for( size_t i = 0; i < npieces; ++i ) {
+      split_idx.emplace_back( refined.size() );
+      refined.emplace_back( task_slice( task, i*npts/npieces, (i+1)*npts/npieces ) );
+    }
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t i = 0; i < split_idx.size(); ++i )
+    screen_task_points_( refined[split_idx[i]] );
+
+  // Merge small tasks. Tasks of the same parent are ordered by shell list
+  // such that similar lists are adjacent, groups are grown greedily while
+  // the union of their shell lists stays within the nbe overhead. Pieces
+  // which no longer overlap any shell are kept (for their points) as is.
+  auto is_small = [&]( const XCTask& t ) {
+    return not t.bfn_screening.shell_list.empty() and
+      t.points.size() * t.bfn_screening.nbe < min_npts_x_nbe;
+  };
+  auto small_begin = std::stable_partition( refined.begin(), refined.end(),
+    [&]( const auto& t ){ return not is_small(t); } );
+  std::sort( small_begin, refined.end(), []( const auto& a, const auto& b ) {
+    if( a.iParent != b.iParent ) return a.iParent < b.iParent;
+    return a.bfn_screening.shell_list < b.bfn_screening.shell_list;
+  });
+
+  std::vector<XCTask> merged;
+  merged.reserve( refined.size() );
+  std::move( refined.begin(), small_begin, std::back_inserter(merged) );
+
+  const auto& basis = *basis_;
+  auto grp_begin = small_begin;
+  while( grp_begin != refined.end() ) {
+
+    std::vector<int32_t> shell_list = grp_begin->bfn_screening.shell_list;
+    int64_t nbe  = grp_begin->bfn_screening.nbe;
+    int64_t npts = grp_begin->points.size();
+    double  work = double(npts) * nbe * nbe; // Work of the separate tasks
+
+    auto grp_end = std::next( grp_begin );
+    std::vector<int32_t> trial;
+    XCTask union_task; // Only the extents enter the EXC/VXC cost
+    for( ; grp_end != refined.end() and npts * nbe < (int64_t)min_npts_x_nbe;
+         ++grp_end ) {
+
+      const auto& t = *grp_end;
+      if( t.iParent != grp_begin->iParent ) break;
+
+      const auto& sl = t.bfn_screening.shell_list;
+      trial.clear();
+      std::set_union( shell_list.begin(), shell_list.end(), sl.begin(), sl.end(),
+        std::back_inserter(trial) );
+      int64_t trial_nbe = nbe;
+      if( trial.size() != shell_list.size() ) {
+        trial_nbe = 0;
+        for( auto sh : trial ) trial_nbe += basis.at(sh).size();
+      }
+
+      const int64_t trial_npts = npts + t.points.size();
+      const double  trial_work = work + double(t.points.size()) *
+        t.bfn_screening.nbe * t.bfn_screening.nbe;
+      const double  union_work = double(trial_npts) * trial_nbe * trial_nbe;
+      union_task.npts              = trial_npts;
+      union_task.bfn_screening.nbe = trial_nbe;
+      const double  union_cost = cost( union_task ); // Same path as max_cost
+      if( union_work > (1. + settings.max_nbe_overhead) * trial_work or
+          union_cost > max_cost ) break;
+
+      shell_list.swap( trial );
+      nbe = trial_nbe; npts = trial_npts; work = trial_work;
+
+    }
+
+    if( std::distance( grp_begin, grp_end ) == 1 )
+      merged.emplace_back( std::move(*grp_begin) );
+    else
+      merged.emplace_back( task_union( grp_begin, grp_end, std::move(shell_list), nbe ) );
+    grp_begin = grp_end;
+
+  }
+
+  tasks = std::move( merged );
+  tasks_generation_ = next_tasks_generation_();
+  task_layout_ = TaskCache::refined_layout( task_layout_, settings );
+
+  auto refine_en = std::chrono::high_resolution_clock::now();
+  timer_.add_timing("LoadBalancer.RefineTasks",
+    std::chrono::duration<double>(refine_en - refine_st));
+
+}
+
+}
@@ -21,6 +21,8 @@ void DeviceMolecularWeights::modify_weights( LoadBalancer& lb ) const {
     GAUXC_GENERIC_EXCEPTION("Attempting to Overwrite Modified Weights");
   if(this->settings_.weight_alg != XCWeightAlg::SSF)
     GAUXC_GENERIC_EXCEPTION("Non-SSF Weights NYI for Device Integration");
+  if(this->settings_.on_the_fly)
+    GAUXC_GENERIC_EXCEPTION("On-the-fly Weights NYI for Device Integration");
 
   // Cast LWD to LocalDeviceWorkDriver
   auto* lwd = dynamic_cast<LocalDeviceWorkDriver*>(this->local_work_driver_.get() );
@@ -43,6 +45,10 @@ void DeviceMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   };
   std::stable_sort(task_begin, task_end, task_comparator );
 
+  // Keep the unpartitioned weights for geometry updates
+  if( lb.state().retain_unpartitioned_weights )
+  for( auto& task : tasks ) task.unpartitioned_weights = task.weights;
+
   const auto& mol  = lb.molecule();
   const auto natoms = mol.natoms();
   const auto& meta = lb.molmeta();
@@ -83,6 +89,7 @@ void DeviceMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   rt.device_backend()->master_queue_synchronize();
  
   lb.state().modified_weights_are_stored = true;
+  lb.state().partition_weights_on_the_fly = false;
   lb.state().weight_alg = this->settings_.weight_alg;
 
 }
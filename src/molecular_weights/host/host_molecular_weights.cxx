@@ -19,6 +19,14 @@ void HostMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   if(lb.state().modified_weights_are_stored)
     GAUXC_GENERIC_EXCEPTION("Attempting to Overwrite Modified Weights");
 
+  // Partition weights in the integrator task loops. May be changed by
+  // subsequent calls as the task weights are left untouched.
+  if( this->settings_.on_the_fly ) {
+    lb.state().partition_weights_on_the_fly = true;
+    lb.state().weight_alg = this->settings_.weight_alg;
+    return;
+  }
+
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
 
@@ -31,13 +39,19 @@ void HostMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   };
   std::stable_sort( tasks.begin(), tasks.end(), task_comparator );
 
+  // Keep the unpartitioned weights for geometry updates
+  if( lb.state().retain_unpartitioned_weights )
+  for( auto& task : tasks ) task.unpartitioned_weights = task.weights;
+
   // Modify the weights
   const auto& mol  = lb.molecule();
   const auto& meta = lb.molmeta();
   lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
     tasks.begin(), tasks.end() );
+  lb.mark_tasks_modified();
 
   lb.state().modified_weights_are_stored = true;
+  lb.state().partition_weights_on_the_fly = false;
   lb.state().weight_alg = this->settings_.weight_alg;
 }
 
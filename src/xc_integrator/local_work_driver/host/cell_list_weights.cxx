@@ -0,0 +1,539 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/cell_list_weights.hpp"
+#include "common/integrator_constants.hpp"
+#include <gauxc/util/geometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace GauXC {
+
+AtomCellList::AtomCellList( const Molecule& mol, double h ) {
+
+  const size_t natoms = mol.natoms();
+  std::array<double,3> hi;
+  lo_.fill(  std::numeric_limits<double>::infinity() );
+  hi.fill ( -std::numeric_limits<double>::infinity() );
+  for( const auto& atom : mol ) {
+    const std::array<double,3> c = { atom.x, atom.y, atom.z };
+    for( int d = 0; d < 3; ++d ) {
+      lo_[d] = std::min( lo_[d], c[d] );
+      hi[d]  = std::max( hi[d],  c[d] );
+    }
+  }
+
+  // Cell size >= h, coarsened to at most 8 cells per atom
+  h_ = std::max( h, 1e-8 );
+  const int64_t max_cells = 8 * std::max<size_t>( natoms, 1 );
+  while( true ) {
+    int64_t ncell_tot = 1;
+    for( int d = 0; d < 3; ++d ) {
+      ncell_[d] = natoms ? int64_t( (hi[d] - lo_[d]) / h_ ) + 1 : 1;
+      ncell_tot *= ncell_[d];
+    }
+    if( ncell_tot <= max_cells ) break;
+    h_ *= 2.;
+  }
+
+  auto cell_idx = [&]( const Atom& atom ) {
+    const double c[3] = { atom.x, atom.y, atom.z };
+    int64_t idx[3];
+    for( int d = 0; d < 3; ++d )
+      idx[d] = std::clamp<int64_t>( (c[d] - lo_[d]) / h_, 0, ncell_[d]-1 );
+    return idx[0] + ncell_[0] * (idx[1] + ncell_[1] * idx[2]);
+  };
+
+  const int64_t ncell_tot = ncell_[0] * ncell_[1] * ncell_[2];
+  cell_ptr_.assign( ncell_tot + 1, 0 );
+  for( const auto& atom : mol ) cell_ptr_[ cell_idx(atom) + 1 ]++;
+  std::partial_sum( cell_ptr_.begin(), cell_ptr_.end(), cell_ptr_.begin() );
+
+  atoms_.resize( natoms );
+  std::vector<int32_t> fill( cell_ptr_.begin(), cell_ptr_.end() - 1 );
+  for( size_t iA = 0; iA < natoms; ++iA ) atoms_[ fill[cell_idx(mol[iA])]++ ] = iA;
+
+}
+
+void AtomCellList::query( const std::array<double,3>& box_lo,
+  const std::array<double,3>& box_up, std::vector<int32_t>& atoms ) const {
+
+  int64_t st[3], en[3];
+  for( int d = 0; d < 3; ++d ) {
+    const double l = (box_lo[d] - lo_[d]) / h_;
+    const double u = (box_up[d] - lo_[d]) / h_;
+    if( u < 0. or l >= ncell_[d] ) return;
+    st[d] = std::max<int64_t>( 0, std::floor(l) );
+    en[d] = std::min<int64_t>( ncell_[d]-1, std::floor(u) );
+  }
+
+  for( int64_t k = st[2]; k <= en[2]; ++k )
+  for( int64_t j = st[1]; j <= en[1]; ++j ) {
+    const int64_t row = ncell_[0] * (j + ncell_[1] * k);
+    atoms.insert( atoms.end(), atoms_.begin() + cell_ptr_[row + st[0]],
+      atoms_.begin() + cell_ptr_[row + en[0] + 1] );
+  }
+
+}
+
+namespace {
+
+constexpr size_t point_block = 32;
+
+/// Pair factors (P_i *= si, P_j *= sj) of the SSF cell function. Clamping
+/// mu / a to [-1,1] yields the exact (0,1) / (1,0) factors outside of the
+/// switching region.
+struct ssf_cell_function {
+  static inline void eval( double mu, double& si, double& sj ) {
+    double x = mu / integrator::magic_ssf_factor<>;
+    x = std::min( 1., std::max( -1., x ) );
+    const double x2 = x  * x;
+    const double x3 = x  * x2;
+    const double x5 = x3 * x2;
+    const double x7 = x5 * x2;
+    const double g  = 0.5 * (1. - (35.*(x - x3) + 21.*x5 - 5.*x7) / 16.);
+    si = g;
+    sj = 1. - g;
+  }
+};
+
+/// Pair factors of the Becke cell function (f_3)
+struct becke_cell_function {
+  static inline double h( double x ) { return 1.5 * x - 0.5 * x * x * x; }
+  static inline void eval( double mu, double& si, double& sj ) {
+    const double g = h(h(h(mu)));
+    si = 0.5 * (1. - g);
+    sj = 0.5 * (1. + g);
+  }
+};
+
+/** Partition fraction P_parent / sum_X P_X for a block of points
+ *
+ *  Cell functions P_X are only evaluated for the first nK atoms of the local
+ *  set (which must contain the parent), the remaining atoms only enter
+ *  through their factors s(mu_XC) on those.
+ *
+ *  @param[in]  coords Centers of the local atom set
+ *  @param[in]  rab    Inter-atomic distances of the local atom set (nL x nL)
+ *  @param[out] frac   Partition fraction of each point
+ *  @param      dist, P  Scratch (nL x point_block / nK x point_block)
+ */
+template <typename CellFunction>
+void partition_block( size_t npts, const std::array<double,3>* points,
+  const std::vector<std::array<double,3>>& coords, const std::vector<double>& rab,
+  size_t nK, size_t iparent, double* dist, double* P, double* frac ) {
+
+  const size_t nL = coords.size();
+  for( size_t l = 0; l < nL; ++l ) {
+    double* d_l = dist + l * point_block;
+    const auto& c = coords[l];
+    #pragma omp simd
+    for( size_t ip = 0; ip < npts; ++ip ) {
+      const double dx = points[ip][0] - c[0];
+      const double dy = points[ip][1] - c[1];
+      const double dz = points[ip][2] - c[2];
+      d_l[ip] = std::sqrt( dx*dx + dy*dy + dz*dz );
+    }
+  }
+  std::fill_n( P, nK * point_block, 1. );
+
+  // Pairs within K update both cell functions
+  for( size_t i = 0; i < nK; ++i )
+  for( size_t j = 0; j < i;  ++j ) {
+    const double  R   = rab[j + i*nL];
+    const double* d_i = dist + i * point_block;
+    const double* d_j = dist + j * point_block;
+    double*       P_i = P    + i * point_block;
+    double*       P_j = P    + j * point_block;
+    #pragma omp simd
+    for( size_t ip = 0; ip < npts; ++ip ) {
+      double si, sj;
+      CellFunction::eval( (d_i[ip] - d_j[ip]) / R, si, sj );
+      P_i[ip] *= si;
+      P_j[ip] *= sj;
+    }
+  }
+
+  // Pairs K x (L \ K) only update the retained cell function
+  for( size_t i = 0;  i < nK; ++i )
+  for( size_t c = nK; c < nL; ++c ) {
+    const double  R   = rab[c + i*nL];
+    const double* d_i = dist + i * point_block;
+    const double* d_c = dist + c * point_block;
+    double*       P_i = P    + i * point_block;
+    #pragma omp simd
+    for( size_t ip = 0; ip < npts; ++ip ) {
+      double si, sc;
+      CellFunction::eval( (d_i[ip] - d_c[ip]) / R, si, sc );
+      P_i[ip] *= si;
+    }
+  }
+
+  for( size_t ip = 0; ip < npts; ++ip ) {
+    double sum = 0.;
+    for( size_t k = 0; k < nK; ++k ) sum += P[k * point_block + ip];
+    frac[ip] = P[iparent * point_block + ip] / sum;
+  }
+
+}
+
+/// Gather the coordinates / distance matrix of a local atom set
+void gather_atoms( const Molecule& mol, const std::vector<double>& RAB,
+  const std::vector<int32_t>& atoms, std::vector<std::array<double,3>>& coords,
+  std::vector<double>& rab ) {
+  const size_t natoms = mol.natoms();
+  const size_t nL     = atoms.size();
+  coords.resize( nL );
+  rab.resize( nL * nL );
+  for( size_t i = 0; i < nL; ++i ) {
+    const auto& atom = mol[atoms[i]];
+    coords[i] = { atom.x, atom.y, atom.z };
+    for( size_t j = 0; j < nL; ++j ) rab[j + i*nL] = RAB[atoms[j] + atoms[i]*natoms];
+  }
+}
+
+inline double box_dist_max( const std::array<double,3>& lo,
+  const std::array<double,3>& up, const std::array<double,3>& c ) {
+  double r2 = 0.;
+  for( int d = 0; d < 3; ++d ) {
+    const double r = std::max( std::abs(c[d] - lo[d]), std::abs(up[d] - c[d]) );
+    r2 += r*r;
+  }
+  return std::sqrt(r2);
+}
+
+}
+
+CellListSSFWeights::CellListSSFWeights( const Molecule& mol ) :
+  cells_( mol, 4. ) {
+  centers_.resize( mol.natoms() );
+  for( size_t iA = 0; iA < mol.natoms(); ++iA )
+    centers_[iA] = { mol[iA].x, mol[iA].y, mol[iA].z };
+}
+
+namespace {
+
+/// Thread local scratch of CellListSSFWeights
+struct ssf_scratch {
+  std::vector<int32_t> cand, local_atoms;
+  std::vector<char>    in_set;
+  std::vector<double>  dmin, dmax;
+  std::vector<std::array<double,3>> coords;
+  std::vector<double>  rab, dist, P, grad;
+};
+
+ssf_scratch& thread_ssf_scratch() {
+  static thread_local ssf_scratch scr;
+  return scr;
+}
+
+/// Derivative ratio t(mu) = s'(mu) / s(mu) of the SSF cell function
+inline double tFrisch( double x ) {
+  const double s_x  = x / integrator::magic_ssf_factor<>;
+  const double s_x2 = s_x  * s_x;
+  const double s_x3 = s_x  * s_x2;
+  const double numerator = 35. * (s_x3 + 3. * s_x2 + 3. * s_x + 1.);
+  const double denominator = (x - integrator::magic_ssf_factor<>) *
+    (5.*s_x3 + 20.*s_x2 + 29.*s_x + 16.);
+  return numerator / denominator;
+}
+
+}
+
+int CellListSSFWeights::local_atoms_( const Molecule& mol, const MolMeta& meta,
+  const XCTask& task, void* scr_ptr ) const {
+
+  constexpr double a = integrator::magic_ssf_factor<>;
+  constexpr double q = (1. + a) / (1. - a); // r_B < q r_A if s(mu_AB) != 1
+
+  auto& scr = *static_cast<ssf_scratch*>(scr_ptr);
+  const size_t natoms = mol.natoms();
+  const auto&  RAB    = meta.rab();
+
+  auto& cand        = scr.cand;
+  auto& local_atoms = scr.local_atoms;
+  auto& in_set      = scr.in_set;
+  auto& dmin        = scr.dmin;
+  auto& dmax        = scr.dmax;
+  if( in_set.size() != natoms ) in_set.assign( natoms, 0 ); // Kept zeroed
+  dmin.resize( natoms );
+  dmax.resize( natoms );
+
+  if( task.points.empty() ) return -1;
+  const int32_t iParent = task.iParent;
+  const double  dist_cutoff = 0.5 * (1. - a) * task.dist_nearest;
+
+  std::array<double,3> lo, up;
+  lo.fill(  std::numeric_limits<double>::infinity() );
+  up.fill( -std::numeric_limits<double>::infinity() );
+  for( const auto& p : task.points )
+  for( int d = 0; d < 3; ++d ) {
+    lo[d] = std::min( lo[d], p[d] );
+    up[d] = std::max( up[d], p[d] );
+  }
+
+  auto bounds = [&]( int32_t iA ) {
+    dmin[iA] = geometry::cube_point_dist_closest<3>( lo.data(), up.data(),
+      centers_[iA].data() );
+    dmax[iA] = box_dist_max( lo, up, centers_[iA] );
+  };
+  auto expand_query = [&]( double r ) {
+    std::array<double,3> qlo, qup;
+    for( int d = 0; d < 3; ++d ) { qlo[d] = lo[d] - r; qup[d] = up[d] + r; }
+    cand.clear();
+    cells_.query( qlo, qup, cand );
+    for( auto iA : cand ) bounds( iA );
+  };
+
+  bounds( iParent );
+  const double dP_max = dmax[iParent];
+  const double dP_min = dmin[iParent];
+
+  // Points within the cutoff of the parent keep their weight
+  if( dP_max < dist_cutoff ) return -1;
+
+  // Atoms X whose cell function may be non-zero somewhere in the box (K):
+  // r_X - r_P < a R_XP (which implies r_X < q r_P)
+  expand_query( q * dP_max );
+  local_atoms.clear();
+  local_atoms.emplace_back( iParent );
+  in_set[iParent] = 1;
+  bool parent_vanishes = false;
+  for( auto iA : cand ) if( iA != iParent ) {
+    const double R = RAB[iA + iParent*natoms];
+    if( dmin[iA] - dP_max < a * R ) { local_atoms.emplace_back( iA ); in_set[iA] = 1; }
+    // r_P - r_A >= a R_PA everywhere: the parent cell function vanishes
+    if( dP_min - dmax[iA] >= a * R ) parent_vanishes = true;
+  }
+
+  if( parent_vanishes ) {
+    for( auto iA : local_atoms ) in_set[iA] = 0;
+    return 0;
+  }
+
+  // Atoms C which alter the cell function of such an X somewhere in the
+  // box: r_C - r_X < a R_XC (which implies r_C < q r_X). Atoms outside of
+  // K do not enter the normalization, atoms outside of L leave the cell
+  // functions of K unchanged.
+  const size_t nK = local_atoms.size();
+  double dX_max = 0.;
+  for( size_t k = 0; k < nK; ++k ) dX_max = std::max( dX_max, dmax[local_atoms[k]] );
+  expand_query( q * dX_max );
+  for( auto iC : cand ) if( not in_set[iC] )
+  for( size_t k = 0; k < nK; ++k ) {
+    const auto iX = local_atoms[k];
+    if( dmin[iC] - dmax[iX] < a * RAB[iC + iX*natoms] ) {
+      local_atoms.emplace_back( iC ); in_set[iC] = 1;
+      break;
+    }
+  }
+
+  for( auto iA : local_atoms ) in_set[iA] = 0;
+
+  gather_atoms( mol, RAB, local_atoms, scr.coords, scr.rab );
+  scr.dist.resize( local_atoms.size() * point_block );
+  scr.P.resize( nK * point_block );
+  return nK;
+
+}
+
+void CellListSSFWeights::partition( const Molecule& mol, const MolMeta& meta,
+  const XCTask& task, double* weights ) const {
+
+  auto& scr = thread_ssf_scratch();
+  const int nK = local_atoms_( mol, meta, task, &scr );
+  if( nK < 0 ) return;
+
+  const size_t npts = task.points.size();
+  if( nK == 0 ) {
+    std::fill_n( weights, npts, 0. );
+    return;
+  }
+
+  const double dist_cutoff = 0.5 * (1. - integrator::magic_ssf_factor<>) *
+    task.dist_nearest;
+
+  double frac[point_block];
+  for( size_t ist = 0; ist < npts; ist += point_block ) {
+    const size_t nb = std::min( point_block, npts - ist );
+    partition_block<ssf_cell_function>( nb, task.points.data() + ist,
+      scr.coords, scr.rab, nK, 0, scr.dist.data(), scr.P.data(), frac );
+    const double* d_parent = scr.dist.data(); // Parent is local atom 0
+    for( size_t ip = 0; ip < nb; ++ip )
+      if( d_parent[ip] >= dist_cutoff ) weights[ist + ip] *= frac[ip];
+  }
+
+}
+
+void CellListSSFWeights::contract_1st_derivative( const Molecule& mol,
+  const MolMeta& meta, const XCTask& task, const double* w_times_f,
+  double* exc_grad_w ) const {
+
+  const double safe_magic_ssf_bound = integrator::magic_ssf_factor<> - 1.e-4;
+  const double w_times_f_thresh = 1.e-12;
+  const double weight_tol = integrator::ssf_weight_tol;
+
+  // Weight derivatives vanish if P_parent is 0 or 1 throughout the task
+  auto& scr = thread_ssf_scratch();
+  const int nK = local_atoms_( mol, meta, task, &scr );
+  if( nK <= 0 ) return;
+
+  const size_t nL   = scr.local_atoms.size();
+  const size_t npts = task.points.size();
+  const auto&  rab  = scr.rab;
+  const auto&  X    = scr.coords;
+  const double dist_cutoff = 0.5 * (1. - integrator::magic_ssf_factor<>) *
+    task.dist_nearest;
+
+  // Gradient contributions of the local atoms of the task
+  auto& grad = scr.grad;
+  grad.assign( 3 * nL, 0. );
+
+  double frac[point_block];
+  for( size_t ist = 0; ist < npts; ist += point_block ) {
+
+    const size_t nb = std::min( point_block, npts - ist );
+    const auto*  points = task.points.data() + ist;
+    partition_block<ssf_cell_function>( nb, points, scr.coords, scr.rab, nK, 0,
+      scr.dist.data(), scr.P.data(), frac );
+
+    for( size_t ip = 0; ip < nb; ++ip ) {
+
+      const double w = w_times_f[ist + ip];
+      if( std::abs(w) < w_times_f_thresh ) continue;
+
+      auto d = [&]( size_t l ) { return scr.dist[l * point_block + ip]; };
+      auto P = [&]( size_t k ) { return scr.P[k * point_block + ip]; };
+      if( d(0) < dist_cutoff ) continue;
+
+      const auto& pt = points[ip];
+      double sum = 0.;
+      for( int k = 0; k < nK; ++k ) sum += P(k);
+
+      // Only atoms of K have a non-zero cell function (second term) or may
+      // be within the switching region of the parent (first term)
+      for( int b = 1; b < nK; ++b ) {
+
+        const double d_b = d(b);
+        double gB[3] = {0., 0., 0.};
+
+        const double rAB = rab[b];
+        const double rAB_inv = 1. / rAB;
+        const double mu_AB = (d(0) - d_b) * rAB_inv;
+        if( std::abs(mu_AB) < safe_magic_ssf_bound ) {
+          // first term is - coef1 * nabla_B mu_BA
+          const double coef1 = tFrisch(mu_AB) / rAB * (P(0) - sum) / sum * w / d_b;
+          for( int c = 0; c < 3; ++c )
+            gB[c] = coef1 * ((X[b][c] - pt[c]) + mu_AB * (X[b][c] - X[0][c]) * rAB_inv * d_b);
+        }
+
+        if( P(b) > weight_tol )
+        for( size_t c = 0; c < nL; ++c ) {
+          if( c == size_t(b) ) continue;
+          const double rBC = rab[c + b*nL];
+          const double mu_BC = (d_b - d(c)) / rBC;
+          if( std::abs(mu_BC) >= safe_magic_ssf_bound ) continue;
+
+          const double coef = P(b) * tFrisch(mu_BC) / rBC / sum * w;
+          for( int x = 0; x < 3; ++x )
+            gB[x] -= coef * ((X[b][x] - pt[x]) / d_b - mu_BC * (X[b][x] - X[c][x]) / rBC);
+
+          if( c != 0 ) {
+            const double d_c = d(c);
+            for( int x = 0; x < 3; ++x ) {
+              const double C = coef * ((X[c][x] - pt[x]) / d_c + mu_BC * (X[c][x] - X[b][x]) / rBC);
+              grad[3*c + x] += C;
+              grad[x]       -= C; // Translational invariance
+            }
+          }
+        }
+
+        for( int x = 0; x < 3; ++x ) {
+          grad[3*b + x] += gB[x];
+          grad[x]       -= gB[x]; // Translational invariance
+        }
+
+      }
+
+    }
+
+  }
+
+  // Single (atomic) update per local atom
+  for( size_t l = 0; l < nL; ++l ) {
+    auto* g = exc_grad_w + 3 * scr.local_atoms[l];
+    for( int x = 0; x < 3; ++x ) {
+      #pragma omp atomic
+      g[x] += grad[3*l + x];
+    }
+  }
+
+}
+
+void cell_list_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const CellListSSFWeights ssf( mol );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    auto& task = *(task_begin + iT);
+    ssf.partition( mol, meta, task, task.weights.data() );
+  }
+
+}
+
+void blocked_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  std::vector<int32_t> all_atoms( natoms );
+  std::iota( all_atoms.begin(), all_atoms.end(), 0 );
+  std::vector<std::array<double,3>> coords;
+  std::vector<double> rab;
+  gather_atoms( mol, meta.rab(), all_atoms, coords, rab );
+
+  #pragma omp parallel
+  {
+
+  std::vector<double> dist( natoms * point_block ), P( natoms * point_block );
+  double frac[point_block];
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    auto& task = *(task_begin + iT);
+    const size_t npts = task.points.size();
+    for( size_t ist = 0; ist < npts; ist += point_block ) {
+      const size_t nb = std::min( point_block, npts - ist );
+      partition_block<becke_cell_function>( nb, task.points.data() + ist,
+        coords, rab, natoms, task.iParent, dist.data(), P.data(), frac );
+      for( size_t ip = 0; ip < nb; ++ip ) task.weights[ist + ip] *= frac[ip];
+    }
+  }
+
+  } // OMP context
+
+}
+
+}
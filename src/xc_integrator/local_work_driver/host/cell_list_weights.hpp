@@ -0,0 +1,114 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "host/local_host_work_driver_pimpl.hpp"
+#include <array>
+#include <vector>
+
+namespace GauXC {
+
+/** Uniform cell list over the atoms of a molecule
+ *
+ *  Cells have a size of at least `h` (coarsened to at most ~8 cells per
+ *  atom), atoms are stored in CSR order of their cell.
+ */
+class AtomCellList {
+
+  double                  h_;
+  std::array<double,3>    lo_;
+  std::array<int64_t,3>   ncell_;
+  std::vector<int32_t>    cell_ptr_;
+  std::vector<int32_t>    atoms_;
+
+public:
+
+  AtomCellList( const Molecule& mol, double h );
+
+  /// Append the atoms of all cells overlapping [lo,up] to `atoms` (unsorted)
+  void query( const std::array<double,3>& lo, const std::array<double,3>& up,
+    std::vector<int32_t>& atoms ) const;
+
+};
+
+using task_iterator = detail::LocalHostWorkDriverPIMPL::task_iterator;
+
+/** SSF partition weights over per-task local atom sets
+ *
+ *  Exploits the finite support of the SSF cell function: for the bounding
+ *  box of a task, only atoms which may have a non-zero cell function (with
+ *  respect to the parent atom) and the atoms which may alter their cell
+ *  functions are considered, which is exact. Points are processed in
+ *  blocks, vectorized over the points of the block.
+ */
+class CellListSSFWeights {
+
+  std::vector<std::array<double,3>> centers_;
+  AtomCellList                      cells_;
+
+public:
+
+  CellListSSFWeights( const Molecule& mol );
+
+  /** Partition the weights of a single task (thread safe)
+   *
+   *  @param[in]     mol, meta Molecule this instance was constructed for
+   *  @param[in/out] weights   Unpartitioned weights of task on input,
+   *                           partitioned weights on output (may alias
+   *                           task.weights)
+   */
+  void partition( const Molecule& mol, const MolMeta& meta, const XCTask& task,
+    double* weights ) const;
+
+  /** Contract the weight first derivative of a single task (thread safe)
+   *
+   *  Screened counterpart of reference_ssf_weights_1std_contraction_host:
+   *  the SSF derivative terms vanish outside of the switching region, only
+   *  atoms of the local sets contribute. Contributions are accumulated per
+   *  task, exc_grad_w receives one (atomic) update per local atom.
+   *
+   *  @param[in]     w_times_f  Weight times function evaluation
+   *  @param[in/out] exc_grad_w Contracted weight derivative (3 x natoms)
+   */
+  void contract_1st_derivative( const Molecule& mol, const MolMeta& meta,
+    const XCTask& task, const double* w_times_f, double* exc_grad_w ) const;
+
+private:
+
+  /// Build the local atom set of a task in thread local scratch. Returns
+  /// the size of K (0 if the parent cell function vanishes in the task, -1
+  /// if all points are within the cutoff of the parent).
+  int local_atoms_( const Molecule& mol, const MolMeta& meta,
+    const XCTask& task, void* scr ) const;
+
+};
+
+/// SSF partition weights of a task range (cf. CellListSSFWeights)
+void cell_list_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+/** Becke partition weights, vectorized over blocks of points
+ *
+ *  The Becke cell function has no finite support, all atom pairs are
+ *  considered.
+ */
+void blocked_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+}
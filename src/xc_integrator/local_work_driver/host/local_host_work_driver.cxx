@@ -41,6 +41,23 @@ void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
 
 }
 
+void LocalHostWorkDriver::prepare_partition_weights( XCWeightAlg weight_alg,
+  const Molecule& mol, const MolMeta& meta ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->prepare_partition_weights(weight_alg, mol, meta);
+
+}
+
+void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
+  const Molecule& mol, const MolMeta& meta, const XCTask& task,
+  double* weights ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->partition_weights(weight_alg, mol, meta, task, weights);
+
+}
+
 void LocalHostWorkDriver::eval_weight_1st_deriv_contracted( 
   XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta, 
   const XCTask& task, const double* w_times_f, double* exc_grad_w ) {
@@ -55,10 +72,10 @@ void LocalHostWorkDriver::eval_weight_1st_deriv_contracted(
 // Collocation
 void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t nbe, 
   const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-  double* basis_eval ) {
+  double* basis_eval, host_arena* scr ) {
 
   throw_if_invalid_pimpl(pimpl_);
-  pimpl_->eval_collocation(npts, nshells, nbe, pts, basis, shell_list, basis_eval);
+  pimpl_->eval_collocation(npts, nshells, nbe, pts, basis, shell_list, basis_eval, scr);
 
 }
 
@@ -67,11 +84,11 @@ void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t
 void LocalHostWorkDriver::eval_collocation_gradient( size_t npts, size_t nshells, 
   size_t nbe, const double* pts, const BasisSet<double>& basis, 
   const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
-  double* dbasis_y_eval, double* dbasis_z_eval) {
+  double* dbasis_y_eval, double* dbasis_z_eval, host_arena* scr) {
 
   throw_if_invalid_pimpl(pimpl_);
   pimpl_->eval_collocation_gradient(npts, nshells, nbe, pts, basis, shell_list, basis_eval,
-    dbasis_x_eval, dbasis_y_eval, dbasis_z_eval);
+    dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, scr);
 
 }
 
@@ -82,12 +99,24 @@ void LocalHostWorkDriver::eval_collocation_hessian( size_t npts, size_t nshells,
     const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
     double* dbasis_y_eval, double* dbasis_z_eval, double* d2basis_xx_eval, 
     double* d2basis_xy_eval, double* d2basis_xz_eval, double* d2basis_yy_eval, 
-    double* d2basis_yz_eval, double* d2basis_zz_eval ) {
+    double* d2basis_yz_eval, double* d2basis_zz_eval, host_arena* scr ) {
 
   throw_if_invalid_pimpl(pimpl_);
   pimpl_->eval_collocation_hessian(npts, nshells, nbe, pts, basis, shell_list, basis_eval,
     dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval, d2basis_xy_eval,
-    d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval, d2basis_zz_eval);
+    d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval, d2basis_zz_eval, scr);
+
+}
+
+// Collocation Laplacian
+void LocalHostWorkDriver::eval_collocation_laplacian( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval, host_arena* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_laplacian(npts, nshells, nbe, pts, basis, shell_list, 
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval, scr);
 
 }
 
@@ -100,7 +129,7 @@ void LocalHostWorkDriver::eval_collocation_der3( size_t npts, size_t nshells, si
     double* d2basis_zz_eval, double* d3basis_xxx_eval, double* d3basis_xxy_eval,
     double* d3basis_xxz_eval, double* d3basis_xyy_eval, double* d3basis_xyz_eval,
     double* d3basis_xzz_eval, double* d3basis_yyy_eval, double* d3basis_yyz_eval,
-    double* d3basis_yzz_eval, double* d3basis_zzz_eval) {
+    double* d3basis_yzz_eval, double* d3basis_zzz_eval, host_arena* scr) {
 
    throw_if_invalid_pimpl(pimpl_);
    pimpl_->eval_collocation_der3(npts, nshells, nbe, pts, basis, shell_list, basis_eval,
@@ -108,7 +137,7 @@ void LocalHostWorkDriver::eval_collocation_der3( size_t npts, size_t nshells, si
     d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval, d2basis_zz_eval,
     d3basis_xxx_eval, d3basis_xxy_eval, d3basis_xxz_eval, d3basis_xyy_eval, 
     d3basis_xyz_eval, d3basis_xzz_eval, d3basis_yyy_eval, d3basis_yyz_eval,
-    d3basis_yzz_eval, d3basis_zzz_eval);
+    d3basis_yzz_eval, d3basis_zzz_eval, scr);
        
 }
 
@@ -124,6 +153,16 @@ void LocalHostWorkDriver::eval_xmat( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+void LocalHostWorkDriver::eval_xmat_fp32( size_t npts, size_t nbf, size_t nbe, 
+  const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+  const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_fp32(npts, nbf, nbe, submat_map, fac, P, ldp, basis_eval, ldb,
+    X, ldx, scr);
+
+}
+
 void LocalHostWorkDriver::eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
   size_t nbe_ket, const submat_map_t& submat_map_bra,
   const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -154,11 +193,11 @@ void LocalHostWorkDriver::eval_exx_gmat( size_t npts, size_t nshells,
 void LocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, 
   size_t nbe_ket, const double* basis_eval, const submat_map_t& submat_map_bra, 
   const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
-  size_t ldk, double* scr ) {
+  size_t ldk, double* scr, bool atomic ) {
 
   throw_if_invalid_pimpl(pimpl_);
   pimpl_->inc_exx_k(npts, nbf, nbe_bra, nbe_ket, basis_eval, submat_map_bra,
-    submat_map_ket, G, ldg, K, ldk, scr );
+    submat_map_ket, G, ldg, K, ldk, scr, atomic );
 }
 
 
@@ -405,10 +444,20 @@ void LocalHostWorkDriver::eval_mmat_mgga_vxc_uks( size_t npts, size_t nbe,
 // Increment VXC by Z
 void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
   const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
-  size_t ldz, double* VXC, size_t ldvxc, double* scr ) {
+  size_t ldz, double* VXC, size_t ldvxc, double* scr, bool atomic ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_vxc(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, ldvxc, scr, atomic);
+
+}
+
+void LocalHostWorkDriver::inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe, 
+  const float* basis_eval, const submat_map_t& submat_map, const double* Z, 
+  size_t ldz, double* VXC, size_t ldvxc, float* scr, bool atomic ) {
 
   throw_if_invalid_pimpl(pimpl_);
-  pimpl_->inc_vxc(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, ldvxc, scr);
+  pimpl_->inc_vxc_fp32(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, ldvxc,
+    scr, atomic);
 
 }
 
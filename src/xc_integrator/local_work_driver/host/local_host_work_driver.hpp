@@ -21,6 +21,9 @@
 
 
 namespace GauXC {
+
+class host_arena;
+
 namespace detail {
 
 struct LocalHostWorkDriverPIMPL;
@@ -75,7 +78,37 @@ public:
   void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end );
 
+  /** Prepare the evaluation of single task partition weights
+   *
+   *  Must be called (outside of parallel regions) before the single task
+   *  variant of partition_weights or eval_weight_1st_deriv_contracted is
+   *  used with mol.
+   *
+   *  @param[in] weight_alg Molecular partitioning scheme
+   *  @param[in] mol        Molecule being partitioned
+   *  @param[in] molmeta    Metadata associated with mol
+   */
+  void prepare_partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta );
+
+  /** Evaluate the molecular partition weights of a single task
+   *
+   *  Out-of-place variant of partition_weights for on-the-fly weight
+   *  partitioning, the task is not modified. Thread safe.
+   *
+   *  @param[in] weight_alg Molecular partitioning scheme
+   *  @param[in] mol        Molecule being partitioned
+   *  @param[in] molmeta    Metadata associated with mol
+   *  @param[in] task       Task Data (with unpartitioned weights)
+   *
+   *  @param[out] weights   Partitioned weights of task (length task.points.size())
+   */
+  void partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, const XCTask& task, double* weights );
+
   /** Evaluate the weight first derivative contracted with a function
+   *
+   *  Thread safe, concurrent calls may share exc_grad_w.
    *
    *  @param[in] weight_alg Molecular partitioning scheme
    *  @param[in] mol        Molecule being partitioned
@@ -101,10 +134,13 @@ public:
    *
    *  @param[out] basis_eval Collocation matrix in col major (bfn,pts). 
    *                         Assumed to have leading dimension of nbe.
+   *
+   *  @param[in,out] scr     Arena for intermediate storage, which is returned
+   *                         on exit (optional, allocated per call if null)
    */
   void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-    double* basis_eval );
+    double* basis_eval, host_arena* scr = nullptr );
 
 
   /** Evaluation the collocation matrix + gradient
@@ -115,6 +151,7 @@ public:
    *  @param[in] pts      Same as `eval_collocation`
    *  @param[in] basis    Same as `eval_collocation`
    *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in,out] scr  Same as `eval_collocation`
    *
    *  @param[out] basis_eval    Same as `eval_collocation`
    *  @param[out] dbasis_x_eval Derivative of `basis_eval` wrt x (same dimensions)
@@ -124,7 +161,7 @@ public:
   void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
-    double* dbasis_z_eval);
+    double* dbasis_z_eval, host_arena* scr = nullptr);
 
 
   /** Evaluation the collocation matrix + gradient + hessian
@@ -135,6 +172,7 @@ public:
    *  @param[in] pts      Same as `eval_collocation`
    *  @param[in] basis    Same as `eval_collocation`
    *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in,out] scr  Same as `eval_collocation`
    *
    *  @param[out] basis_eval    Same as `eval_collocation`
    *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
@@ -152,7 +190,31 @@ public:
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
     double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
-    double* d2basis_zz_eval );
+    double* d2basis_zz_eval, host_arena* scr = nullptr );
+
+  /** Evaluation the collocation matrix + gradient + laplacian
+   *
+   *  Cheaper alternative to `eval_collocation_hessian` when only the trace
+   *  of the hessian is required (e.g. laplacian dependent meta-GGAs).
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] nshells  Same as `eval_collocation`
+   *  @param[in] nbe      Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in,out] scr  Same as `eval_collocation`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   *  @param[out] lbasis_eval   Laplacian of `basis_eval` (same dimensions)
+   */
+  void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval, host_arena* scr = nullptr );
 
   /** Evaluation the collocation matrix + gradient + hessian + 3rd derivatives
    *
@@ -162,6 +224,7 @@ public:
    *  @param[in] pts      Same as `eval_collocation`
    *  @param[in] basis    Same as `eval_collocation`
    *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in,out] scr  Same as `eval_collocation`
    *
    *  @param[out] basis_eval    Same as `eval_collocation`
    *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
@@ -192,7 +255,7 @@ public:
     double* d2basis_zz_eval, double* d3basis_xxx_eval, double* d3basis_xxy_eval,
     double* d3basis_xxz_eval, double* d3basis_xyy_eval, double* d3basis_xyz_eval,
     double* d3basis_xzz_eval, double* d3basis_yyy_eval, double* d3basis_yyz_eval,
-    double* d3basis_yzz_eval, double* d3basis_zzz_eval);
+    double* d3basis_yzz_eval, double* d3basis_zzz_eval, host_arena* scr = nullptr);
 
   /** Evaluate the compressed "X" matrix = fac * P * B
    *
@@ -214,6 +277,19 @@ public:
     const double* basis_eval, size_t ldb, double* X, size_t ldx, 
     double* scr );
 
+  /** Evaluate the compressed "X" matrix = fac * P * B in mixed precision
+   *
+   *  The product is formed in FP32 from a rounded copy of the density
+   *  matrix, X is returned in FP64. Arguments as for eval_xmat except
+   *
+   *  @param[in]  basis_eval  FP32 collocation matrix ( (nbe,npts) col major)
+   *  @param[in/out] scr      FP32 scratch space of at least nbe*(nbe+npts)
+   */
+  void eval_xmat_fp32( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, const double* P, size_t ldp,
+    const float* basis_eval, size_t ldb, double* X, size_t ldx, 
+    float* scr );
+
   void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
     const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -230,7 +306,7 @@ public:
   void inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, size_t nbe_ket, 
     const double* basis_eval, const submat_map_t& submat_map_bra, 
     const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
-    size_t ldk, double* scr );
+    size_t ldk, double* scr, bool atomic = true );
     
   /** Evaluate the U and V variavles for RKS LDA
    *
@@ -481,11 +557,25 @@ public:
    *  @param[in/out] VXC     VXC integrand ((nbf,nbf), col major)
    *  @param[in]  ldvxc      Leading dimension of VXC
    *  @param[out] scr        Scratch space at least nbe*nbe
+   *  @param[in]  atomic     Whether VXC is shared between threads (atomic
+   *                         updates) or private to the calling thread
    *
    */
   void inc_vxc( size_t npts, size_t nbf, size_t nbe, const double* basis_eval,
     const submat_map_t& submat_map, const double* Z, size_t ldz, 
-    double* VXC, size_t ldvxc, double* scr );
+    double* VXC, size_t ldvxc, double* scr, bool atomic = true );
+
+  /** Mixed precision VXC increment
+   *
+   *  Z is rounded to FP32 and the rank-2k update is performed in FP32, the
+   *  result is accumulated into the FP64 VXC. Arguments as for inc_vxc except
+   *
+   *  @paran[in]  basis_eval  FP32 collocation matrix ((nbe,npts), col major, ld=nbe)
+   *  @param[out] scr         FP32 scratch space of at least nbe*(nbe+npts)
+   */
+  void inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe, const float* basis_eval,
+    const submat_map_t& submat_map, const double* Z, size_t ldz, 
+    double* VXC, size_t ldvxc, float* scr, bool atomic = true );
 
   /** Evaluate the intermediate vector variables tmat for Fxc contraction of LDA 
    *
@@ -33,23 +33,31 @@ struct LocalHostWorkDriverPIMPL {
 
   virtual void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) = 0;
+  virtual void prepare_partition_weights( XCWeightAlg weight_alg,
+    const Molecule& mol, const MolMeta& meta ) = 0;
+  virtual void partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, const XCTask& task, double* weights ) = 0;
     
   virtual void eval_weight_1st_deriv_contracted( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, const XCTask& task, const double* w_times_f, double* exc_grad_w ) = 0;
 
   virtual void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-    double* basis_eval ) = 0;
+    double* basis_eval, host_arena* scr ) = 0;
   virtual void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
-    double* dbasis_z_eval) = 0;
+    double* dbasis_z_eval, host_arena* scr) = 0;
   virtual void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
     double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
-    double* d2basis_zz_eval ) = 0;
+    double* d2basis_zz_eval, host_arena* scr ) = 0;
+  virtual void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval, host_arena* scr ) = 0;
   virtual void eval_collocation_der3( size_t npts, size_t nshells, size_t nbe,
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
@@ -58,11 +66,14 @@ struct LocalHostWorkDriverPIMPL {
     double* d2basis_zz_eval, double* d3basis_xxx_eval, double* d3basis_xxy_eval,
     double* d3basis_xxz_eval, double* d3basis_xyy_eval, double* d3basis_xyz_eval,
     double* d3basis_xzz_eval, double* d3basis_yyy_eval, double* d3basis_yyz_eval,
-    double* d3basis_yzz_eval, double* d3basis_zzz_eval) = 0;
+    double* d3basis_yzz_eval, double* d3basis_zzz_eval, host_arena* scr) = 0;
 
   virtual void eval_xmat( size_t npts, size_t nbf, size_t nbe, 
     const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
     const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_fp32( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+    const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) = 0;
 
   virtual void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
@@ -80,7 +91,7 @@ struct LocalHostWorkDriverPIMPL {
   virtual void inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, size_t nbe_ket, 
     const double* basis_eval, const submat_map_t& submat_map_bra, 
     const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
-    size_t ldk, double* scr ) = 0;
+    size_t ldk, double* scr, bool atomic ) = 0;
     
   virtual void eval_uvvar_lda_rks( size_t npts, size_t nbe, const double* basis_eval,
     const double* X, size_t ldx, double* den_eval) = 0;
@@ -175,7 +186,10 @@ struct LocalHostWorkDriverPIMPL {
 
   virtual void inc_vxc( size_t npts, size_t nbf, size_t nbe, 
     const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
-    size_t ldz, double* VXC, size_t ldvxc, double* scr ) = 0;
+    size_t ldz, double* VXC, size_t ldvxc, double* scr, bool atomic ) = 0;
+  virtual void inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe, 
+    const float* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* VXC, size_t ldvxc, float* scr, bool atomic ) = 0;
 
   virtual void eval_tmat_lda_vxc_rks( size_t npts, const double* v2rho2, const double* tden_eval, double* A) = 0;
   virtual void eval_tmat_lda_vxc_uks( size_t npts, const double* v2rho2, const double* trho, double* A) = 0;
@@ -0,0 +1,396 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "native_collocation.hpp"
+#include <gauxc/exceptions.hpp>
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace GauXC {
+
+namespace {
+
+/// Number of points evaluated together in a collocation kernel
+constexpr int colloc_block_size = 16;
+
+/// exp(-x) below this argument is neglected (exp(-50) ~ 2e-22)
+constexpr double colloc_max_exponent = 50.;
+
+enum class CollocationMode {
+  Value,     ///< B
+  Gradient,  ///< B, dx, dy, dz
+  Hessian,   ///< B, dx, dy, dz, xx, xy, xz, yy, yz, zz
+  Laplacian  ///< B, dx, dy, dz, lapl
+};
+
+template <CollocationMode Mode>
+constexpr int collocation_ncomp() {
+  return Mode == CollocationMode::Value     ?  1 :
+         Mode == CollocationMode::Gradient  ?  4 :
+         Mode == CollocationMode::Hessian   ? 10 : 5;
+}
+
+constexpr int cart_size( int l ) { return (l+1)*(l+2)/2; }
+constexpr int pure_size( int l ) { return 2*l+1;         }
+
+/// Cartesian exponents of a shell in CCA order
+template <int L>
+struct CartesianExponents {
+  int x[cart_size(L)] = {};
+  int y[cart_size(L)] = {};
+  int z[cart_size(L)] = {};
+
+  constexpr CartesianExponents() {
+    int k = 0;
+    for( int i = L; i >= 0; --i )
+    for( int j = L-i; j >= 0; --j, ++k ) {
+      x[k] = i; y[k] = j; z[k] = L - i - j;
+    }
+  }
+};
+
+double factorial( int n ) {
+  double f = 1.;
+  for( int i = 2; i <= n; ++i ) f *= i;
+  return f;
+}
+
+double binomial( int n, int k ) {
+  if( k < 0 or k > n ) return 0.;
+  return factorial(n) / factorial(k) / factorial(n-k);
+}
+
+/** Cartesian -> real solid harmonic transformation (pure_size x cart_size)
+ *
+ *  Unit normalized real solid harmonics (Helgaker, Jorgensen, Olsen
+ *  Eq. 6.4.47) ordered m = -l,...,l, matching the CCA spherical ordering
+ *  of gau2grid.
+ */
+template <int L>
+const std::array<double, pure_size(L)*cart_size(L)>& cart_to_sph_table() {
+
+  static const auto table = [] {
+    constexpr CartesianExponents<L> exps;
+    std::array<double, pure_size(L)*cart_size(L)> T{};
+
+    auto cart_index = [&]( int lx, int ly ) {
+      for( int k = 0; k < cart_size(L); ++k )
+        if( exps.x[k] == lx and exps.y[k] == ly ) return k;
+      return -1;
+    };
+
+    for( int m = -L; m <= L; ++m ) {
+      const int  am  = std::abs(m);
+      const bool neg = m < 0;
+      const double N = std::sqrt( 2. * factorial(L+am) * factorial(L-am) /
+        (m == 0 ? 2. : 1.) ) / ( std::pow(2., am) * factorial(L) );
+
+      auto* row = T.data() + (m+L) * cart_size(L);
+      for( int t = 0; t <= (L-am)/2; ++t )
+      for( int u = 0; u <= t;        ++u )
+      for( int v2 = neg; v2 <= am;   v2 += 2 ) {
+        const double sign = ((t + (v2-neg)/2) % 2) ? -1. : 1.;
+        const double C = sign * std::pow(0.25, t) * binomial(L,t) *
+          binomial(L-t, am+t) * binomial(t,u) * binomial(am,v2);
+        const int lx = 2*t + am - 2*u - v2;
+        const int ly = 2*u + v2;
+        row[ cart_index(lx,ly) ] += N * C;
+      }
+    }
+
+    return T;
+  }();
+
+  return table;
+
+}
+
+/** Evaluate a single shell (and derivatives) over all points
+ *
+ *  Values are computed for a block of points at a time in a (comp, fn, pt)
+ *  buffer, vectorized over the points, and stored into the (nbe, npts)
+ *  output beginning at row "ioff".
+ */
+template <int L, bool Pure, CollocationMode Mode>
+void collocation_shell( size_t npts, const double* points, const Shell<double>& sh,
+  size_t nbe, size_t ioff, double* const* eval ) {
+
+  constexpr int  B     = colloc_block_size;
+  constexpr int  ncomp = collocation_ncomp<Mode>();
+  constexpr int  ncart = cart_size(L);
+  constexpr int  nfunc = Pure ? pure_size(L) : ncart;
+  constexpr bool need_d1 = Mode != CollocationMode::Value;
+  constexpr bool need_d2 = Mode == CollocationMode::Hessian or
+                           Mode == CollocationMode::Laplacian;
+
+  constexpr CartesianExponents<L> exps;
+  const double* T = Pure ? cart_to_sph_table<L>().data() : nullptr;
+
+  const int     nprim = sh.nprim();
+  const double* alpha = sh.alpha_data();
+  const double* coeff = sh.coeff_data();
+  const double  Ox = sh.O_data()[0], Oy = sh.O_data()[1], Oz = sh.O_data()[2];
+  const double  rcut2 = sh.cutoff_radius() * sh.cutoff_radius();
+
+  alignas(64) double dx[B], dy[B], dz[B], r2[B];
+  alignas(64) double R0[B], R1[B], R2[B];
+  alignas(64) double xp[L+1][B], yp[L+1][B], zp[L+1][B];
+  alignas(64) double val[ncomp][nfunc][B];
+
+  for( size_t ipt = 0; ipt < npts; ipt += B ) {
+
+    const int np = std::min<size_t>( B, npts - ipt );
+    const double* pts = points + 3*ipt;
+
+    double r2_min = std::numeric_limits<double>::infinity();
+    for( int p = 0; p < B; ++p ) {
+      const int pp = p < np ? p : 0; // Pad the block with the first point
+      dx[p] = pts[3*pp + 0] - Ox;
+      dy[p] = pts[3*pp + 1] - Oy;
+      dz[p] = pts[3*pp + 2] - Oz;
+      r2[p] = dx[p]*dx[p] + dy[p]*dy[p] + dz[p]*dz[p];
+      r2_min = std::min( r2_min, r2[p] );
+    }
+
+    // Whole block is beyond the shell cutoff
+    if( r2_min > rcut2 ) {
+      for( int c = 0; c < ncomp; ++c )
+      for( int p = 0; p < np;    ++p ) {
+        std::fill_n( eval[c] + (ipt+p)*nbe + ioff, nfunc, 0. );
+      }
+      continue;
+    }
+
+    // Radial part, only the primitives (and points) which contribute
+    for( int p = 0; p < B; ++p ) { R0[p] = 0.; R1[p] = 0.; R2[p] = 0.; }
+    for( int i = 0; i < nprim; ++i ) {
+      const double a = alpha[i];
+      if( a * r2_min >= colloc_max_exponent ) continue;
+      const double c  = coeff[i];
+      const double c1 = -2. * a * c;
+      const double c2 =  4. * a * a * c;
+      for( int p = 0; p < B; ++p ) {
+        const double ar2 = a * r2[p];
+        const double e =
+          (ar2 < colloc_max_exponent and r2[p] <= rcut2) ? std::exp(-ar2) : 0.;
+        R0[p] += c * e;
+        if constexpr (need_d1) R1[p] += c1 * e;
+        if constexpr (need_d2) R2[p] += c2 * e;
+      }
+    }
+
+    // Cartesian powers
+    for( int p = 0; p < B; ++p ) { xp[0][p] = 1.; yp[0][p] = 1.; zp[0][p] = 1.; }
+    for( int l = 1; l <= L; ++l )
+    for( int p = 0; p < B; ++p ) {
+      xp[l][p] = xp[l-1][p] * dx[p];
+      yp[l][p] = yp[l-1][p] * dy[p];
+      zp[l][p] = zp[l-1][p] * dz[p];
+    }
+
+    if constexpr (Pure) {
+      for( int c = 0; c < ncomp; ++c )
+      for( int f = 0; f < nfunc; ++f )
+      for( int p = 0; p < B;     ++p ) val[c][f][p] = 0.;
+    }
+
+    for( int k = 0; k < ncart; ++k ) {
+
+      const int lx = exps.x[k], ly = exps.y[k], lz = exps.z[k];
+      const double* xk = xp[lx]; const double* xk1 = xp[lx ? lx-1 : 0];
+      const double* yk = yp[ly]; const double* yk1 = yp[ly ? ly-1 : 0];
+      const double* zk = zp[lz]; const double* zk1 = zp[lz ? lz-1 : 0];
+      const double* xk2 = xp[lx > 1 ? lx-2 : 0];
+      const double* yk2 = yp[ly > 1 ? ly-2 : 0];
+      const double* zk2 = zp[lz > 1 ? lz-2 : 0];
+
+      alignas(64) double cv[ncomp][B];
+      for( int p = 0; p < B; ++p ) {
+
+        const double M = xk[p] * yk[p] * zk[p];
+        cv[0][p] = R0[p] * M;
+
+        if constexpr (need_d1) {
+          const double Mx = lx * xk1[p] * yk[p]  * zk[p];
+          const double My = ly * xk[p]  * yk1[p] * zk[p];
+          const double Mz = lz * xk[p]  * yk[p]  * zk1[p];
+          cv[1][p] = R1[p] * dx[p] * M + R0[p] * Mx;
+          cv[2][p] = R1[p] * dy[p] * M + R0[p] * My;
+          cv[3][p] = R1[p] * dz[p] * M + R0[p] * Mz;
+
+          if constexpr (need_d2) {
+            const double Mxx = lx*(lx-1) * xk2[p] * yk[p]  * zk[p];
+            const double Myy = ly*(ly-1) * xk[p]  * yk2[p] * zk[p];
+            const double Mzz = lz*(lz-1) * xk[p]  * yk[p]  * zk2[p];
+
+            if constexpr (Mode == CollocationMode::Hessian) {
+              const double Mxy = lx*ly * xk1[p] * yk1[p] * zk[p];
+              const double Mxz = lx*lz * xk1[p] * yk[p]  * zk1[p];
+              const double Myz = ly*lz * xk[p]  * yk1[p] * zk1[p];
+              cv[4][p] = R2[p]*dx[p]*dx[p]*M + R1[p]*(M + 2.*dx[p]*Mx) + R0[p]*Mxx;
+              cv[5][p] = R2[p]*dx[p]*dy[p]*M + R1[p]*(dx[p]*My + dy[p]*Mx) + R0[p]*Mxy;
+              cv[6][p] = R2[p]*dx[p]*dz[p]*M + R1[p]*(dx[p]*Mz + dz[p]*Mx) + R0[p]*Mxz;
+              cv[7][p] = R2[p]*dy[p]*dy[p]*M + R1[p]*(M + 2.*dy[p]*My) + R0[p]*Myy;
+              cv[8][p] = R2[p]*dy[p]*dz[p]*M + R1[p]*(dy[p]*Mz + dz[p]*My) + R0[p]*Myz;
+              cv[9][p] = R2[p]*dz[p]*dz[p]*M + R1[p]*(M + 2.*dz[p]*Mz) + R0[p]*Mzz;
+            } else {
+              // x.grad(M) = L * M for a homogeneous polynomial of degree L
+              cv[4][p] = (R2[p]*r2[p] + (3 + 2*L)*R1[p]) * M +
+                         R0[p] * (Mxx + Myy + Mzz);
+            }
+          }
+        }
+
+      }
+
+      if constexpr (Pure) {
+        for( int f = 0; f < nfunc; ++f ) {
+          const double t = T[f*ncart + k];
+          if( t == 0. ) continue;
+          for( int c = 0; c < ncomp; ++c )
+          for( int p = 0; p < B;     ++p ) val[c][f][p] += t * cv[c][p];
+        }
+      } else {
+        for( int c = 0; c < ncomp; ++c )
+        for( int p = 0; p < B;     ++p ) val[c][k][p] = cv[c][p];
+      }
+
+    }
+
+    // Store into the (nbe, npts) output
+    for( int c = 0; c < ncomp; ++c )
+    for( int p = 0; p < np;    ++p ) {
+      auto* out = eval[c] + (ipt+p)*nbe + ioff;
+      for( int f = 0; f < nfunc; ++f ) out[f] = val[c][f][p];
+    }
+
+  }
+
+}
+
+template <CollocationMode Mode>
+void collocation_dispatch( size_t npts, size_t nshells, size_t nbe,
+  const double* points, const BasisSet<double>& basis, const int32_t* shell_mask,
+  double* const* eval ) {
+
+  size_t ioff = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+
+    const auto& sh = basis.at(shell_mask[i]);
+
+    #define COLLOCATION_SHELL_CASE(L)                                       \
+      case L:                                                              \
+        if( sh.pure() )                                                    \
+          collocation_shell<L,true,Mode>(npts, points, sh, nbe, ioff, eval);  \
+        else                                                               \
+          collocation_shell<L,false,Mode>(npts, points, sh, nbe, ioff, eval); \
+        break;
+
+    switch( sh.l() ) {
+      COLLOCATION_SHELL_CASE(0)
+      COLLOCATION_SHELL_CASE(1)
+      COLLOCATION_SHELL_CASE(2)
+      COLLOCATION_SHELL_CASE(3)
+      COLLOCATION_SHELL_CASE(4)
+      COLLOCATION_SHELL_CASE(5)
+      COLLOCATION_SHELL_CASE(6)
+      default:
+        GAUXC_GENERIC_EXCEPTION("Native Collocation Only Supports L <= 6");
+    }
+
+    #undef COLLOCATION_SHELL_CASE
+
+    ioff += sh.size();
+
+  }
+
+}
+
+}
+
+void native_collocation( size_t                  npts,
+                         size_t                  nshells,
+                         size_t                  nbe,
+                         const double*           points,
+                         const BasisSet<double>& basis,
+                         const int32_t*          shell_mask,
+                         double*                 basis_eval ) {
+
+  double* eval[] = { basis_eval };
+  collocation_dispatch<CollocationMode::Value>( npts, nshells, nbe, points,
+    basis, shell_mask, eval );
+
+}
+
+void native_collocation_gradient( size_t                  npts,
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points,
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  double*                 basis_eval,
+                                  double*                 dbasis_x_eval,
+                                  double*                 dbasis_y_eval,
+                                  double*                 dbasis_z_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval };
+  collocation_dispatch<CollocationMode::Gradient>( npts, nshells, nbe, points,
+    basis, shell_mask, eval );
+
+}
+
+void native_collocation_hessian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 d2basis_xx_eval,
+                                 double*                 d2basis_xy_eval,
+                                 double*                 d2basis_xz_eval,
+                                 double*                 d2basis_yy_eval,
+                                 double*                 d2basis_yz_eval,
+                                 double*                 d2basis_zz_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    d2basis_xx_eval, d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval,
+    d2basis_yz_eval, d2basis_zz_eval };
+  collocation_dispatch<CollocationMode::Hessian>( npts, nshells, nbe, points,
+    basis, shell_mask, eval );
+
+}
+
+void native_collocation_laplacian( size_t                  npts,
+                                   size_t                  nshells,
+                                   size_t                  nbe,
+                                   const double*           points,
+                                   const BasisSet<double>& basis,
+                                   const int32_t*          shell_mask,
+                                   double*                 basis_eval,
+                                   double*                 dbasis_x_eval,
+                                   double*                 dbasis_y_eval,
+                                   double*                 dbasis_z_eval,
+                                   double*                 lbasis_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    lbasis_eval };
+  collocation_dispatch<CollocationMode::Laplacian>( npts, nshells, nbe, points,
+    basis, shell_mask, eval );
+
+}
+
+}
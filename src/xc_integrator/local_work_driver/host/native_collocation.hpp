@@ -0,0 +1,79 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+
+namespace GauXC {
+
+/** Native host collocation
+ *
+ *  Same interface and (nbe, npts) output layout as the gau2grid_collocation
+ *  family (reference/collocation.hpp), with the same CCA ordering and
+ *  spherical normalization. Kernels are specialized at compile time on the
+ *  angular momentum (up to L = 6), spherical / cartesian and derivative
+ *  order, vectorized over blocks of points and written directly into the
+ *  output without a staging transpose.
+ *
+ *  Points beyond the cutoff radius of a shell evaluate to zero and blocks
+ *  of such points are not evaluated at all. The exponential of a primitive
+ *  is only evaluated where it is non-negligible.
+ */
+void native_collocation( size_t                  npts,
+                         size_t                  nshells,
+                         size_t                  nbe,
+                         const double*           points,
+                         const BasisSet<double>& basis,
+                         const int32_t*          shell_mask,
+                         double*                 basis_eval );
+
+void native_collocation_gradient( size_t                  npts,
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points,
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  double*                 basis_eval,
+                                  double*                 dbasis_x_eval,
+                                  double*                 dbasis_y_eval,
+                                  double*                 dbasis_z_eval );
+
+void native_collocation_hessian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 d2basis_xx_eval,
+                                 double*                 d2basis_xy_eval,
+                                 double*                 d2basis_xz_eval,
+                                 double*                 d2basis_yy_eval,
+                                 double*                 d2basis_yz_eval,
+                                 double*                 d2basis_zz_eval );
+
+void native_collocation_laplacian( size_t                  npts,
+                                   size_t                  nshells,
+                                   size_t                  nbe,
+                                   const double*           points,
+                                   const BasisSet<double>& basis,
+                                   const int32_t*          shell_mask,
+                                   double*                 basis_eval,
+                                   double*                 dbasis_x_eval,
+                                   double*                 dbasis_y_eval,
+                                   double*                 dbasis_z_eval,
+                                   double*                 lbasis_eval );
+
+}
@@ -0,0 +1,439 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/optimized_local_host_work_driver.hpp"
+#include "host/blas.hpp"
+#include "host/util.hpp"
+#include "host/native_collocation.hpp"
+#include <gauxc/exceptions.hpp>
+
+namespace GauXC {
+
+OptimizedLocalHostWorkDriver::OptimizedLocalHostWorkDriver() = default;
+OptimizedLocalHostWorkDriver::~OptimizedLocalHostWorkDriver() noexcept = default;
+
+
+
+// Partition weights
+void OptimizedLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
+  const Molecule& mol, const MolMeta& meta, task_iterator task_begin,
+  task_iterator task_end ) {
+  switch( weight_alg ) {
+    case XCWeightAlg::Becke:
+      blocked_becke_weights_host( mol, meta, task_begin, task_end );
+      break;
+    case XCWeightAlg::SSF:
+      cell_list_ssf_weights_host( mol, meta, task_begin, task_end );
+      break;
+    default:
+      ReferenceLocalHostWorkDriver::partition_weights( weight_alg, mol, meta,
+        task_begin, task_end );
+  }
+}
+
+void OptimizedLocalHostWorkDriver::prepare_partition_weights(
+  XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta ) {
+  ReferenceLocalHostWorkDriver::prepare_partition_weights( weight_alg, mol, meta );
+  if( weight_alg == XCWeightAlg::SSF ) {
+    ssf_weights_     = std::make_unique<CellListSSFWeights>( mol );
+    ssf_weights_mol_ = &mol;
+  }
+}
+
+void OptimizedLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
+  const Molecule& mol, const MolMeta& meta, const XCTask& task,
+  double* weights ) {
+  switch( weight_alg ) {
+    case XCWeightAlg::SSF:
+      std::copy( task.weights.begin(), task.weights.end(), weights );
+      if( ssf_weights_ and ssf_weights_mol_ == &mol )
+        ssf_weights_->partition( mol, meta, task, weights );
+      else // Not prepared
+        CellListSSFWeights( mol ).partition( mol, meta, task, weights );
+      break;
+    default:
+      ReferenceLocalHostWorkDriver::partition_weights( weight_alg, mol, meta,
+        task, weights );
+  }
+}
+
+void OptimizedLocalHostWorkDriver::eval_weight_1st_deriv_contracted(
+  XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta,
+  const XCTask& task, const double* w_times_f, double* exc_grad_w ) {
+  switch( weight_alg ) {
+    case XCWeightAlg::SSF:
+      if( ssf_weights_ and ssf_weights_mol_ == &mol )
+        ssf_weights_->contract_1st_derivative( mol, meta, task, w_times_f,
+          exc_grad_w );
+      else // Not prepared
+        CellListSSFWeights( mol ).contract_1st_derivative( mol, meta, task,
+          w_times_f, exc_grad_w );
+      break;
+    default:
+      ReferenceLocalHostWorkDriver::eval_weight_1st_deriv_contracted(
+        weight_alg, mol, meta, task, w_times_f, exc_grad_w );
+  }
+}
+
+
+
+// Collocation
+void OptimizedLocalHostWorkDriver::eval_collocation( size_t npts,
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis,
+  const int32_t* shell_list, double* basis_eval, host_arena* ) {
+  native_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+}
+
+void OptimizedLocalHostWorkDriver::eval_collocation_gradient( size_t npts,
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis,
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval,
+  double* dbasis_y_eval, double* dbasis_z_eval, host_arena* ) {
+  native_collocation_gradient( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+}
+
+void OptimizedLocalHostWorkDriver::eval_collocation_hessian( size_t npts,
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis,
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval,
+  double* dbasis_y_eval, double* dbasis_z_eval, double* d2basis_xx_eval,
+  double* d2basis_xy_eval, double* d2basis_xz_eval, double* d2basis_yy_eval,
+  double* d2basis_yz_eval, double* d2basis_zz_eval, host_arena* ) {
+  native_collocation_hessian( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
+    d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
+    d2basis_zz_eval );
+}
+
+void OptimizedLocalHostWorkDriver::eval_collocation_laplacian( size_t npts,
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis,
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval,
+  double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval, host_arena* ) {
+  native_collocation_laplacian( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval );
+}
+
+
+
+// U/VVar LDA (density)
+void OptimizedLocalHostWorkDriver::eval_uvvar_lda_rks( size_t npts, size_t nbe,
+  const double* basis_eval, const double* X, size_t ldx, double* den_eval) {
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto* b_i = basis_eval + i*ldx;
+    const auto* X_i = X          + i*ldx;
+    double rho = 0.;
+    #pragma omp simd reduction(+:rho)
+    for( size_t mu = 0; mu < nbe; ++mu ) rho += b_i[mu] * X_i[mu];
+    den_eval[i] = rho;
+  }
+
+}
+
+void OptimizedLocalHostWorkDriver::eval_uvvar_lda_uks( size_t npts, size_t nbe,
+  const double* basis_eval, const double* Xs, size_t ldxs, const double* Xz,
+  size_t ldxz, double* den_eval) {
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto* bs_i = basis_eval + i*ldxs;
+    const auto* bz_i = basis_eval + i*ldxz;
+    const auto* Xs_i = Xs + i*ldxs;
+    const auto* Xz_i = Xz + i*ldxz;
+    double rhos = 0., rhoz = 0.;
+    if( ldxs == ldxz ) {
+      #pragma omp simd reduction(+:rhos,rhoz)
+      for( size_t mu = 0; mu < nbe; ++mu ) {
+        rhos += bs_i[mu] * Xs_i[mu];
+        rhoz += bs_i[mu] * Xz_i[mu];
+      }
+    } else {
+      #pragma omp simd reduction(+:rhos,rhoz)
+      for( size_t mu = 0; mu < nbe; ++mu ) {
+        rhos += bs_i[mu] * Xs_i[mu];
+        rhoz += bz_i[mu] * Xz_i[mu];
+      }
+    }
+
+    den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
+    den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
+  }
+
+}
+
+
+
+
+// U/VVar GGA (density + gradient)
+void OptimizedLocalHostWorkDriver::eval_uvvar_gga_rks( size_t npts, size_t nbe,
+  const double* basis_eval, const double* dbasis_x_eval,
+  const double *dbasis_y_eval, const double* dbasis_z_eval, const double* X,
+  size_t ldx, double* den_eval, double* dden_x_eval, double* dden_y_eval,
+  double* dden_z_eval, double* gamma ) {
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const size_t ioff = i * ldx;
+    const auto* b_i  = basis_eval    + ioff;
+    const auto* bx_i = dbasis_x_eval + ioff;
+    const auto* by_i = dbasis_y_eval + ioff;
+    const auto* bz_i = dbasis_z_eval + ioff;
+    const auto* X_i  = X             + ioff;
+
+    double rho = 0., dx = 0., dy = 0., dz = 0.;
+    #pragma omp simd reduction(+:rho,dx,dy,dz)
+    for( size_t mu = 0; mu < nbe; ++mu ) {
+      const auto x = X_i[mu];
+      rho += b_i[mu]  * x;
+      dx  += bx_i[mu] * x;
+      dy  += by_i[mu] * x;
+      dz  += bz_i[mu] * x;
+    }
+
+    dx *= 2.; dy *= 2.; dz *= 2.;
+
+    den_eval[i]    = rho;
+    dden_x_eval[i] = dx;
+    dden_y_eval[i] = dy;
+    dden_z_eval[i] = dz;
+    gamma[i]       = dx*dx + dy*dy + dz*dz;
+  }
+
+}
+
+void OptimizedLocalHostWorkDriver::eval_uvvar_gga_uks( size_t npts, size_t nbe,
+  const double* basis_eval, const double* dbasis_x_eval,
+  const double *dbasis_y_eval, const double* dbasis_z_eval, const double* Xs,
+  size_t ldxs, const double* Xz, size_t ldxz, double* den_eval,
+  double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, double* gamma ) {
+
+  // Single pass requires a common layout, defer to the reference otherwise
+  if( ldxs != ldxz ) {
+    ReferenceLocalHostWorkDriver::eval_uvvar_gga_uks( npts, nbe, basis_eval,
+      dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, Xs, ldxs, Xz, ldxz, den_eval,
+      dden_x_eval, dden_y_eval, dden_z_eval, gamma );
+    return;
+  }
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const size_t ioff = i * ldxs;
+    const auto* b_i  = basis_eval    + ioff;
+    const auto* bx_i = dbasis_x_eval + ioff;
+    const auto* by_i = dbasis_y_eval + ioff;
+    const auto* bz_i = dbasis_z_eval + ioff;
+    const auto* Xs_i = Xs            + ioff;
+    const auto* Xz_i = Xz            + ioff;
+
+    double rhos = 0., rhoz = 0.;
+    double dndx = 0., dndy = 0., dndz = 0.;
+    double dMzdx = 0., dMzdy = 0., dMzdz = 0.;
+    #pragma omp simd reduction(+:rhos,rhoz,dndx,dndy,dndz,dMzdx,dMzdy,dMzdz)
+    for( size_t mu = 0; mu < nbe; ++mu ) {
+      const auto xs = Xs_i[mu];
+      const auto xz = Xz_i[mu];
+      const auto b  = b_i[mu];
+      const auto bx = bx_i[mu];
+      const auto by = by_i[mu];
+      const auto bz = bz_i[mu];
+      rhos  += b  * xs; rhoz  += b  * xz;
+      dndx  += bx * xs; dMzdx += bx * xz;
+      dndy  += by * xs; dMzdy += by * xz;
+      dndz  += bz * xs; dMzdz += bz * xz;
+    }
+
+    dndx  *= 2.; dndy  *= 2.; dndz  *= 2.;
+    dMzdx *= 2.; dMzdy *= 2.; dMzdz *= 2.;
+
+    den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
+    den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
+
+    dden_x_eval[2*i] = dndx; dden_x_eval[2*i+1] = dMzdx;
+    dden_y_eval[2*i] = dndy; dden_y_eval[2*i+1] = dMzdy;
+    dden_z_eval[2*i] = dndz; dden_z_eval[2*i+1] = dMzdz;
+
+    const auto dn_sq  = dndx*dndx + dndy*dndy + dndz*dndz;
+    const auto dMz_sq = dMzdx*dMzdx + dMzdy*dMzdy + dMzdz*dMzdz;
+    const auto dn_dMz = dndx*dMzdx + dndy*dMzdy + dndz*dMzdz;
+
+    gamma[3*i  ] = 0.25*(dn_sq + dMz_sq) + 0.5*dn_dMz;
+    gamma[3*i+1] = 0.25*(dn_sq - dMz_sq);
+    gamma[3*i+2] = 0.25*(dn_sq + dMz_sq) - 0.5*dn_dMz;
+  }
+
+}
+
+
+
+
+// Eval Z Matrix LDA VXC
+void OptimizedLocalHostWorkDriver::eval_zmat_lda_vxc_rks( size_t npts, size_t nbe,
+  const double* vrho, const double* basis_eval, double* Z, size_t ldz ) {
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto* b_i  = basis_eval + i*nbe;
+    auto*       z_i  = Z          + i*ldz;
+    const double fact = 0.5 * vrho[i];
+    #pragma omp simd
+    for( size_t mu = 0; mu < nbe; ++mu ) z_i[mu] = fact * b_i[mu];
+  }
+
+}
+
+void OptimizedLocalHostWorkDriver::eval_zmat_lda_vxc_uks( size_t npts, size_t nbe,
+  const double* vrho, const double* basis_eval, double* Zs, size_t ldzs,
+  double* Zz, size_t ldzz ) {
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto* b_i  = basis_eval + i*nbe;
+    auto*       zs_i = Zs         + i*ldzs;
+    auto*       zz_i = Zz         + i*ldzz;
+
+    const double factp = 0.5 * vrho[2*i];
+    const double factm = 0.5 * vrho[2*i+1];
+    const double facts = 0.5 * (factp + factm);
+    const double factz = 0.5 * (factp - factm);
+
+    #pragma omp simd
+    for( size_t mu = 0; mu < nbe; ++mu ) {
+      zs_i[mu] = facts * b_i[mu];
+      zz_i[mu] = factz * b_i[mu];
+    }
+  }
+
+}
+
+
+
+
+// Eval Z Matrix GGA VXC
+void OptimizedLocalHostWorkDriver::eval_zmat_gga_vxc_rks( size_t npts, size_t nbe,
+  const double* vrho, const double* vgamma, const double* basis_eval,
+  const double* dbasis_x_eval, const double* dbasis_y_eval,
+  const double* dbasis_z_eval, const double* dden_x_eval,
+  const double* dden_y_eval, const double* dden_z_eval, double* Z, size_t ldz ) {
+
+  if( ldz != nbe ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const size_t ioff = i * nbe;
+    const auto* b_i  = basis_eval    + ioff;
+    const auto* bx_i = dbasis_x_eval + ioff;
+    const auto* by_i = dbasis_y_eval + ioff;
+    const auto* bz_i = dbasis_z_eval + ioff;
+    auto*       z_i  = Z             + ioff;
+
+    const auto lda_fact = 0.5 * vrho[i];
+    const auto gga_fact = 2. * vgamma[i];
+    const auto x_fact = gga_fact * dden_x_eval[i];
+    const auto y_fact = gga_fact * dden_y_eval[i];
+    const auto z_fact = gga_fact * dden_z_eval[i];
+
+    #pragma omp simd
+    for( size_t mu = 0; mu < nbe; ++mu )
+      z_i[mu] = lda_fact * b_i[mu] + x_fact * bx_i[mu] + y_fact * by_i[mu] +
+                z_fact * bz_i[mu];
+  }
+
+}
+
+void OptimizedLocalHostWorkDriver::eval_zmat_gga_vxc_uks( size_t npts, size_t nbe,
+  const double* vrho, const double* vgamma, const double* basis_eval,
+  const double* dbasis_x_eval, const double* dbasis_y_eval,
+  const double* dbasis_z_eval, const double* dden_x_eval,
+  const double* dden_y_eval, const double* dden_z_eval, double* Zs,
+  size_t ldzs, double* Zz, size_t ldzz ) {
+
+  if( ldzs != nbe ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
+  if( ldzz != nbe ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
+
+  for( size_t i = 0; i < npts; ++i ) {
+    const size_t ioff = i * nbe;
+    const auto* b_i  = basis_eval    + ioff;
+    const auto* bx_i = dbasis_x_eval + ioff;
+    const auto* by_i = dbasis_y_eval + ioff;
+    const auto* bz_i = dbasis_z_eval + ioff;
+    auto*       zs_i = Zs            + ioff;
+    auto*       zz_i = Zz            + ioff;
+
+    const double factp = 0.5 * vrho[2*i];
+    const double factm = 0.5 * vrho[2*i+1];
+    const double facts = 0.5 * (factp + factm);
+    const double factz = 0.5 * (factp - factm);
+
+    const auto gga_fact_pp = vgamma[3*i];
+    const auto gga_fact_pm = vgamma[3*i+1];
+    const auto gga_fact_mm = vgamma[3*i+2];
+
+    const auto gga_fact_1 = 0.5*(gga_fact_pp + gga_fact_pm + gga_fact_mm);
+    const auto gga_fact_2 = 0.5*(gga_fact_pp - gga_fact_mm);
+    const auto gga_fact_3 = 0.5*(gga_fact_pp - gga_fact_pm + gga_fact_mm);
+
+    const auto x_fact_s = gga_fact_1 * dden_x_eval[2*i] + gga_fact_2 * dden_x_eval[2*i+1];
+    const auto y_fact_s = gga_fact_1 * dden_y_eval[2*i] + gga_fact_2 * dden_y_eval[2*i+1];
+    const auto z_fact_s = gga_fact_1 * dden_z_eval[2*i] + gga_fact_2 * dden_z_eval[2*i+1];
+
+    const auto x_fact_z = gga_fact_3 * dden_x_eval[2*i+1] + gga_fact_2 * dden_x_eval[2*i];
+    const auto y_fact_z = gga_fact_3 * dden_y_eval[2*i+1] + gga_fact_2 * dden_y_eval[2*i];
+    const auto z_fact_z = gga_fact_3 * dden_z_eval[2*i+1] + gga_fact_2 * dden_z_eval[2*i];
+
+    #pragma omp simd
+    for( size_t mu = 0; mu < nbe; ++mu ) {
+      const auto b  = b_i[mu];
+      const auto bx = bx_i[mu];
+      const auto by = by_i[mu];
+      const auto bz = bz_i[mu];
+      zs_i[mu] = facts * b + x_fact_s * bx + y_fact_s * by + z_fact_s * bz;
+      zz_i[mu] = factz * b + x_fact_z * bx + y_fact_z * by + z_fact_z * bz;
+    }
+  }
+
+}
+
+
+
+
+// Increment VXC by Z (LT only)
+void OptimizedLocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe,
+  const double* basis_eval, const submat_map_t& submat_map, const double* Z,
+  size_t ldz, double* VXC, size_t ldvxc, double* scr, bool atomic ) {
+
+  (void)(nbf);
+  blas::syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
+
+  if( atomic )
+    detail::inc_by_submat_lower<true>( VXC, ldvxc, scr, nbe, submat_map );
+  else
+    detail::inc_by_submat_lower<false>( VXC, ldvxc, scr, nbe, submat_map );
+
+}
+
+// Mixed precision increment of VXC by Z (LT only)
+void OptimizedLocalHostWorkDriver::inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe,
+  const float* basis_eval, const submat_map_t& submat_map, const double* Z,
+  size_t ldz, double* VXC, size_t ldvxc, float* scr, bool atomic ) {
+
+  (void)(nbf);
+  float* V_sp = scr;
+  float* Z_sp = scr + nbe * nbe;
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto* Z_i    = Z    + i*ldz;
+    auto*       Z_sp_i = Z_sp + i*nbe;
+    #pragma omp simd
+    for( size_t mu = 0; mu < nbe; ++mu ) Z_sp_i[mu] = Z_i[mu];
+  }
+
+  blas::syr2k('L', 'N', nbe, npts, 1.f, basis_eval, nbe, Z_sp, nbe, 0.f, V_sp, nbe );
+
+  if( atomic )
+    detail::inc_by_submat_lower<true>( VXC, ldvxc, V_sp, nbe, submat_map );
+  else
+    detail::inc_by_submat_lower<false>( VXC, ldvxc, V_sp, nbe, submat_map );
+
+}
+
+}
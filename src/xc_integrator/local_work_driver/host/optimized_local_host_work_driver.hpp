@@ -0,0 +1,114 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "reference_local_host_work_driver.hpp"
+#include "host/cell_list_weights.hpp"
+
+namespace GauXC {
+
+/** Production host LWD ("HOST-OPT")
+ *
+ *  Shares the sn-K kernels and third collocation derivatives with the
+ *  reference driver. Collocation (through the Hessian / Laplacian) is
+ *  evaluated by the native kernels (native_collocation.hpp). Replaces the
+ *  per-point BLAS-1 chains of the LDA/GGA U/V-variable and Z-matrix
+ *  kernels with single-pass, SIMD-vectorized loops. inc_vxc only scatters
+ *  the lower triangle of the syr2k result. SSF / Becke weights and SSF
+ *  weight derivatives are evaluated over per-task local atom sets
+ *  (cell_list_weights.hpp).
+ */
+struct OptimizedLocalHostWorkDriver : public ReferenceLocalHostWorkDriver {
+
+  /// SSF cell list of the molecule of the last prepare_partition_weights
+  std::unique_ptr<CellListSSFWeights> ssf_weights_;
+  const Molecule*                     ssf_weights_mol_ = nullptr;
+
+  using submat_map_t = ReferenceLocalHostWorkDriver::submat_map_t;
+
+  OptimizedLocalHostWorkDriver();
+
+  virtual ~OptimizedLocalHostWorkDriver() noexcept;
+
+  OptimizedLocalHostWorkDriver( const OptimizedLocalHostWorkDriver& )     = delete;
+  OptimizedLocalHostWorkDriver( OptimizedLocalHostWorkDriver&& ) noexcept = delete;
+
+  void partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) override;
+  void prepare_partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta ) override;
+  void partition_weights( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, const XCTask& task, double* weights ) override;
+  void eval_weight_1st_deriv_contracted( XCWeightAlg weight_alg,
+    const Molecule& mol, const MolMeta& meta, const XCTask& task,
+    const double* w_times_f, double* exc_grad_w ) override;
+
+  void eval_collocation( size_t npts, size_t nshells, size_t nbe,
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    double* basis_eval, host_arena* scr ) override;
+  void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe,
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval,
+    double* dbasis_z_eval, host_arena* scr ) override;
+  void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe,
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval,
+    double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
+    double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
+    double* d2basis_zz_eval, host_arena* scr ) override;
+  void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe,
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval,
+    double* dbasis_z_eval, double* lbasis_eval, host_arena* scr ) override;
+
+  void eval_uvvar_lda_rks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* X, size_t ldx, double* den_eval) override;
+  void eval_uvvar_lda_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* Xs, size_t ldxs, const double* Xz, size_t ldxz,
+    double* den_eval) override;
+
+  void eval_uvvar_gga_rks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* dbasis_x_eval, const double *dbasis_y_eval,
+    const double* dbasis_z_eval, const double* X, size_t ldx, double* den_eval,
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, double* gamma ) override;
+  void eval_uvvar_gga_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* dbasis_x_eval, const double *dbasis_y_eval,
+    const double* dbasis_z_eval, const double* Xs, size_t ldxs,
+    const double* Xz, size_t ldxz, double* den_eval,
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, double* gamma ) override;
+
+  void eval_zmat_lda_vxc_rks( size_t npts, size_t nbe, const double* vrho,
+    const double* basis_eval, double* Z, size_t ldz ) override;
+  void eval_zmat_lda_vxc_uks( size_t npts, size_t nbe, const double* vrho,
+    const double* basis_eval, double* Zs, size_t ldzs, double* Zz,
+    size_t ldzz ) override;
+
+  void eval_zmat_gga_vxc_rks( size_t npts, size_t nbe, const double* vrho,
+    const double* vgamma, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval,
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    double* Z, size_t ldz ) override;
+  void eval_zmat_gga_vxc_uks( size_t npts, size_t nbe, const double* vrho,
+    const double* vgamma, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval,
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    double* Zs, size_t ldzs, double* Zz, size_t ldzz ) override;
+
+  void inc_vxc( size_t npts, size_t nbf, size_t nbe,
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z,
+    size_t ldz, double* VXC, size_t ldvxc, double* scr, bool atomic ) override;
+  void inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe,
+    const float* basis_eval, const submat_map_t& submat_map, const double* Z,
+    size_t ldz, double* VXC, size_t ldvxc, float* scr, bool atomic ) override;
+
+};
+
+}
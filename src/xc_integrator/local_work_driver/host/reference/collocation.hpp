@@ -15,13 +15,16 @@
 
 namespace GauXC {
 
+class host_arena;
+
 void gau2grid_collocation( size_t                  npts, 
                            size_t                  nshells,
                            size_t                  nbe,
                            const double*           points, 
                            const BasisSet<double>& basis,
                            const int32_t*          shell_mask,
-                           double*                 basis_eval );
+                           double*                 basis_eval,
+                           host_arena*             scr = nullptr );
 
 void gau2grid_collocation_gradient( size_t                  npts, 
                                     size_t                  nshells,
@@ -32,7 +35,8 @@ void gau2grid_collocation_gradient( size_t                  npts,
                                     double*                 basis_eval, 
                                     double*                 dbasis_x_eval, 
                                     double*                 dbasis_y_eval,
-                                    double*                 dbasis_z_eval );
+                                    double*                 dbasis_z_eval,
+                                    host_arena*             scr = nullptr );
 
 
 void gau2grid_collocation_hessian( size_t                  npts, 
@@ -50,7 +54,21 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_xz_eval,
                                    double*                 d2basis_yy_eval,
                                    double*                 d2basis_yz_eval,
-                                   double*                 d2basis_zz_eval);
+                                   double*                 d2basis_zz_eval,
+                                   host_arena*             scr = nullptr);
+
+void gau2grid_collocation_laplacian( size_t                  npts, 
+                                     size_t                  nshells,
+                                     size_t                  nbe,
+                                     const double*           points, 
+                                     const BasisSet<double>& basis,
+                                     const int32_t*          shell_mask,
+                                     double*                 basis_eval, 
+                                     double*                 dbasis_x_eval, 
+                                     double*                 dbasis_y_eval,
+                                     double*                 dbasis_z_eval, 
+                                     double*                 lbasis_eval,
+                                     host_arena*             scr = nullptr );
 
 void gau2grid_collocation_der3(    size_t                  npts,
                                    size_t                  nshells,
@@ -77,6 +95,7 @@ void gau2grid_collocation_der3(    size_t                  npts,
 				   double*                 d3basis_yyy_eval,
 				   double*                 d3basis_yyz_eval,
 				   double*                 d3basis_yzz_eval,
-				   double*                 d3basis_zzz_eval);
+				   double*                 d3basis_zzz_eval,
+				   host_arena*             scr = nullptr);
 
     }
@@ -10,30 +10,62 @@
  * See LICENSE.txt for details
  */
 #include "collocation.hpp"
+#include "xc_data/host_arena.hpp"
+#include <algorithm>
 
 
 #ifdef GAUXC_HAS_GAU2GRID
   #include "gau2grid/gau2grid.h"
 #else
-  #include "collocation/collocation_angular_cartesian.hpp"
-  #include "collocation/collocation_angular_spherical_unnorm.hpp"
-  #include "collocation/collocation_radial.hpp"
+  #include "host/native_collocation.hpp"
 #endif
 
 namespace GauXC {
 
+#ifdef GAUXC_HAS_GAU2GRID
+namespace {
+
+/// Staging buffer for the (npts,nbe) gau2grid output. Drawn from the
+/// caller's scratch arena and returned on destruction, or allocated for the
+/// duration of the call if no arena is given.
+class collocation_staging {
+
+  host_arena  local_;
+  host_arena* arena_;
+  double*     ptr_;
+  size_t      len_;
+
+public:
+
+  collocation_staging( host_arena* arena, size_t len ) :
+    arena_( arena ? arena : &local_ ), len_(len) {
+    ptr_ = arena_->aligned_alloc<double>( len_ );
+  }
+
+  ~collocation_staging() noexcept { arena_->deallocate( ptr_, len_ ); }
+
+  collocation_staging( const collocation_staging& ) = delete;
+
+  inline double* data() { return ptr_; }
+
+};
+
+}
+#endif
+
 void gau2grid_collocation( size_t                  npts, 
                            size_t                  nshells,
                            size_t                  nbe,
                            const double*           points, 
                            const BasisSet<double>& basis,
                            const int32_t*          shell_mask,
-                           double*                 basis_eval ) {
+                           double*                 basis_eval,
+                           host_arena*             scr ) {
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( npts * nbe );
+  collocation_staging staging( scr, npts * nbe );
+  auto* rv = staging.data();
 
   size_t ncomp = 0;
   for( size_t i = 0; i < nshells; ++i ) {
@@ -48,29 +80,11 @@ void gau2grid_collocation( size_t                  npts,
   }
 
   gg_fast_transpose( ncomp, npts, rv, basis_eval );
-  a.deallocate( rv, npts*nbe );
 
 #else
-  
-  for( size_t ipt = 0; ipt < npts;  ++ipt )
-  for( size_t i = 0;   i < nshells; ++i   ) {
-    
-    const auto ish = shell_mask[i];
-    const auto& sh = basis.at(ish);
-    auto* eval = basis_eval + ipt*nbe + basis.shell_to_first_ao( ish );
-
-    double x,y,z, bf;
-    integrator::cuda::collocation_device_radial_eval( sh, points + 3*ipt, 
-                                                      &x, &y, &z, &bf );
-
-    if( sh.pure() )
-      integrator::cuda::collocation_spherical_unnorm_angular( sh.l(), bf, x, y, z,
-                                                              eval );
-    else
-      integrator::cuda::collocation_cartesian_angular( sh.l(), bf, x, y, z, eval );
-                                                              
-                                                              
-  }
+
+  native_collocation( npts, nshells, nbe, points, basis, shell_mask,
+    basis_eval );
 
 #endif
 
@@ -85,12 +99,13 @@ void gau2grid_collocation_gradient( size_t                  npts,
                                     double*                 basis_eval, 
                                     double*                 dbasis_x_eval, 
                                     double*                 dbasis_y_eval,
-                                    double*                 dbasis_z_eval ) {
+                                    double*                 dbasis_z_eval,
+                                    host_arena*             scr ) {
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 4 * npts * nbe );
+  collocation_staging staging( scr, 4 * npts * nbe );
+  auto* rv = staging.data();
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -113,33 +128,11 @@ void gau2grid_collocation_gradient( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
   gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
 
-  a.deallocate( rv, 4*npts*nbe );
 
 #else 
 
-  for( size_t ipt = 0; ipt < npts;  ++ipt )
-  for( size_t i = 0;   i < nshells; ++i   ) {
-    
-    const auto ish = shell_mask[i];
-    const auto& sh = basis.at(ish);
-    auto* eval = basis_eval + ipt*nbe + basis.shell_to_first_ao( ish );
-    auto* deval_x = dbasis_x_eval + ipt*nbe + basis.shell_to_first_ao( ish );
-    auto* deval_y = dbasis_y_eval + ipt*nbe + basis.shell_to_first_ao( ish );
-    auto* deval_z = dbasis_z_eval + ipt*nbe + basis.shell_to_first_ao( ish );
-
-    double x,y,z, bf, dbf_x, dbf_y, dbf_z;
-    integrator::cuda::collocation_device_radial_eval_deriv1( sh, points + 3*ipt, 
-                                                      &x, &y, &z, &bf, &dbf_x,
-                                                      &dbf_y, &dbf_z);
-
-    if( sh.pure() )
-      integrator::cuda::collocation_spherical_unnorm_angular_deriv1( 
-        sh.l(), bf, dbf_x, dbf_y, dbf_z, x, y, z, eval, deval_x, deval_y, deval_z );
-    else
-      integrator::cuda::collocation_cartesian_angular_deriv1( 
-        sh.l(), bf, dbf_x, dbf_y, dbf_z, x, y, z, eval, deval_x, deval_y, deval_z );
-                                                              
-  }
+  native_collocation_gradient( npts, nshells, nbe, points, basis, shell_mask,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
 
 #endif
 }
@@ -161,10 +154,11 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_xz_eval,
                                    double*                 d2basis_yy_eval,
                                    double*                 d2basis_yz_eval,
-                                   double*                 d2basis_zz_eval) {
+                                   double*                 d2basis_zz_eval,
+                                   host_arena*             scr) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 10 * npts * nbe );
+  collocation_staging staging( scr, 10 * npts * nbe );
+  auto* rv = staging.data();
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -202,11 +196,68 @@ void gau2grid_collocation_hessian( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yz, d2basis_yz_eval );
   gg_fast_transpose( ncomp, npts, rv_zz, d2basis_zz_eval );
 
-  a.deallocate( rv, 10*npts*nbe );
 
 }
 
 
+void gau2grid_collocation_laplacian( size_t                  npts, 
+                                     size_t                  nshells,
+                                     size_t                  nbe,
+                                     const double*           points, 
+                                     const BasisSet<double>& basis,
+                                     const int32_t*          shell_mask,
+                                     double*                 basis_eval, 
+                                     double*                 dbasis_x_eval, 
+                                     double*                 dbasis_y_eval,
+                                     double*                 dbasis_z_eval, 
+                                     double*                 lbasis_eval,
+                                     host_arena*             scr ) {
+
+  // The hessian is only staged for a single shell at a time
+  size_t max_sh_sz = 0;
+  for( size_t i = 0; i < nshells; ++i )
+    max_sh_sz = std::max( max_sh_sz, size_t(basis.at(shell_mask[i]).size()) );
+
+  collocation_staging staging( scr, 5 * npts * nbe + 6 * npts * max_sh_sz );
+  auto* rv = staging.data();
+  auto* rv_x = rv   + npts * nbe;
+  auto* rv_y = rv_x + npts * nbe;
+  auto* rv_z = rv_y + npts * nbe;
+  auto* rv_l = rv_z + npts * nbe;
+  auto* sh_xx = rv_l  + npts * nbe;
+  auto* sh_xy = sh_xx + npts * max_sh_sz;
+  auto* sh_xz = sh_xy + npts * max_sh_sz;
+  auto* sh_yy = sh_xz + npts * max_sh_sz;
+  auto* sh_yz = sh_yy + npts * max_sh_sz;
+  auto* sh_zz = sh_yz + npts * max_sh_sz;
+
+  size_t ncomp = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+
+    const auto& sh = basis.at(shell_mask[i]);
+    int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
+
+    const auto ioff = ncomp*npts;
+    gg_collocation_deriv2( sh.l(), npts, points, 3, sh.nprim(), sh.coeff_data(),
+      sh.alpha_data(), sh.O_data(), order, rv + ioff, rv_x + ioff, rv_y + ioff, 
+      rv_z + ioff, sh_xx, sh_xy, sh_xz, sh_yy, sh_yz, sh_zz );
+
+    const size_t sh_len = sh.size() * npts;
+    for( size_t j = 0; j < sh_len; ++j )
+      rv_l[ioff + j] = sh_xx[j] + sh_yy[j] + sh_zz[j];
+
+    ncomp += sh.size();
+
+  }
+
+  gg_fast_transpose( ncomp, npts, rv,   basis_eval );
+  gg_fast_transpose( ncomp, npts, rv_x, dbasis_x_eval );
+  gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
+  gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
+  gg_fast_transpose( ncomp, npts, rv_l, lbasis_eval );
+
+}
+
 void gau2grid_collocation_der3(    size_t                  npts, 
                                    size_t                  nshells,
                                    size_t                  nbe,
@@ -232,10 +283,11 @@ void gau2grid_collocation_der3(    size_t                  npts,
                                    double*                 d3basis_yyy_eval,
                                    double*                 d3basis_yyz_eval,
                                    double*                 d3basis_yzz_eval,
-                                   double*                 d3basis_zzz_eval) {
+                                   double*                 d3basis_zzz_eval,
+                                   host_arena*             scr) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 20 * npts * nbe );
+  collocation_staging staging( scr, 20 * npts * nbe );
+  auto* rv = staging.data();
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -296,7 +348,6 @@ void gau2grid_collocation_der3(    size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yzz, d3basis_yzz_eval );
   gg_fast_transpose( ncomp, npts, rv_zzz, d3basis_zzz_eval );
 
-  a.deallocate( rv, 20*npts*nbe );
 
 }
 
@@ -56,6 +56,26 @@ namespace GauXC {
     }
   }
 
+  void ReferenceLocalHostWorkDriver::prepare_partition_weights( XCWeightAlg,
+    const Molecule&, const MolMeta& ) { }
+
+  void ReferenceLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
+    const Molecule& mol, const MolMeta& meta, const XCTask& task,
+    double* weights ) {
+
+    // The reference kernels partition tasks in place, operate on a thread
+    // local copy of the task
+    static thread_local task_container scr( 1 );
+    auto& t = scr.front();
+    t.iParent      = task.iParent;
+    t.dist_nearest = task.dist_nearest;
+    t.points .assign( task.points.begin(),  task.points.end()  );
+    t.weights.assign( task.weights.begin(), task.weights.end() );
+    partition_weights( weight_alg, mol, meta, scr.begin(), scr.end() );
+    std::copy( t.weights.begin(), t.weights.end(), weights );
+
+  }
+
   void ReferenceLocalHostWorkDriver::eval_weight_1st_deriv_contracted( 
     XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta, 
     const XCTask& task, const double* w_times_f, double* exc_grad_w ) {
@@ -75,8 +95,8 @@ namespace GauXC {
   // Collocation
   void ReferenceLocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, 
 						       size_t nbe, const double* pts, const BasisSet<double>& basis, 
-						       const int32_t* shell_list, double* basis_eval ) {
-    gau2grid_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+						       const int32_t* shell_list, double* basis_eval, host_arena* scr ) {
+    gau2grid_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval, scr );
   }
 
 
@@ -84,9 +104,9 @@ namespace GauXC {
   void ReferenceLocalHostWorkDriver::eval_collocation_gradient( size_t npts, 
 								size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
 								const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
-								double* dbasis_y_eval, double* dbasis_z_eval) {
+								double* dbasis_y_eval, double* dbasis_z_eval, host_arena* scr) {
     gau2grid_collocation_gradient(npts, nshells, nbe, pts, basis, shell_list,
-				  basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+				  basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, scr );
   }
 
   void ReferenceLocalHostWorkDriver::eval_collocation_hessian( size_t npts, 
@@ -94,11 +114,19 @@ namespace GauXC {
 							       const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
 							       double* dbasis_y_eval, double* dbasis_z_eval, double* d2basis_xx_eval, 
 							       double* d2basis_xy_eval, double* d2basis_xz_eval, double* d2basis_yy_eval, 
-							       double* d2basis_yz_eval, double* d2basis_zz_eval ) {
+							       double* d2basis_yz_eval, double* d2basis_zz_eval, host_arena* scr ) {
     gau2grid_collocation_hessian(npts, nshells, nbe, pts, basis, shell_list,
 				 basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
 				 d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-				 d2basis_zz_eval);
+				 d2basis_zz_eval, scr);
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_collocation_laplacian( size_t npts, 
+							       size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+							       const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+							       double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval, host_arena* scr ) {
+    gau2grid_collocation_laplacian(npts, nshells, nbe, pts, basis, shell_list,
+				   basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval, scr);
   }
 
   void ReferenceLocalHostWorkDriver::eval_collocation_der3( size_t npts,
@@ -109,13 +137,13 @@ namespace GauXC {
 							     double* d2basis_yz_eval, double* d2basis_zz_eval, double* d3basis_xxx_eval,
 							     double* d3basis_xxy_eval, double* d3basis_xxz_eval, double* d3basis_xyy_eval,
 							     double* d3basis_xyz_eval, double* d3basis_xzz_eval, double* d3basis_yyy_eval,
-							     double* d3basis_yyz_eval, double* d3basis_yzz_eval, double* d3basis_zzz_eval) {
+							     double* d3basis_yyz_eval, double* d3basis_yzz_eval, double* d3basis_zzz_eval, host_arena* scr) {
     gau2grid_collocation_der3(npts, nshells, nbe, pts, basis, shell_list,
 				 basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
 				 d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
 				 d2basis_zz_eval, d3basis_xxx_eval, d3basis_xxy_eval, d3basis_xxz_eval,
 				 d3basis_xyy_eval, d3basis_xyz_eval, d3basis_xzz_eval, d3basis_yyy_eval,
-				 d3basis_yyz_eval, d3basis_yzz_eval, d3basis_zzz_eval);
+				 d3basis_yyz_eval, d3basis_yzz_eval, d3basis_zzz_eval, scr);
   }
 
 
@@ -139,6 +167,33 @@ namespace GauXC {
 
   }
 
+  void ReferenceLocalHostWorkDriver::eval_xmat_fp32( size_t npts, size_t nbf, size_t nbe, 
+						const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+						const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) {
+    (void)(nbf);
+
+    float* P_sp = scr;
+    float* X_sp = scr + nbe * nbe;
+
+    // Gather and round the (compressed) density matrix
+    for( auto& jCut : submat_map )
+    for( int32_t j = 0; j < jCut[1]; ++j ) {
+      const auto* P_j    = P + (jCut[0] + j) * ldp;
+      auto*       P_sp_j = P_sp + (jCut[2] + j) * nbe;
+      for( auto& iCut : submat_map )
+      for( int32_t i = 0; i < iCut[1]; ++i )
+        P_sp_j[iCut[2] + i] = P_j[iCut[0] + i];
+    }
+
+    blas::gemm( 'N', 'N', nbe, npts, nbe, float(fac), P_sp, nbe, basis_eval, ldb, 
+		0.f, X_sp, nbe );
+
+    for( size_t ipt = 0; ipt < npts; ++ipt )
+    for( size_t i = 0; i < nbe; ++i )
+      X[i + ipt*ldx] = X_sp[i + ipt*nbe];
+
+  }
+
 
   // U/VVar LDA (density)
   void ReferenceLocalHostWorkDriver::eval_uvvar_lda_rks( size_t npts, size_t nbe, 
@@ -1585,11 +1640,36 @@ void ReferenceLocalHostWorkDriver::eval_mmat_mgga_vxc_uks_ts(size_t npts, size_t
   // Increment VXC by Z
   void ReferenceLocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
 					      const double* basis_eval, const submat_map_t& submat_map, const double* Z,
-					      size_t ldz, double* VXC, size_t ldvxc, double* scr ) {
+					      size_t ldz, double* VXC, size_t ldvxc, double* scr, bool atomic ) {
 
       blas::syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
 
-      detail::inc_by_submat_atomic( nbf, nbf, nbe, nbe, VXC, ldvxc, scr, nbe, submat_map );
+      // Only the lower triangle of scr is referenced
+      if( atomic )
+        detail::inc_by_submat_lower<true>( VXC, ldvxc, scr, nbe, submat_map );
+      else
+        detail::inc_by_submat_lower<false>( VXC, ldvxc, scr, nbe, submat_map );
+
+  }
+
+  void ReferenceLocalHostWorkDriver::inc_vxc_fp32( size_t npts, size_t nbf, size_t nbe, 
+					      const float* basis_eval, const submat_map_t& submat_map, const double* Z,
+					      size_t ldz, double* VXC, size_t ldvxc, float* scr, bool atomic ) {
+
+      float* V_sp = scr;
+      float* Z_sp = scr + nbe * nbe;
+      for( size_t ipt = 0; ipt < npts; ++ipt )
+      for( size_t i = 0; i < nbe; ++i )
+        Z_sp[i + ipt*nbe] = Z[i + ipt*ldz];
+
+      blas::syr2k('L', 'N', nbe, npts, 1.f, basis_eval, nbe, Z_sp, nbe, 0.f, V_sp, nbe );
+
+      // FP32 block, FP64 accumulation (syr2k only forms the lower triangle)
+      (void)(nbf);
+      if( atomic )
+        detail::inc_by_submat_lower<true>( VXC, ldvxc, V_sp, nbe, submat_map );
+      else
+        detail::inc_by_submat_lower<false>( VXC, ldvxc, V_sp, nbe, submat_map );
 
   }
 
@@ -1597,13 +1677,18 @@ void ReferenceLocalHostWorkDriver::eval_mmat_mgga_vxc_uks_ts(size_t npts, size_t
   void ReferenceLocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, 
 						size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
 						const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
-						const double* G, size_t ldg, double* K, size_t ldk, double* scr ) {
+						const double* G, size_t ldg, double* K, size_t ldk, double* scr,
+						bool atomic ) {
 
       blas::gemm( 'N', 'T', nbe_bra, nbe_ket, npts, 1., basis_eval, nbe_bra,
 		  G, ldg, 0., scr, nbe_bra );
 
-      detail::inc_by_submat_atomic( nbf, nbf, nbe_bra, nbe_ket, K, ldk, scr, nbe_bra, 
-			     submat_map_bra, submat_map_ket );
+      if( atomic )
+        detail::inc_by_submat_atomic( nbf, nbf, nbe_bra, nbe_ket, K, ldk, scr, nbe_bra, 
+			       submat_map_bra, submat_map_ket );
+      else
+        detail::inc_by_submat( nbf, nbf, nbe_bra, nbe_ket, K, ldk, scr, nbe_bra, 
+			       submat_map_bra, submat_map_ket );
 
   }
 
@@ -190,5 +190,54 @@ void inc_by_submat_atomic(int32_t M, int32_t N, int32_t MSub,
 
 }
 
+/** Increment the lower triangle of ABig by the lower triangle of ASmall
+ *
+ *  Assumes that the (row == col) submatrix map is sorted, i.e. the lower
+ *  triangle of the compressed matrix maps onto the lower triangle of the
+ *  full matrix. Blocks strictly above the diagonal are skipped entirely.
+ */
+template <bool Atomic, typename F>
+void inc_by_submat_lower( double* ABig, size_t LDAB, const F* ASmall,
+  size_t LDAS, const std::vector<std::array<int32_t,3>>& submat_map ) {
+
+  const size_t nblocks = submat_map.size();
+  int32_t j = 0;
+  for( size_t jb = 0; jb < nblocks; ++jb ) {
+    const auto& jCut = submat_map[jb];
+    const int32_t deltaJ = jCut[1];
+
+    int32_t i = j;
+    for( size_t ib = jb; ib < nblocks; ++ib ) {
+      const auto& iCut = submat_map[ib];
+      const int32_t deltaI = iCut[1];
+
+      auto*       ABig_use   = ABig   + iCut[0] + jCut[0] * LDAB;
+      const auto* ASmall_use = ASmall + i       + j       * LDAS;
+      const bool  diag       = ib == jb;
+
+      for( int32_t jj = 0; jj < deltaJ; ++jj ) {
+        auto*       A_col = ABig_use   + jj * LDAB;
+        const auto* a_col = ASmall_use + jj * LDAS;
+        const int32_t ii_st = diag ? jj : 0;
+        if constexpr (Atomic) {
+          for( int32_t ii = ii_st; ii < deltaI; ++ii ) {
+            #ifdef _OPENMP
+            #pragma omp atomic
+            #endif
+            A_col[ii] += a_col[ii];
+          }
+        } else {
+          #pragma omp simd
+          for( int32_t ii = ii_st; ii < deltaI; ++ii ) A_col[ii] += a_col[ii];
+        }
+      }
+
+      i += deltaI;
+    }
+    j += deltaJ;
+  }
+
+}
+
 }
 }
@@ -27,9 +27,10 @@ namespace GauXC::detail {
   template <typename ValueType>
   void IncoreReplicatedXCDeviceIntegrator<ValueType>::
     eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X,
-                   unsigned max_Ylm, value_type* Vddx ) {
+                   unsigned max_Ylm, value_type* Vddx, 
+                   const IntegratorSettingsXC& ks_settings ) {
       GAUXC_GENERIC_EXCEPTION("Device DD-PHIX NYI");
-      util::unused(m,n,X,max_Ylm,Vddx);
+      util::unused(m,n,X,max_Ylm,Vddx,ks_settings);
   }
 
 }
@@ -0,0 +1,225 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/xc_integrator_settings.hpp>
+#include <gauxc/basisset.hpp>
+#include <gauxc/xc_task.hpp>
+#include <vector>
+#include <array>
+#include <numeric>
+#include <algorithm>
+
+namespace GauXC  {
+namespace detail {
+
+/** Cross-call cache of host collocation matrices
+ *
+ *  The grid and basis are fixed over an SCF, so the collocation (and its
+ *  derivatives) of a task is identical for every call. Entries store the
+ *  first `ncomp` contiguous (npts,nbe) components of the collocation buffer
+ *  as laid out by the host drivers (basis, x, y, z, xx, xy, ...), or
+ *  (basis, x, y, z, lapl) for the laplacian collocation (ncomp = 5).
+ *
+ *  Entries are keyed on the LoadBalancer task generation and the task
+ *  index (XCExecutionPlan fixes the task order within a generation), task
+ *  ranges without a generation (0) bypass the cache. A plan (which tasks are
+ *  cached) is built when the cache is first prepared by a planning call:
+ *  tasks are admitted greedily by collocation cost per stored byte (average
+ *  primitive count per basis function) until the byte budget is exhausted.
+ *  Storage is allocated by the thread which first evaluates the task.
+ *
+ *  Non-planning calls and calls which require more components than were
+ *  planned bypass the cache for tasks which cannot be served.
+ */
+template <typename F>
+class HostCollocationCache {
+
+  struct entry_type {
+    int32_t               npts, nbe;
+    bool                  admitted = false;
+    bool                  filled   = false;
+    int32_t               nstored  = 0; ///< Points stored by store_points
+    std::vector<F>        fp64;
+    std::vector<float>    fp32;
+  };
+
+  size_t                  budget_  = 0;
+  CollocationCacheStorage storage_ = CollocationCacheStorage::FP64;
+  size_t                  ncomp_   = 0;
+  size_t                  tasks_generation_ = 0; ///< Of the planned tasks
+
+  std::vector<entry_type>  entries_;
+  std::vector<entry_type*> slots_; ///< Task index -> entry for the current call
+
+  /// Whether the first ncomp components of a planned layout may be served
+  /// (the laplacian and hessian layouts only share basis + gradient)
+  static inline bool nested( size_t ncomp, size_t ncomp_planned ) {
+    if( ncomp > ncomp_planned ) return false;
+    return ncomp <= 4 or (ncomp == 5) == (ncomp_planned == 5);
+  }
+
+  inline size_t elem_size() const {
+    return storage_ == CollocationCacheStorage::FP32 ? sizeof(float) : sizeof(F);
+  }
+
+  template <typename TaskIterator>
+  void plan( size_t tasks_generation, const BasisSet<double>& basis,
+    TaskIterator task_begin, TaskIterator task_end, size_t ncomp ) {
+
+    clear();
+    ncomp_ = ncomp;
+    tasks_generation_ = tasks_generation;
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    entries_.resize( ntasks );
+
+    std::vector<double> density( ntasks );
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      const auto& task = *(task_begin + iT);
+      auto& e = entries_[iT];
+      e.npts    = task.points.size();
+      e.nbe     = task.bfn_screening.nbe;
+
+      double work = 0.;
+      for( auto ish : task.bfn_screening.shell_list )
+        work += basis[ish].nprim() * basis[ish].size();
+      density[iT] = e.nbe ? work / e.nbe : 0.;
+    }
+
+    std::vector<size_t> order( ntasks );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(),
+      [&]( auto a, auto b ){ return density[a] > density[b]; } );
+
+    size_t nbytes_left = budget_;
+    for( auto iT : order ) {
+      auto& e = entries_[iT];
+      const size_t nbytes = ncomp_ * e.npts * e.nbe * elem_size();
+      if( nbytes and nbytes <= nbytes_left ) {
+        e.admitted   = true;
+        nbytes_left -= nbytes;
+      }
+    }
+
+  }
+
+public:
+
+  /// Update the budget / storage mode, invalidating the cache on change
+  void configure( size_t budget, CollocationCacheStorage storage ) {
+    if( budget != budget_ or storage != storage_ ) clear();
+    budget_  = budget;
+    storage_ = storage;
+  }
+
+  /// Release all cached data (e.g. when the grid or basis has changed)
+  void clear() {
+    entries_.clear(); entries_.shrink_to_fit();
+    ncomp_ = 0;
+    tasks_generation_ = 0;
+  }
+
+  /** Bind the tasks of the current call to cache entries
+   *
+   *  Must be called outside of the parallel task loop.
+   *
+   *  @param[in] tasks_generation LoadBalancer task generation of the range
+   *                             (0 bypasses the cache)
+   *  @param[in] ncomp     Number of collocation components required by the call
+   *  @param[in] can_plan  Whether this call may (re)build the cache plan
+   */
+  template <typename TaskIterator>
+  void prepare( size_t tasks_generation, const BasisSet<double>& basis,
+    TaskIterator task_begin, TaskIterator task_end, size_t ncomp, 
+    bool can_plan ) {
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    slots_.assign( ntasks, nullptr );
+    if( not budget_ or not ntasks or not tasks_generation ) return;
+
+    const bool stale = tasks_generation != tasks_generation_ or 
+                       entries_.size() != ntasks;
+    if( can_plan and (stale or not nested( ncomp, ncomp_ )) )
+      plan( tasks_generation, basis, task_begin, task_end, ncomp );
+    else if( stale ) return;
+
+    for( size_t iT = 0; iT < ntasks; ++iT )
+      if( entries_[iT].admitted ) slots_[iT] = &entries_[iT];
+
+  }
+
+  /// Copy `ncomp` cached components of length n into basis_eval if available
+  bool load( size_t iT, size_t ncomp, size_t n, F* basis_eval ) const {
+    const auto* e = slots_[iT];
+    if( not e or not e->filled or not nested( ncomp, ncomp_ ) ) return false;
+    if( storage_ == CollocationCacheStorage::FP32 )
+      std::copy_n( e->fp32.data(), ncomp * n, basis_eval );
+    else
+      std::copy_n( e->fp64.data(), ncomp * n, basis_eval );
+    return true;
+  }
+
+  /// Populate the entry of task iT from a freshly evaluated collocation
+  void store( size_t iT, size_t ncomp, size_t n, const F* basis_eval ) {
+    auto* e = slots_[iT];
+    if( not e or e->filled or not nested( ncomp_, ncomp ) ) return;
+    if( storage_ == CollocationCacheStorage::FP32 )
+      e->fp32.assign( basis_eval, basis_eval + ncomp_ * n );
+    else
+      e->fp64.assign( basis_eval, basis_eval + ncomp_ * n );
+    e->filled = true;
+  }
+
+  /// Copy `ncomp` cached components of the points [ipt, ipt+npts) of task iT
+  /// into basis_eval (as ncomp contiguous (npts,nbe) blocks) if available
+  bool load_points( size_t iT, size_t ncomp, size_t ipt, size_t npts,
+    F* basis_eval ) const {
+    const auto* e = slots_[iT];
+    if( not e or not e->filled or not nested( ncomp, ncomp_ ) ) return false;
+    const size_t n_task = size_t(e->npts) * e->nbe;
+    const size_t n      = npts * e->nbe;
+    for( size_t c = 0; c < ncomp; ++c ) {
+      const size_t off = c * n_task + ipt * e->nbe;
+      if( storage_ == CollocationCacheStorage::FP32 )
+        std::copy_n( e->fp32.data() + off, n, basis_eval + c*n );
+      else
+        std::copy_n( e->fp64.data() + off, n, basis_eval + c*n );
+    }
+    return true;
+  }
+
+  /// Populate the points [ipt, ipt+npts) of the entry of task iT, the entry
+  /// is complete once all points of the task have been stored
+  void store_points( size_t iT, size_t ncomp, size_t ipt, size_t npts,
+    const F* basis_eval ) {
+    auto* e = slots_[iT];
+    if( not e or e->filled or not nested( ncomp_, ncomp ) ) return;
+    const size_t n_task = size_t(e->npts) * e->nbe;
+    const size_t n      = npts * e->nbe;
+    if( storage_ == CollocationCacheStorage::FP32 ) e->fp32.resize( ncomp_ * n_task );
+    else                                            e->fp64.resize( ncomp_ * n_task );
+    for( size_t c = 0; c < ncomp_; ++c ) {
+      const size_t off = c * n_task + ipt * e->nbe;
+      if( storage_ == CollocationCacheStorage::FP32 )
+        std::copy_n( basis_eval + c*n, n, e->fp32.data() + off );
+      else
+        std::copy_n( basis_eval + c*n, n, e->fp64.data() + off );
+    }
+    e->nstored += npts;
+    e->filled   = e->nstored == e->npts;
+  }
+
+};
+
+}
+}
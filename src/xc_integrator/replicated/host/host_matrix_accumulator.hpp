@@ -0,0 +1,179 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/xc_integrator_settings.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GauXC  {
+namespace detail {
+
+/** Accumulation target for a dense (m,n) column-major host integrand
+ *
+ *  In HostAccumulation::Atomic mode, all threads scatter directly into the
+ *  destination matrix (which requires element-wise atomics in the LWD).
+ *
+ *  In HostAccumulation::ThreadPrivate mode, each thread scatters into its own
+ *  private copy (ld = m) which is allocated and zeroed by the owning thread on
+ *  first use, i.e. pages are first-touched on the NUMA domain of that thread
+ *  and threads which receive no work never allocate. `finalize` then sums
+ *  the private copies into the destination through a pairwise tree over
+ *  thread ids which is parallelized over columns. The summation order is
+ *  fixed for a given thread count and set of participating threads.
+ *
+ *  The private copies require up to nthreads * m * n elements. If a memory
+ *  bound is given and would be exceeded, the accumulator falls back to
+ *  HostAccumulation::Atomic.
+ *
+ *  `ptr` / `ld` / `atomic` must be called from within the parallel task
+ *  loop, `finalize` must be called outside of the parallel region.
+ */
+template <typename F>
+class HostMatrixAccumulator {
+
+  bool    thread_private_;
+  int64_t m_, n_;
+  F*      A_;
+  int64_t lda_;
+
+  std::vector< std::vector<F> > local_;
+
+  static inline int max_threads() {
+    #ifdef _OPENMP
+    return omp_get_max_threads();
+    #else
+    return 1;
+    #endif
+  }
+
+  static inline int thread_id() {
+    #ifdef _OPENMP
+    return omp_get_thread_num();
+    #else
+    return 0;
+    #endif
+  }
+
+public:
+
+  /**
+   *  @param[in] max_bytes Upper bound on the memory of all private copies
+   *                       (0 is unbounded)
+   */
+  HostMatrixAccumulator( HostAccumulation mode, int64_t m, int64_t n, F* A,
+    int64_t lda, size_t max_bytes = 0 ) :
+    thread_private_( mode == HostAccumulation::ThreadPrivate and A and
+      (not max_bytes or max_threads() * m * n * sizeof(F) <= max_bytes) ),
+    m_(m), n_(n), A_(A), lda_(lda) {
+
+    if( thread_private_ ) local_.resize( max_threads() );
+
+  }
+
+  /// Pointer to the accumulation target of the calling thread
+  inline F* ptr() {
+    if( not thread_private_ ) return A_;
+    auto& buf = local_[ thread_id() ];
+    if( buf.empty() ) buf.resize( m_ * n_, F(0) );
+    return buf.data();
+  }
+
+  /// Leading dimension of the accumulation target
+  inline int64_t ld() const { return thread_private_ ? m_ : lda_; }
+
+  /// Whether updates to the accumulation target must be atomic
+  inline bool atomic() const { return not thread_private_; }
+
+  /** Reduce private contributions into the destination matrix
+   *
+   *  @param[in] uplo 'L' to only reduce the lower triangle (e.g. VXC prior to
+   *                  symmetrization), otherwise the full matrix is reduced
+   */
+  void finalize( char uplo = 'A' ) {
+
+    if( not thread_private_ ) return;
+
+    std::vector<F*> bufs;
+    for( auto& buf : local_ ) if( buf.size() ) bufs.emplace_back( buf.data() );
+    const int64_t nbuf = bufs.size();
+
+    if( nbuf ) {
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for( int64_t j = 0; j < n_; ++j ) {
+      const int64_t i_st = (uplo == 'L') ? j : 0;
+
+      for( int64_t stride = 1; stride < nbuf; stride *= 2 )
+      for( int64_t t = 0; t + stride < nbuf; t += 2*stride ) {
+        F*       dst = bufs[t]        + j*m_;
+        const F* src = bufs[t+stride] + j*m_;
+        for( int64_t i = i_st; i < m_; ++i ) dst[i] += src[i];
+      }
+
+      const F* col = bufs[0] + j*m_;
+      F*       A_j = A_      + j*lda_;
+      for( int64_t i = i_st; i < m_; ++i ) A_j[i] += col[i];
+    }
+
+    }
+
+    local_.clear();
+    local_.shrink_to_fit();
+
+  }
+
+};
+
+/** Select the OpenMP schedule of `schedule(runtime)` task loops
+ *
+ *  Deterministic accumulation requires a fixed task -> thread assignment
+ *  (static, round-robin over the cost-sorted tasks), otherwise tasks are
+ *  dynamically scheduled. The previous schedule is restored on destruction.
+ */
+class ScopedHostTaskSchedule {
+
+  #ifdef _OPENMP
+  omp_sched_t kind_;
+  int         chunk_;
+  #endif
+
+public:
+
+  ScopedHostTaskSchedule( bool deterministic ) {
+    #ifdef _OPENMP
+    omp_get_schedule( &kind_, &chunk_ );
+    omp_set_schedule( deterministic ? omp_sched_static : omp_sched_dynamic, 1 );
+    #else
+    (void)(deterministic);
+    #endif
+  }
+
+  ~ScopedHostTaskSchedule() noexcept {
+    #ifdef _OPENMP
+    omp_set_schedule( kind_, chunk_ );
+    #endif
+  }
+
+  ScopedHostTaskSchedule( const ScopedHostTaskSchedule& ) = delete;
+
+};
+
+}
+}
@@ -0,0 +1,60 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GauXC  {
+namespace detail {
+
+/// Number of elements of a packed (n,n) lower triangle
+inline size_t packed_lower_size( int64_t n ) { return n * (n+1) / 2; }
+
+/// Offset of column j in a column-major packed (n,n) lower triangle
+inline size_t packed_lower_offset( int64_t n, int64_t j ) {
+  return j * (2*n - j + 1) / 2;
+}
+
+/// Pack the lower triangle of A ((n,n) col major) into AP
+template <typename F>
+void pack_lower( int64_t n, const F* A, int64_t lda, F* AP ) {
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+  #endif
+  for( int64_t j = 0; j < n; ++j ) {
+    F*       AP_j = AP + packed_lower_offset(n, j) - j;
+    const F* A_j  = A  + j*lda;
+    for( int64_t i = j; i < n; ++i ) AP_j[i] = A_j[i];
+  }
+
+}
+
+/// Unpack a packed lower triangle AP into the full symmetric A ((n,n) col major)
+template <typename F>
+void unpack_lower_symmetric( int64_t n, const F* AP, F* A, int64_t lda ) {
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+  #endif
+  for( int64_t j = 0; j < n; ++j ) {
+    const F* AP_j = AP + packed_lower_offset(n, j) - j;
+    F*       A_j  = A  + j*lda;
+    for( int64_t i = j; i < n; ++i ) A_j[i] = AP_j[i];
+    for( int64_t i = 0; i < j; ++i ) A_j[i] = AP[ packed_lower_offset(n, i) + j - i ];
+  }
+
+}
+
+}
+}
@@ -0,0 +1,76 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if __has_include(<unistd.h>)
+  #include <unistd.h>
+#endif
+
+namespace GauXC  {
+namespace detail {
+
+/// Size of the (per core) L2 cache, 1 MiB if it can not be queried
+inline size_t host_l2_cache_bytes() {
+  static const size_t sz = [] {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    const long s = ::sysconf( _SC_LEVEL2_CACHE_SIZE );
+    if( s > 0 ) return size_t(s);
+#endif
+    return size_t(1) << 20;
+  }();
+  return sz;
+}
+
+/** Number of points per sub-batch of a host task
+ *
+ *  Unless given explicitly (requested > 0), the sub-batch is sized such
+ *  that its `ncomp` (npts,nbe) blocks (collocation + Z matrix) fit in the
+ *  L2 cache. Sub-batches are kept large enough for the rank-npts updates
+ *  of the X matrix / VXC to remain compute bound, and are balanced over
+ *  the task.
+ *
+ *  @param[in] npts      Number of points of the task
+ *  @param[in] nbe       Number of basis functions of the task
+ *  @param[in] ncomp     Number of (npts,nbe) blocks per point
+ *  @param[in] elem_size Size of a block element
+ *  @param[in] requested Requested sub-batch size (0 derives it)
+ *
+ *  @returns The sub-batch size (npts if the task is not split)
+ */
+inline int32_t host_point_chunk_size( int32_t npts, int32_t nbe, size_t ncomp,
+  size_t elem_size, size_t requested ) {
+
+  constexpr int32_t min_chunk = 64; ///< Smallest derived sub-batch
+  constexpr int32_t align     = 16; ///< Sub-batch granularity (collocation block)
+
+  if( npts <= 0 or nbe <= 0 ) return std::max( npts, 0 );
+  if( requested ) return std::min<int64_t>( requested, npts );
+
+  const size_t bytes_per_pt = ncomp * nbe * elem_size;
+  int32_t chunk = std::max<int64_t>( host_l2_cache_bytes() / bytes_per_pt,
+    min_chunk );
+  if( chunk >= npts ) return npts;
+
+  // Balance the sub-batches
+  const int32_t nchunk = (npts + chunk - 1) / chunk;
+  chunk = (npts + nchunk - 1) / nchunk;
+  chunk = ((chunk + align - 1) / align) * align;
+  return std::min( chunk, npts );
+
+}
+
+}
+}
@@ -0,0 +1,56 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+namespace GauXC  {
+namespace detail {
+
+/** In-place compaction of point-major task data
+ *
+ *  Host task buffers store `ncomp` contiguous (m,npts) blocks (e.g. the
+ *  collocation and its gradient with m = nbe, or the interleaved spin
+ *  densities with m = 2). Moves the columns of the kept points to the front
+ *  of each block, such that the buffer holds `ncomp` contiguous
+ *  (m,nkeep) blocks on exit.
+ *
+ *  @param[in]     m      Leading dimension (number of values per point)
+ *  @param[in]     npts   Number of points on entry
+ *  @param[in]     ncomp  Number of contiguous blocks
+ *  @param[in]     nkeep  Number of kept points
+ *  @param[in]     kept   Increasing indices of the kept points
+ *  @param[in/out] A      Buffer of size >= ncomp * m * npts
+ */
+template <typename F>
+void compact_point_blocks( size_t m, size_t npts, size_t ncomp,
+  size_t nkeep, const int32_t* kept, F* A ) {
+
+  if( nkeep == npts ) return;
+
+  // Destinations never lie past their sources, a forward copy is safe
+  for( size_t c = 0; c < ncomp; ++c ) {
+    const F* A_c = A + c * m * npts;
+    F*       B_c = A + c * m * nkeep;
+    for( size_t k = 0; k < nkeep; ++k ) {
+      const F* src = A_c + kept[k] * m;
+      F*       dst = B_c + k * m;
+      if( src != dst ) std::copy( src, src + m, dst );
+    }
+  }
+
+}
+
+}
+}
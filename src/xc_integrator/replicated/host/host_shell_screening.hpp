@@ -0,0 +1,151 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset_map.hpp>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace GauXC  {
+namespace detail {
+
+/** Shell-block max norms of a (nbf,nbf) column-major matrix
+ *
+ *  Returns a (nshells,nshells) matrix N with N(i,j) = max |A_{mu nu}| over
+ *  mu in shell i and nu in shell j. If N is non-empty on entry, the
+ *  elementwise maximum with the existing entries is taken (e.g. to combine
+ *  the spin components of a density).
+ */
+template <typename F>
+void shell_block_max_abs( const BasisSetMap& basis_map, const F* A, int64_t lda,
+  std::vector<F>& N ) {
+
+  const int32_t nsh = basis_map.shell_sizes().size();
+  if( N.size() != size_t(nsh) * nsh ) N.assign( size_t(nsh) * nsh, F(0) );
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic)
+  #endif
+  for( int32_t jsh = 0; jsh < nsh; ++jsh ) {
+    const auto [j_st, j_en] = basis_map.shell_to_ao_range(jsh);
+    for( int32_t ish = 0; ish < nsh; ++ish ) {
+      const auto [i_st, i_en] = basis_map.shell_to_ao_range(ish);
+      F nrm = N[ish + jsh*nsh];
+      for( int32_t j = j_st; j < j_en; ++j )
+      for( int32_t i = i_st; i < i_en; ++i )
+        nrm = std::max( nrm, std::abs(A[i + j*lda]) );
+      N[ish + jsh*nsh] = nrm;
+    }
+  }
+
+}
+
+/** Local (per task) shell layout of a (nbe,npts) collocation-like matrix
+ *
+ *  Provides per-shell row reductions and the row compaction used to drop
+ *  negligible shells from a task. A layout may be reassigned to another task
+ *  without heap allocations once its capacity suffices.
+ */
+class TaskShellLayout {
+
+  std::vector<int32_t> offsets_; ///< Local row offset of each shell (nshells+1)
+  std::vector<int32_t> ao_st_;   ///< First basis function of each shell
+
+public:
+
+  TaskShellLayout() = default;
+  TaskShellLayout( const BasisSetMap& basis_map,
+    const std::vector<int32_t>& shell_list ) {
+    assign( basis_map, shell_list );
+  }
+
+  inline void assign( const BasisSetMap& basis_map,
+    const std::vector<int32_t>& shell_list ) {
+    offsets_.resize( shell_list.size() + 1 );
+    ao_st_  .resize( shell_list.size() );
+    offsets_[0] = 0;
+    for( size_t i = 0; i < shell_list.size(); ++i ) {
+      offsets_[i+1] = offsets_[i] + basis_map.shell_size(shell_list[i]);
+      ao_st_[i]     = basis_map.shell_to_ao_range(shell_list[i]).first;
+    }
+  }
+
+  inline size_t nshells() const { return offsets_.size() - 1; }
+  inline int32_t nbe() const { return offsets_.back(); }
+
+  /// m[s] = max( m[s], max |A(mu,p)| over mu in shell s and all points p )
+  template <typename F>
+  void row_max( size_t npts, const F* A, size_t lda, F* m ) const {
+    for( size_t p = 0; p < npts; ++p )
+    for( size_t s = 0; s < nshells(); ++s ) {
+      const F* A_p = A + p*lda;
+      for( int32_t mu = offsets_[s]; mu < offsets_[s+1]; ++mu )
+        m[s] = std::max( m[s], std::abs(A_p[mu]) );
+    }
+  }
+
+  /// m[s] += sum_p max |A(mu,p)| over mu in shell s
+  template <typename F>
+  void row_sum_max( size_t npts, const F* A, size_t lda, F* m ) const {
+    for( size_t p = 0; p < npts; ++p )
+    for( size_t s = 0; s < nshells(); ++s ) {
+      const F* A_p = A + p*lda;
+      F mx = 0.;
+      for( int32_t mu = offsets_[s]; mu < offsets_[s+1]; ++mu )
+        mx = std::max( mx, std::abs(A_p[mu]) );
+      m[s] += mx;
+    }
+  }
+
+  /// Copy the rows of the kept shells of A (nbe,npts) into B (nbe_kept,npts)
+  template <typename F>
+  void compact_rows( const int32_t* keep, size_t npts, const F* A,
+    size_t lda, F* B, size_t ldb ) const {
+    for( size_t p = 0; p < npts; ++p ) {
+      const F* A_p = A + p*lda;
+      F*       B_p = B + p*ldb;
+      for( size_t s = 0; s < nshells(); ++s ) if( keep[s] ) {
+        B_p = std::copy( A_p + offsets_[s], A_p + offsets_[s+1], B_p );
+      }
+    }
+  }
+
+  /// Number of kept basis functions
+  inline int32_t nbe( const int32_t* keep ) const {
+    int32_t n = 0;
+    for( size_t s = 0; s < nshells(); ++s )
+      if( keep[s] ) n += offsets_[s+1] - offsets_[s];
+    return n;
+  }
+
+  /// Compressed submatrix map (same format as gen_compressed_submat_map) of
+  /// the kept shells, runs of contiguous basis functions are merged
+  inline void kept_submat_map( const int32_t* keep,
+    std::vector<std::array<int32_t,3>>& map ) const {
+    map.clear();
+    int32_t small = 0;
+    for( size_t s = 0; s < nshells(); ++s ) if( keep[s] ) {
+      const int32_t sz = offsets_[s+1] - offsets_[s];
+      if( map.size() and map.back()[0] + map.back()[1] == ao_st_[s] )
+        map.back()[1] += sz;
+      else map.push_back( {ao_st_[s], sz, small} );
+      small += sz;
+    }
+  }
+
+};
+
+}
+}
@@ -0,0 +1,73 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/task_cost_model.hpp>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/** Per-task wall times of a host task loop
+ *
+ *  Inactive (no clock reads) unless a TaskCostModel is attached to the
+ *  LoadBalancer. Each loop iteration is timed through a `scope` object
+ *  (such that early `continue`s are accounted for), the times are recorded
+ *  into the model by `commit` outside of the parallel region.
+ */
+class HostTaskTimings {
+
+  using clock_type = std::chrono::steady_clock;
+
+  std::shared_ptr<TaskCostModel> model_;
+  TaskCostModel::key_type        key_;
+  std::vector<double>            times_;
+
+public:
+
+  class scope {
+    double*                 t_;
+    clock_type::time_point  st_;
+  public:
+    scope( double* t ) : t_(t) { if( t_ ) st_ = clock_type::now(); }
+    ~scope() noexcept {
+      if( t_ ) *t_ = std::chrono::duration<double>( clock_type::now() - st_ ).count();
+    }
+    scope( const scope& ) = delete;
+  };
+
+  HostTaskTimings( std::shared_ptr<TaskCostModel> model,
+    TaskCostModel::key_type key, size_t ntasks ) :
+    model_(model), key_(key) {
+    if( model_ ) times_.assign( ntasks, -1. );
+  }
+
+  /// Time the loop body of task iT (must be bound to a named local)
+  inline scope time( size_t iT ) {
+    return scope( model_ ? times_.data() + iT : nullptr );
+  }
+
+  /// Record the measured times into the model (refit collectively by the
+  /// integrator once all ranks are done)
+  template <typename TaskIterator>
+  void commit( TaskIterator task_begin ) {
+    if( not model_ ) return;
+    for( size_t iT = 0; iT < times_.size(); ++iT )
+      if( times_[iT] >= 0. ) model_->record( key_, *(task_begin + iT), times_[iT] );
+  }
+
+};
+
+}
+}
@@ -0,0 +1,67 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/load_balancer.hpp>
+#include <gauxc/exceptions.hpp>
+#include "host/local_host_work_driver.hpp"
+#include "xc_host_data.hpp"
+
+namespace GauXC  {
+namespace detail {
+
+/** Partitioned quadrature weights of a host task loop
+ *
+ *  Stored (modified) weights are used as is. Otherwise, if the LoadBalancer
+ *  requests on-the-fly partitioning (see MolecularWeightsSettings), the
+ *  weights of each task are partitioned into thread local scratch when the
+ *  task is processed, while its points are in cache.
+ */
+class HostTaskWeights {
+
+  LocalHostWorkDriver* lwd_;
+  const Molecule&      mol_;
+  const MolMeta&       meta_;
+  XCWeightAlg          weight_alg_;
+  bool                 on_the_fly_;
+
+public:
+
+  HostTaskWeights( LocalHostWorkDriver* lwd, LoadBalancer& lb ) :
+    lwd_(lwd), mol_(lb.molecule()), meta_(lb.molmeta()),
+    weight_alg_(lb.state().weight_alg), on_the_fly_(false) {
+
+    const auto& state = lb.state();
+    if( state.modified_weights_are_stored ) return;
+    if( not state.partition_weights_on_the_fly )
+      GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+
+    on_the_fly_ = true;
+    lwd_->prepare_partition_weights( weight_alg_, mol_, meta_ );
+
+  }
+
+  inline bool on_the_fly() const { return on_the_fly_; }
+
+  /// Partitioned weights of task (valid until scr is resized)
+  template <typename F>
+  inline const F* operator()( const XCTask& task, host_scratch<F>& scr ) const {
+    if( not on_the_fly_ ) return task.weights.data();
+    scr.resize( task.weights.size() );
+    lwd_->partition_weights( weight_alg_, mol_, meta_, task, scr.data() );
+    return scr.data();
+  }
+
+};
+
+}
+}
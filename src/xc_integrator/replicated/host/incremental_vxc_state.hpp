@@ -0,0 +1,58 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace GauXC  {
+namespace detail {
+
+/** Grid state carried between incremental RKS EXC/VXC builds
+ *
+ *  For every task (in XCExecutionPlan order) the weighted potential
+ *  coefficients which entered its last VXC contribution are kept, such that
+ *  a rebuilt task contributes Z(new) - Z(old) on top of the previous
+ *  (local, symmetrized) VXC. Tasks whose density matrix block has not moved
+ *  by more than the tolerance since their last build reuse their previous
+ *  VXC contribution (their EXC / N_EL are always reevaluated).
+ */
+template <typename F>
+struct IncrementalVXCState {
+
+  bool   valid      = false;
+  bool   is_gga     = false;
+  size_t generation = 0;     ///< XCExecutionPlan generation the state refers to
+  int64_t nbf       = 0;
+
+  std::vector<F> P;   ///< Density matrix of the previous call (nbf x nbf)
+  std::vector<F> VXC; ///< Local VXC of the previous call (nbf x nbf)
+
+  /// Per task: weighted vrho (npts) and, for GGA, the gradient coefficients
+  /// 2 * vgamma * dden (3 * npts, interleaved) of the last build
+  std::vector< std::vector<F> > coeff;
+  std::vector<F>                exc;   ///< Per task EXC contribution
+  std::vector<F>                nel;   ///< Per task N_EL contribution
+  std::vector<F>                drift; ///< Accumulated max |dP| since last build
+
+  void clear() {
+    valid = false;
+    P.clear(); P.shrink_to_fit();
+    VXC.clear(); VXC.shrink_to_fit();
+    coeff.clear(); coeff.shrink_to_fit();
+    exc.clear(); nel.clear(); drift.clear();
+  }
+
+};
+
+}
+}
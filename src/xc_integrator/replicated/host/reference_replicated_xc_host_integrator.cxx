@@ -12,17 +12,60 @@
 #include "reference_replicated_xc_host_integrator_integrate_den.hpp"
 #include "reference_replicated_xc_host_integrator_exc.hpp"
 #include "reference_replicated_xc_host_integrator_exc_vxc.hpp"
+#include "reference_replicated_xc_host_integrator_exc_vxc_incremental.hpp"
 #include "reference_replicated_xc_host_integrator_exc_grad.hpp"
 #include "reference_replicated_xc_host_integrator_exx.hpp"
 #include "reference_replicated_xc_host_integrator_fxc_contraction.hpp"
 #include "reference_replicated_xc_host_integrator_dd_psi.hpp"
 #include "reference_replicated_xc_host_integrator_dd_psi_potential.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace GauXC::detail {
 
 template <typename ValueType>
 ReferenceReplicatedXCHostIntegrator<ValueType>::~ReferenceReplicatedXCHostIntegrator() noexcept = default;
 
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::prepare_host_data_() {
+
+  #ifdef _OPENMP
+  const size_t nthreads = omp_get_max_threads();
+  #else
+  const size_t nthreads = 1;
+  #endif
+
+  if( host_data_.size() < nthreads ) {
+    host_data_.reserve( nthreads );
+    while( host_data_.size() < nthreads ) 
+      host_data_.emplace_back( std::make_unique<XCHostData<value_type>>() );
+  }
+
+  // Initial guess for the per-thread scratch: collocation + gradients, Z 
+  // matrix and nbe x nbe scratch for the largest task. The arenas grow (and 
+  // are subsequently coalesced) if this turns out to be insufficient.
+  const size_t max_nbe = this->load_balancer_->max_nbe();
+  const size_t scr_sz  = 6 * this->load_balancer_->max_npts_x_nbe() + 
+                         max_nbe * max_nbe;
+
+  for( auto& hd : host_data_ ) hd->reset( scr_sz );
+
+}
+
+template <typename ValueType>
+auto ReferenceReplicatedXCHostIntegrator<ValueType>::thread_host_data_() -> 
+  XCHostData<value_type>& {
+
+  #ifdef _OPENMP
+  return *host_data_.at( omp_get_thread_num() );
+  #else
+  return *host_data_.at(0);
+  #endif
+
+}
+
 template class ReferenceReplicatedXCHostIntegrator<double>;
 
 }
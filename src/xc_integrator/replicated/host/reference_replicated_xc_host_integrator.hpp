@@ -12,6 +12,9 @@
 #pragma once
 #include <gauxc/xc_integrator/replicated/replicated_xc_host_integrator.hpp>
 #include "xc_host_data.hpp"
+#include "host_collocation_cache.hpp"
+#include "xc_execution_plan.hpp"
+#include "incremental_vxc_state.hpp"
 
 namespace GauXC::detail {
 
@@ -109,7 +112,8 @@ protected:
                      int64_t ldp, unsigned max_Ylm, value_type* ddPsi, int64_t ldPsi ) override;
 
   /// ddX PhiX
-  void eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx ) override;
+  void eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx,
+                               const IntegratorSettingsXC& ks_settings ) override;
 
   // Implementation details of integrate_den
   void integrate_den_local_work_( const value_type* P, int64_t ldp, 
@@ -126,6 +130,13 @@ protected:
                             value_type* VXCx, int64_t ldvxcx,
                             value_type* EXC, value_type *N_EL, const IntegratorSettingsXC& ks_settings,
                             task_iterator task_begin, task_iterator task_end );
+
+  // Implementation details of incremental RKS exc_vxc (LDA/GGA)
+  void exc_vxc_incremental_local_work_( const basis_type& basis, const value_type* P,
+                                        int64_t ldp, value_type* VXC, int64_t ldvxc,
+                                        value_type* EXC, value_type *N_EL,
+                                        const IntegratorSettingsKS& ks_settings,
+                                        task_iterator task_begin, task_iterator task_end );
                             
   // Implemetation details of exc_grad
   void exc_grad_local_work_( const value_type* Ps, int64_t ldps, const value_type* Pz, int64_t ldpz,
@@ -148,7 +159,37 @@ protected:
   // Implementation details of ddX Psi
   void dd_psi_local_work_( const value_type* P, int64_t ldp, unsigned max_Ylm, value_type* ddPsi, int64_t ldPsi );    
 
-  void dd_psi_potential_local_work_( const value_type* X, value_type* Vddx, unsigned max_Ylm );
+  void dd_psi_potential_local_work_( const value_type* X, value_type* Vddx, unsigned max_Ylm,
+                                     const IntegratorSettingsXC& ks_settings );
+
+  /// Persistent thread local scratch, one instance per OpenMP thread
+  std::vector< std::unique_ptr<XCHostData<value_type>> > host_data_;
+
+  /// Ready the thread local scratch for a new task loop (call outside of
+  /// parallel regions)
+  void prepare_host_data_();
+
+  /// Thread local scratch of the calling thread
+  XCHostData<value_type>& thread_host_data_();
+
+  /// LoadBalancer task generation of [task_begin, task_end) if the range
+  /// spans its local tasks, 0 otherwise (e.g. shell batched task subsets)
+  size_t tasks_generation_( task_iterator task_begin, task_iterator task_end ) {
+    const auto& tasks = this->load_balancer_->get_tasks();
+    const bool spans_tasks = 
+      size_t(std::distance( task_begin, task_end )) == tasks.size() and
+      (tasks.empty() or &*task_begin == tasks.data());
+    return spans_tasks ? this->load_balancer_->tasks_generation() : 0;
+  }
+
+  /// Task order, basis map and submatrix maps reused across calls
+  XCExecutionPlan plan_;
+
+  /// Collocation matrices reused across calls (opt-in via IntegratorSettingsKS)
+  HostCollocationCache<value_type> colloc_cache_;
+
+  /// Grid state of the previous incremental RKS EXC/VXC build
+  IncrementalVXCState<value_type> incremental_vxc_;
   
 public:
 
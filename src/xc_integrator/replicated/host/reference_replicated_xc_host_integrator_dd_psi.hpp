@@ -15,6 +15,7 @@
 #include "integrator_util/integrator_common.hpp"
 #include "integrator_util/spherical_harmonics.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
 #include <gauxc/molgrid/defaults.hpp>
 #include <stdexcept>
 #ifdef GAUXC_ENABLE_OPENMP
@@ -76,34 +77,28 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   for (int i = 0; i < natom; ++i) {
     radii[i] = uff_radius_103(mol[i].Z);
   }
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( tasks.begin(), tasks.end(), task_comparator );
+  this->plan_.prepare( this->load_balancer_->tasks_generation(), basis, mol,
+    tasks.begin(), tasks.end() );
+  const auto& basis_map = this->plan_.basis_map();
 
 
-  // Compute Partition Weights
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified"); 
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
+  this->prepare_host_data_();
+
   #ifdef GAUXC_ENABLE_OPENMP
   #pragma omp parallel
   #endif
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
 
   #ifdef GAUXC_ENABLE_OPENMP
   #pragma omp for schedule(dynamic) reduction(+:dd_Psi[:natom * ldPsi])
@@ -113,13 +108,16 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     const auto& task = tasks[iT];
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
     const int32_t  nshells = task.bfn_screening.shell_list.size();
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
     // Allocate enough memory for batch
@@ -140,13 +138,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     int nharmonics = (max_Ylm + 1) * (max_Ylm + 1);
 
     // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
+    const auto& submat_map = this->plan_.submat_map( iT );
 
     // Evaluate Collocation
     lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
-      basis_eval );
+      basis_eval, &host_data.arena );
 
     // Evaluate X matrix (P * B) -> store in Z
     lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, P, ldp, basis_eval, nbe,
@@ -160,20 +156,17 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const double radius = radii[task.iParent];
     const std::array<double, 3> center = {mol[task.iParent].x, mol[task.iParent].y, mol[task.iParent].z};
 
-    std::vector<double> ylm_matrix(npts * nharmonics);
-    scaled_ylm_matrix(max_Ylm, points, npts, center, radius, ylm_matrix.data());
+    host_data.ylm_scr.resize( npts * nharmonics );
+    auto* ylm_matrix = host_data.ylm_scr.data();
+    scaled_ylm_matrix(max_Ylm, points, npts, center, radius, ylm_matrix);
 
     for (int i = 0; i < npts; ++i) {
       den_eval[i] *= -weights[i];
     }
-    std::vector<double> offset_local_dd_psi(ldPsi, 0.0);
     blas::gemm('N', 'N', ldPsi, 1, npts,  
-            1.0, ylm_matrix.data(), ldPsi,   
+            1.0, ylm_matrix, ldPsi,   
             den_eval, npts,     
-            0.0, offset_local_dd_psi.data(), ldPsi); 
-    for (int j = 0; j < ldPsi; ++j) {
-      dd_Psi[atom_offset + j] += offset_local_dd_psi[j];
-    }
+            1.0, dd_Psi + atom_offset, ldPsi); 
 
   } // Loop over tasks 
   } // End OpenMP region
@@ -15,9 +15,11 @@
 #include "integrator_util/integrator_common.hpp"
 #include "integrator_util/spherical_harmonics.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
 #include <stdexcept>
 #include "host/blas.hpp"
 #include "host/util.hpp"
+#include "host_matrix_accumulator.hpp"
 
 #ifdef GAUXC_ENABLE_OPENMP
 #include <omp.h>
@@ -27,7 +29,7 @@ namespace GauXC::detail {
 template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, 
-    value_type* Vddx ) {
+    value_type* Vddx, const IntegratorSettingsXC& settings ) {
 
   const auto& basis = this->load_balancer_->basis();
   const int32_t nbf = basis.nbf();
@@ -43,7 +45,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   this->load_balancer_->get_tasks();
   // Compute Local contributions to EXC / VXC
   this->timer_.time_op("XCIntegrator.LocalWork", [&](){
-   dd_psi_potential_local_work_( X, Vddx, max_Ylm );
+   dd_psi_potential_local_work_( X, Vddx, max_Ylm, settings );
   });
 
   // Reduce Results
@@ -59,7 +61,19 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
-  dd_psi_potential_local_work_( const value_type* X, value_type* Vddx, unsigned max_Ylm ) {
+  dd_psi_potential_local_work_( const value_type* X, value_type* Vddx, unsigned max_Ylm,
+    const IntegratorSettingsXC& settings ) {
+
+  // Misc KS settings
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  const auto host_acc    = ks_settings.host_accumulation;
+  const auto host_acc_max_bytes = ks_settings.host_accumulation_max_bytes;
+  const bool deterministic = host_acc == HostAccumulation::ThreadPrivate and 
+                             ks_settings.deterministic_accumulation;
 
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
@@ -74,49 +88,50 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     radii[i] = uff_radius_103(mol[i].Z);
   }
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( tasks.begin(), tasks.end(), task_comparator );
+  this->plan_.prepare( this->load_balancer_->tasks_generation(), basis, mol,
+    tasks.begin(), tasks.end() );
+  const auto& basis_map = this->plan_.basis_map();
 
-  // Compute Partition Weights
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified"); 
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
 
+  // Accumulation target for Vddx
+  HostMatrixAccumulator<value_type> Vddx_acc( host_acc, nbf, nbf, Vddx, nbf, host_acc_max_bytes );
+  ScopedHostTaskSchedule task_schedule( deterministic );
+
+  this->prepare_host_data_();
+
   #ifdef GAUXC_ENABLE_OPENMP
   #pragma omp parallel
   #endif
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
 
   #ifdef GAUXC_ENABLE_OPENMP
-  #pragma omp for schedule(dynamic)
+  #pragma omp for schedule(runtime)
   #endif
   for( size_t iT = 0; iT < ntasks; ++iT ) {
 
     // Alias current task
     const auto& task = tasks[iT];
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
     const int32_t  nshells = task.bfn_screening.shell_list.size();
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
     // Allocate enough memory for batch
@@ -135,13 +150,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     int nharmonics = (max_Ylm + 1) * (max_Ylm + 1);
 
     // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
+    const auto& submat_map = this->plan_.submat_map( iT );
     
     // Evaluate Collocation
     lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
-      basis_eval );
+      basis_eval, &host_data.arena );
     
     // Project X onto the spherical harmonics basis
     const size_t atom_offset = task.iParent * nharmonics;
@@ -149,11 +162,12 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     std::array<double, 3> center = {mol[task.iParent].x, mol[task.iParent].y, mol[task.iParent].z};
     const value_type* X_i = X + atom_offset;
 
-    std::vector<double> ylm_matrix(npts * nharmonics);
-    scaled_ylm_matrix(max_Ylm, points, npts, center, radius, ylm_matrix.data());
+    host_data.ylm_scr.resize( npts * nharmonics );
+    auto* ylm_matrix = host_data.ylm_scr.data();
+    scaled_ylm_matrix(max_Ylm, points, npts, center, radius, ylm_matrix);
 
     blas::gemm('T', 'N', npts, 1, nharmonics, 
-              1.0, ylm_matrix.data(), nharmonics, 
+              1.0, ylm_matrix, nharmonics, 
               X_i, nharmonics,                
               0.0, etas, npts);
 
@@ -168,10 +182,17 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // vddx_scr = phi^T * etas * weights * phi
     blas::gemm('N', 'T', nbe, nbe, npts, 1.0, basis_eval, nbe, zmat, nbe, 0.0, vddx_scr, nbe);
 
-    detail::inc_by_submat_atomic( nbf, nbf, nbe, nbe, Vddx, nbf, vddx_scr, nbe,
-                        submat_map );
+    if( Vddx_acc.atomic() )
+      detail::inc_by_submat_atomic( nbf, nbf, nbe, nbe, Vddx_acc.ptr(), Vddx_acc.ld(), 
+                          vddx_scr, nbe, submat_map );
+    else
+      detail::inc_by_submat( nbf, nbf, nbe, nbe, Vddx_acc.ptr(), Vddx_acc.ld(), 
+                          vddx_scr, nbe, submat_map );
   } // Loop over tasks 
   } // End OpenMP region
+
+  // Reduce thread private Vddx
+  Vddx_acc.finalize();
 }
 
 } // namespace GauXC::detail
@@ -14,6 +14,8 @@
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
+#include "host_matrix_accumulator.hpp"
 #include "host/blas.hpp"
 #include <stdexcept>
 
@@ -128,27 +130,23 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     exc_grad_settings = *tmp;
   }
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
   const int32_t natoms = mol.natoms();
 
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( tasks.begin(), tasks.end(), task_comparator );
+  this->plan_.prepare( this->load_balancer_->tasks_generation(), basis, mol,
+    tasks.begin(), tasks.end() );
+  const auto& basis_map = this->plan_.basis_map();
 
 
-  // Check that Partition Weights have been calculated
+  // Partition weights (stored or on-the-fly)
   auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified"); 
-  }
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
   XCWeightAlg& weight_alg = lb_state.weight_alg;
+  if( exc_grad_settings.include_weight_derivatives and
+      not task_weights.on_the_fly() )
+    lwd->prepare_partition_weights( weight_alg, mol, molmeta );
 
   // Zero out integrands
   for( auto i = 0; i < 3*natoms; ++i ) {
@@ -157,10 +155,25 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
+
+  // Serve collocation (+ hessian / laplacian) from the cross-call cache if it
+  // was planned with a compatible layout (third derivatives of the laplacian
+  // path are evaluated per shell)
+  const size_t colloc_ncomp = func.is_lda() ? 4 : needs_laplacian ? 5 : 10;
+  this->colloc_cache_.prepare( this->load_balancer_->tasks_generation(), basis,
+    tasks.begin(), tasks.end(), colloc_ncomp, false );
+
+  this->prepare_host_data_();
+
+  // Per-thread gradient accumulators, reduced once after the task loop
+  HostMatrixAccumulator<value_type> grad_acc( HostAccumulation::ThreadPrivate,
+    3*natoms, 1, EXC_GRAD, 3*natoms );
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
+  auto* exc_grad  = grad_acc.ptr();
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
@@ -168,6 +181,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     auto& task = tasks[iT];
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
@@ -176,7 +192,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const size_t gga_dim_scal = is_rks ? 1 : 3;
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
     // Allocate enough memory for batch
@@ -193,7 +209,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 
     if( func.is_gga() or func.is_mgga() ) {
-      host_data.basis_eval .resize( 10 * npts * nbe );
+      // The laplacian path only stores basis, gradient and laplacian for the
+      // batch, higher derivatives are streamed per shell (shell_basis_eval)
+      host_data.basis_eval .resize( (needs_laplacian ? 5 : 10) * npts * nbe );
       host_data.zmat       .resize( 4  * spin_dim_scal * npts * nbe );
       host_data.gamma      .resize( gga_dim_scal * npts );
       host_data.vgamma     .resize( gga_dim_scal * npts );
@@ -203,7 +221,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       host_data.tau .resize( spin_dim_scal * npts );
       host_data.vtau.resize( spin_dim_scal * npts );
       if ( needs_laplacian ) {
-	host_data.basis_eval.resize( 24 * npts * nbe ); // 11 + lapl_grad(3) + der3(10)
+        int32_t max_sh_sz = 0;
+        for( auto ish = 0; ish < nshells; ++ish )
+          max_sh_sz = std::max( max_sh_sz, int32_t(basis[shell_list[ish]].size()) );
+        // der3(20) + lapl_grad(3) of a single shell
+        host_data.shell_basis_eval.resize( 23 * npts * max_sh_sz );
 	host_data.lapl .resize( spin_dim_scal * npts );
 	host_data.vlapl.resize( spin_dim_scal * npts );
       }
@@ -261,22 +283,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     value_type* d2basis_yz_eval = nullptr;
     value_type* d2basis_zz_eval = nullptr;
      
-    value_type* lbasis_eval        = nullptr;
-    value_type* d3basis_xxx_eval   = nullptr;
-    value_type* d3basis_xxy_eval   = nullptr;
-    value_type* d3basis_xxz_eval   = nullptr;
-    value_type* d3basis_xyy_eval   = nullptr;
-    value_type* d3basis_xyz_eval   = nullptr;
-    value_type* d3basis_xzz_eval   = nullptr;
-    value_type* d3basis_yyy_eval   = nullptr;
-    value_type* d3basis_yyz_eval   = nullptr;
-    value_type* d3basis_yzz_eval   = nullptr;
-    value_type* d3basis_zzz_eval   = nullptr;
-    value_type* dlgradbasis_x_eval = nullptr;
-    value_type* dlgradbasis_y_eval = nullptr;
-    value_type* dlgradbasis_z_eval = nullptr;
+    value_type* lbasis_eval = nullptr;
 
-    if( func.is_gga() or func.is_mgga() ) {
+    if( needs_laplacian ) {
+      lbasis_eval = dbasis_z_eval + npts * nbe;
+    } else if( func.is_gga() or func.is_mgga() ) {
       d2basis_xx_eval = dbasis_z_eval   + npts * nbe;
       d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
       d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
@@ -285,46 +296,24 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       d2basis_zz_eval = d2basis_yz_eval + npts * nbe;
     }
 
-    if( needs_laplacian ) {
-      lbasis_eval      = d2basis_zz_eval + npts * nbe;
-      // TODO - this should not be needed once Gau2Grid 
-      // can evaluate the laplacian gradients directly.
-      d3basis_xxx_eval = lbasis_eval      + npts * nbe;
-      d3basis_xxy_eval = d3basis_xxx_eval + npts * nbe;
-      d3basis_xxz_eval = d3basis_xxy_eval + npts * nbe;
-      d3basis_xyy_eval = d3basis_xxz_eval + npts * nbe;
-      d3basis_xyz_eval = d3basis_xyy_eval + npts * nbe;
-      d3basis_xzz_eval = d3basis_xyz_eval + npts * nbe;
-      d3basis_yyy_eval = d3basis_xzz_eval + npts * nbe;
-      d3basis_yyz_eval = d3basis_yyy_eval + npts * nbe;
-      d3basis_yzz_eval = d3basis_yyz_eval + npts * nbe;
-      d3basis_zzz_eval = d3basis_yzz_eval + npts * nbe;
-      dlgradbasis_x_eval   = d3basis_zzz_eval + npts * nbe;
-      dlgradbasis_y_eval   = dlgradbasis_x_eval   + npts * nbe;
-      dlgradbasis_z_eval   = dlgradbasis_y_eval   + npts * nbe;
-    }
-
-
     // Get the submatrix map for batch
-    auto [submat_map, foo] = 
-      gen_compressed_submat_map( basis_map, task.bfn_screening.shell_list, nbf, nbf );
-
-    // Evaluate Collocation Gradient (+ Hessian)
-    if( needs_laplacian ) {
-      lwd->eval_collocation_der3( npts, nshells, nbe, points, basis, shell_list, 
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-        d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-        d2basis_zz_eval, d3basis_xxx_eval, d3basis_xxy_eval, d3basis_xxz_eval,
-	d3basis_xyy_eval, d3basis_xyz_eval, d3basis_xzz_eval, d3basis_yyy_eval,
-	d3basis_yyz_eval, d3basis_yzz_eval, d3basis_zzz_eval);
-    } else if( func.is_gga() or func.is_mgga() ) {
-      lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list, 
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-        d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-        d2basis_zz_eval );
-    } else {
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list, 
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    const auto& submat_map = this->plan_.submat_map( iT );
+
+    // Evaluate Collocation Gradient (+ Hessian or Laplacian)
+    if( not this->colloc_cache_.load( iT, colloc_ncomp, npts * nbe, basis_eval ) ) {
+      if( needs_laplacian ) {
+        lwd->eval_collocation_laplacian( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval, &host_data.arena );
+      } else if( func.is_gga() or func.is_mgga() ) {
+        lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list, 
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
+          d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
+          d2basis_zz_eval, &host_data.arena );
+      } else {
+        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list, 
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+      }
+      this->colloc_cache_.store( iT, colloc_ncomp, npts * nbe, basis_eval );
     }
 
 
@@ -341,24 +330,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     // Evaluate U and V variables
     if( func.is_mgga() ) {
-      if ( needs_laplacian ) {
-        blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
-        blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
-        blas::axpy( nbe * npts, 1., d2basis_zz_eval, 1, lbasis_eval, 1);
-
-        // TODO - this should be done directly in Gau2Grid
-	blas::lacpy( 'A', nbe, npts, d3basis_xxx_eval, nbe, dlgradbasis_x_eval, nbe );
-        blas::axpy( nbe * npts, 1., d3basis_xyy_eval, 1, dlgradbasis_x_eval, 1);
-        blas::axpy( nbe * npts, 1., d3basis_xzz_eval, 1, dlgradbasis_x_eval, 1);
-
-	blas::lacpy( 'A', nbe, npts, d3basis_xxy_eval, nbe, dlgradbasis_y_eval, nbe );
-        blas::axpy( nbe * npts, 1., d3basis_yyy_eval, 1, dlgradbasis_y_eval, 1);
-        blas::axpy( nbe * npts, 1., d3basis_yzz_eval, 1, dlgradbasis_y_eval, 1);
-
-	blas::lacpy( 'A', nbe, npts, d3basis_xxz_eval, nbe, dlgradbasis_z_eval, nbe );
-        blas::axpy( nbe * npts, 1., d3basis_yyz_eval, 1, dlgradbasis_z_eval, 1);
-        blas::axpy( nbe * npts, 1., d3basis_zzz_eval, 1, dlgradbasis_z_eval, 1);
-      }
       if(is_rks)
         lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
           dbasis_z_eval, lbasis_eval, xNmat, nbe, xNmat_x, xNmat_y, xNmat_z, nbe, 
@@ -398,7 +369,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
         eps[ipt] *=  den * weights[ipt];
       }
       lwd->eval_weight_1st_deriv_contracted( weight_alg, mol, molmeta, 
-        task, eps, EXC_GRAD);
+        task, eps, exc_grad );
     }
 
 
@@ -413,11 +384,66 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
         continue;
       }
 
+      // Second (and laplacian gradient) derivatives of the shell
+      const value_type* d2basis_xx_sh = nullptr;
+      const value_type* d2basis_xy_sh = nullptr;
+      const value_type* d2basis_xz_sh = nullptr;
+      const value_type* d2basis_yy_sh = nullptr;
+      const value_type* d2basis_yz_sh = nullptr;
+      const value_type* d2basis_zz_sh = nullptr;
+      const value_type* dlgradbasis_x_sh = nullptr;
+      const value_type* dlgradbasis_y_sh = nullptr;
+      const value_type* dlgradbasis_z_sh = nullptr;
+      int32_t ld_sh = nbe;
+
+      if( needs_laplacian ) {
+        // Evaluate on demand, contracted below while in cache
+        auto* sh_eval = host_data.shell_basis_eval.data();
+        const size_t sh_len = npts * sh_sz;
+        auto d3 = [&]( int i ) { return sh_eval + i*sh_len; };
+        lwd->eval_collocation_der3( npts, 1, sh_sz, points, basis, shell_list + ish,
+          d3(0), d3(1), d3(2), d3(3), d3(4), d3(5), d3(6), d3(7), d3(8), d3(9),
+          d3(10), d3(11), d3(12), d3(13), d3(14), d3(15), d3(16), d3(17), d3(18),
+          d3(19), &host_data.arena );
+
+        // TODO - this should be done directly in Gau2Grid
+        auto* dlbx = d3(20);
+        auto* dlby = d3(21);
+        auto* dlbz = d3(22);
+        const auto *d3xxx = d3(10), *d3xxy = d3(11), *d3xxz = d3(12),
+                   *d3xyy = d3(13), *d3xzz = d3(15), *d3yyy = d3(16),
+                   *d3yyz = d3(17), *d3yzz = d3(18), *d3zzz = d3(19);
+        for( size_t i = 0; i < sh_len; ++i ) {
+          dlbx[i] = d3xxx[i] + d3xyy[i] + d3xzz[i];
+          dlby[i] = d3xxy[i] + d3yyy[i] + d3yzz[i];
+          dlbz[i] = d3xxz[i] + d3yyz[i] + d3zzz[i];
+        }
+
+        d2basis_xx_sh = d3(4);
+        d2basis_xy_sh = d3(5);
+        d2basis_xz_sh = d3(6);
+        d2basis_yy_sh = d3(7);
+        d2basis_yz_sh = d3(8);
+        d2basis_zz_sh = d3(9);
+        dlgradbasis_x_sh = dlbx;
+        dlgradbasis_y_sh = dlby;
+        dlgradbasis_z_sh = dlbz;
+        ld_sh = sh_sz;
+      } else if( func.is_gga() or func.is_mgga() ) {
+        d2basis_xx_sh = d2basis_xx_eval + bf_off;
+        d2basis_xy_sh = d2basis_xy_eval + bf_off;
+        d2basis_xz_sh = d2basis_xz_eval + bf_off;
+        d2basis_yy_sh = d2basis_yy_eval + bf_off;
+        d2basis_yz_sh = d2basis_yz_eval + bf_off;
+        d2basis_zz_sh = d2basis_zz_eval + bf_off;
+      }
+
       double g_acc_x(0), g_acc_y(0), g_acc_z(0);
       for( int ibf = 0, mu = bf_off; ibf < sh_sz; ++ibf, ++mu )
       for( int ipt = 0; ipt < npts; ++ipt ) {
 
         const int32_t mu_i = mu + ipt*nbe;
+        const int32_t sh_i = ibf + ipt*ld_sh;
 
         // LDA Contributions
         // vrhop is actually vrhon for RKS
@@ -469,12 +495,12 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
           const double xZy = is_uks ? xZmat_y[mu_i] : 0.0;
           const double xZz = is_uks ? xZmat_z[mu_i] : 0.0;
 
-          const double d2bxx = d2basis_xx_eval[mu_i]; // B^2_xx
-          const double d2bxy = d2basis_xy_eval[mu_i]; // B^2_xy
-          const double d2bxz = d2basis_xz_eval[mu_i]; // B^2_xz
-          const double d2byy = d2basis_yy_eval[mu_i]; // B^2_yy
-          const double d2byz = d2basis_yz_eval[mu_i]; // B^2_yz
-          const double d2bzz = d2basis_zz_eval[mu_i]; // B^2_zz
+          const double d2bxx = d2basis_xx_sh[sh_i]; // B^2_xx
+          const double d2bxy = d2basis_xy_sh[sh_i]; // B^2_xy
+          const double d2bxz = d2basis_xz_sh[sh_i]; // B^2_xz
+          const double d2byy = d2basis_yy_sh[sh_i]; // B^2_yy
+          const double d2byz = d2basis_yz_sh[sh_i]; // B^2_yz
+          const double d2bzz = d2basis_zz_sh[sh_i]; // B^2_zz
       
           if(is_rks) {
             // sum_j B^2_{ij} * d_j n
@@ -558,9 +584,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
             if( needs_laplacian ) {
               const double vlapl_ipt = weights[ipt] * vlapl[ipt];
               const double lbf = lbasis_eval[mu_i];
-              const double dlbx = dlgradbasis_x_eval[mu_i];
-              const double dlby = dlgradbasis_y_eval[mu_i];
-              const double dlbz = dlgradbasis_z_eval[mu_i];
+              const double dlbx = dlgradbasis_x_sh[sh_i];
+              const double dlby = dlgradbasis_y_sh[sh_i];
+              const double dlbz = dlgradbasis_z_sh[sh_i];
               d2_term_x = xN * dlbx + xNx * lbf + 2.0*d2_term_x;
               d2_term_y = xN * dlby + xNy * lbf + 2.0*d2_term_y;
               d2_term_z = xN * dlbz + xNz * lbf + 2.0*d2_term_z;
@@ -573,20 +599,14 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
         }
       } // loop over bfns + grid points
 
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 0] += -2 * g_acc_x;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 1] += -2 * g_acc_y;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 2] += -2 * g_acc_z;
+      exc_grad[3*iAt + 0] += -2 * g_acc_x;
+      exc_grad[3*iAt + 1] += -2 * g_acc_y;
+      exc_grad[3*iAt + 2] += -2 * g_acc_z;
 
       if(exc_grad_settings.include_weight_derivatives){
-        #pragma omp atomic
-        EXC_GRAD[3*task.iParent + 0] -= -2 * g_acc_x;
-        #pragma omp atomic
-        EXC_GRAD[3*task.iParent + 1] -= -2 * g_acc_y;
-        #pragma omp atomic
-        EXC_GRAD[3*task.iParent + 2] -= -2 * g_acc_z;
+        exc_grad[3*task.iParent + 0] -= -2 * g_acc_x;
+        exc_grad[3*task.iParent + 1] -= -2 * g_acc_y;
+        exc_grad[3*task.iParent + 2] -= -2 * g_acc_z;
       }
 
       bf_off += sh_sz; // Increment basis offset
@@ -597,7 +617,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   } // OpenMP Region
 
-  
+  grad_acc.finalize();
+
 }
 
 } // namespace GauXC::detail
@@ -14,7 +14,15 @@
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
 #include "host/blas.hpp"
+#include "host_matrix_accumulator.hpp"
+#include "host_shell_screening.hpp"
+#include "host_point_compaction.hpp"
+#include "host_packed_matrix.hpp"
+#include "host_task_timings.hpp"
+#include "host_point_chunking.hpp"
+#include "host/util.hpp"
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -81,6 +89,41 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   });
 
 
+  // Packed mode: local work only provides the lower triangles of VXC, which
+  // are reduced (together with EXC / N_EL) in a single packed buffer
+  const auto* ks_ptr = dynamic_cast<const IntegratorSettingsKS*>(&ks_settings);
+  if( ks_ptr and ks_ptr->packed_vxc ) {
+
+    std::vector<value_type*> VXC_list   = { VXCs };
+    std::vector<int64_t>     ldvxc_list = { ldvxcs };
+    if(VXCz) { VXC_list.emplace_back(VXCz); ldvxc_list.emplace_back(ldvxcz); }
+    if(VXCy) { VXC_list.emplace_back(VXCy); ldvxc_list.emplace_back(ldvxcy); }
+    if(VXCx) { VXC_list.emplace_back(VXCx); ldvxc_list.emplace_back(ldvxcx); }
+
+    const size_t npacked = packed_lower_size(nbf);
+    const size_t nmat    = VXC_list.size();
+    std::vector<value_type> packed( nmat * npacked + 2 );
+    for( size_t i = 0; i < nmat; ++i )
+      pack_lower( nbf, VXC_list[i], ldvxc_list[i], packed.data() + i*npacked );
+    packed[nmat*npacked]     = *EXC;
+    packed[nmat*npacked + 1] = N_EL;
+
+    this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+      if( not this->reduction_driver_->takes_host_memory() )
+        GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+      this->reduction_driver_->allreduce_inplace( packed.data(), packed.size(),
+        ReductionOp::Sum );
+    });
+
+    for( size_t i = 0; i < nmat; ++i )
+      unpack_lower_symmetric( nbf, packed.data() + i*npacked, VXC_list[i],
+        ldvxc_list[i] );
+    *EXC = packed[nmat*npacked];
+    N_EL = packed[nmat*npacked + 1];
+    return;
+
+  }
+
   // Reduce Results
   this->timer_.time_op("XCIntegrator.Allreduce", [&](){
 
@@ -134,7 +177,24 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     ks_settings = *tmp;
   }
 
+  // Incremental builds only cover RKS LDA/GGA VXC, any other VXC build
+  // invalidates the incremental state. They take precedence over the
+  // screening, mixed precision and sub-batching settings and record no task
+  // timings (see IntegratorSettingsKS::incremental_vxc).
+  if( not is_exc_only ) {
+    if( ks_settings.incremental_vxc and is_rks and not this->func_->is_mgga() ) {
+      exc_vxc_incremental_local_work_( basis, Ps, ldps, VXCs, ldvxcs, EXC, N_EL,
+        ks_settings, task_begin, task_end );
+      return;
+    }
+    this->incremental_vxc_.clear();
+  }
+
   const double gks_dtol = ks_settings.gks_dtol;
+  const auto host_acc    = ks_settings.host_accumulation;
+  const auto host_acc_max_bytes = ks_settings.host_accumulation_max_bytes;
+  const bool deterministic = host_acc == HostAccumulation::ThreadPrivate and 
+                             ks_settings.deterministic_accumulation;
 
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
@@ -149,25 +209,17 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("GKS Not Yet Implemented With MGGA Functionals!");
   }
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
 
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( task_begin, task_end, task_comparator );
+  this->plan_.prepare( this->tasks_generation_( task_begin, task_end ), basis,
+    mol, task_begin, task_end );
+  const auto& basis_map = this->plan_.basis_map();
 
 
-  // Check that Partition Weights have been calculated
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
   // Zero out integrands
   
@@ -201,381 +253,696 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Loop over tasks
   const size_t ntasks = std::distance(task_begin, task_end);
 
+  // Accumulation targets for the integrands
+  HostMatrixAccumulator<value_type> VXCs_acc( host_acc, nbf, nbf, VXCs, ldvxcs, host_acc_max_bytes );
+  HostMatrixAccumulator<value_type> VXCz_acc( host_acc, nbf, nbf, VXCz, ldvxcz, host_acc_max_bytes );
+  HostMatrixAccumulator<value_type> VXCy_acc( host_acc, nbf, nbf, VXCy, ldvxcy, host_acc_max_bytes );
+  HostMatrixAccumulator<value_type> VXCx_acc( host_acc, nbf, nbf, VXCx, ldvxcx, host_acc_max_bytes );
+
+  // Per-task scalar contributions (summed in task order if deterministic)
+  std::vector<double> EXC_task, NEL_task;
+  if( deterministic ) {
+    EXC_task.resize(ntasks);
+    NEL_task.resize(ntasks);
+  }
+
+  ScopedHostTaskSchedule task_schedule( deterministic );
+
+  // Collocation (basis + derivatives) reused across calls
+  const size_t colloc_ncomp = func.is_lda() ? 1 : 
+                              (func.is_mgga() and needs_laplacian) ? 5 : 4;
+  this->colloc_cache_.configure( ks_settings.collocation_cache_bytes,
+    ks_settings.collocation_cache_storage );
+  this->colloc_cache_.prepare( this->tasks_generation_( task_begin, task_end ),
+    basis, task_begin, task_end, colloc_ncomp, true );
+
+  // Density matrix driven shell screening (RKS/UKS LDA/GGA)
+  const double screen_tol    = ks_settings.density_screening_tol;
+  const bool   screen_shells = screen_tol > 0. and not func.is_mgga() and
+                               not is_gks;
+  std::vector<value_type> P_shell_nrm;
+  if( screen_shells ) {
+    shell_block_max_abs( basis_map, Ps, ldps, P_shell_nrm );
+    if( Pz ) shell_block_max_abs( basis_map, Pz, ldpz, P_shell_nrm );
+  }
+  const int32_t nshells_bf = basis_map.shell_sizes().size();
+
+  // Grid point compaction by total density (RKS/UKS LDA/GGA)
+  const double point_tol      = ks_settings.point_density_tol;
+  const bool   compact_points = point_tol > 0. and not func.is_mgga() and
+                                not is_gks;
+
+  // FP32 X matrix / VXC products while the SCF is far from convergence
+  const bool use_fp32 = ks_settings.mixed_precision and not func.is_mgga() and
+    not is_gks and 
+    ks_settings.mixed_precision_scf_error > ks_settings.mixed_precision_threshold;
+  using submat_map_t = XCExecutionPlan::submat_map_t;
+
+  // Per-task wall times for the measured cost model (EXC/VXC builds only)
+  const TaskCostModel::key_type cost_key = {
+    func.is_mgga() ? (needs_laplacian ? TaskCostClass::MGGA_LAPL : TaskCostClass::MGGA) :
+    func.is_gga()  ? TaskCostClass::GGA : TaskCostClass::LDA,
+    is_rks ? TaskCostSpin::RKS : is_uks ? TaskCostSpin::UKS : TaskCostSpin::GKS };
+  HostTaskTimings task_timings( is_exc_only ? nullptr : 
+    this->load_balancer_->cost_model(), cost_key, ntasks );
+
+  this->prepare_host_data_();
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
 
-  #pragma omp for schedule(dynamic)
+  #pragma omp for schedule(runtime)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto task_timer = task_timings.time( iT );
      
     //std::cout << iT << "/" << ntasks << std::endl;
     //if(is_exc_only) printf("%lu / %lu\n", iT, ntasks);
     // Alias current task
     const auto& task = *(task_begin + iT);
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
-    const int32_t  npts    = task.points.size();
-    const int32_t  nbe     = task.bfn_screening.nbe;
-    const int32_t  nshells = task.bfn_screening.shell_list.size();
+    const int32_t  task_npts = task.points.size();
+    const int32_t  nbe       = task.bfn_screening.nbe;
+    const int32_t  nshells   = task.bfn_screening.shell_list.size();
 
-    const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* task_points  = task.points.data()->data();
+    const auto* task_wgts    = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
-    // Allocate enough memory for batch
-   
     const size_t spin_dim_scal = is_rks ? 1 : is_uks ? 2 : 4; // last case is_gks
     const size_t sds          = is_rks ? 1 : 2;
-    const size_t gks_mod_KH = is_gks ? 6*npts : 0; // used to store H and H
     const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
 
-    // Things that every calc needs
-    host_data.nbe_scr .resize(nbe  * nbe);
-    host_data.zmat    .resize(npts * nbe * spin_dim_scal * mgga_dim_scal + gks_mod_KH); 
-    host_data.eps     .resize(npts);
-    host_data.vrho    .resize(npts * spin_dim_scal);
-
-    // LDA data requirements
-    if( func.is_lda() ){
-      host_data.basis_eval .resize( npts * nbe );
-      host_data.den_scr    .resize( npts * spin_dim_scal);
+    // Get the submatrix map for batch
+    const auto& submat_map = this->plan_.submat_map( iT );
+
+    // Split the task into sub-batches whose collocation and Z matrix fit in
+    // cache. VXC of a split task is accumulated into per-task (nbe,nbe)
+    // blocks which are scattered into the integrands once.
+    const int32_t chunk_npts = detail::host_point_chunk_size( task_npts, nbe,
+      colloc_ncomp + spin_dim_scal * mgga_dim_scal, sizeof(value_type),
+      ks_settings.point_chunk_size );
+    const bool vxc_block = not is_exc_only and chunk_npts < task_npts;
+    const submat_map_t block_map = { {0, nbe, 0} };
+
+    value_type* VXCs_blk = nullptr;
+    value_type* VXCz_blk = nullptr;
+    value_type* VXCy_blk = nullptr;
+    value_type* VXCx_blk = nullptr;
+    if( vxc_block ) {
+      const size_t blk_sz = size_t(nbe) * nbe;
+      host_data.vxc_blk.resize( spin_dim_scal * blk_sz );
+      std::fill_n( host_data.vxc_blk.data(), spin_dim_scal * blk_sz, 0. );
+      VXCs_blk = host_data.vxc_blk.data();
+      if( not is_rks ) VXCz_blk = VXCs_blk + blk_sz;
+      if( is_gks ) {
+        VXCy_blk = VXCz_blk + blk_sz;
+        VXCx_blk = VXCy_blk + blk_sz;
+      }
     }
+
+    // Loop over sub-batches
+    for( int32_t ipt = 0; ipt < task_npts; ipt += chunk_npts ) {
+
+      int32_t npts = std::min( chunk_npts, task_npts - ipt ); // Reduced by point compaction
+      const auto* points  = task_points + 3*ipt;
+      const auto* weights = task_wgts   + ipt;
+
+      // Allocate enough memory for batch
+   
+      const size_t gks_mod_KH = is_gks ? 6*npts : 0; // used to store H and H
+
+      // Things that every calc needs
+      host_data.nbe_scr .resize(nbe  * nbe);
+      host_data.zmat    .resize(npts * nbe * spin_dim_scal * mgga_dim_scal + gks_mod_KH); 
+      host_data.eps     .resize(npts);
+      host_data.vrho    .resize(npts * spin_dim_scal);
+
+      // LDA data requirements
+      if( func.is_lda() ){
+        host_data.basis_eval .resize( npts * nbe );
+        host_data.den_scr    .resize( npts * spin_dim_scal);
+      }
      
-    // GGA data requirements
-    const size_t gga_dim_scal = is_rks ? 1 : 3;
-    if( func.is_gga() ){
-      host_data.basis_eval .resize( 4 * npts * nbe );
-      host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
-      host_data.gamma      .resize( gga_dim_scal * npts );
-      host_data.vgamma     .resize( gga_dim_scal * npts );
-    }
+      // GGA data requirements
+      const size_t gga_dim_scal = is_rks ? 1 : 3;
+      if( func.is_gga() ){
+        host_data.basis_eval .resize( 4 * npts * nbe );
+        host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
+        host_data.gamma      .resize( gga_dim_scal * npts );
+        host_data.vgamma     .resize( gga_dim_scal * npts );
+      }
 
-    if( func.is_mgga() ){
-      if ( needs_laplacian ) {
-        host_data.basis_eval .resize( 11 * npts * nbe ); // basis + grad (3) + hess (6) + lapl 
-        host_data.lapl       .resize( spin_dim_scal * npts );
-        host_data.vlapl      .resize( spin_dim_scal * npts );
-      } else {
-        host_data.basis_eval .resize( 4 * npts * nbe ); // basis + grad (3)
+      if( func.is_mgga() ){
+        if ( needs_laplacian ) {
+          host_data.basis_eval .resize( 5 * npts * nbe ); // basis + grad (3) + lapl
+          host_data.lapl       .resize( spin_dim_scal * npts );
+          host_data.vlapl      .resize( spin_dim_scal * npts );
+        } else {
+          host_data.basis_eval .resize( 4 * npts * nbe ); // basis + grad (3)
+        }
+
+        host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
+        host_data.gamma      .resize( gga_dim_scal * npts );
+        host_data.vgamma     .resize( gga_dim_scal * npts );
+        host_data.tau        .resize( npts * spin_dim_scal );
+        host_data.vtau       .resize( npts * spin_dim_scal );
       }
 
-      host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
-      host_data.gamma      .resize( gga_dim_scal * npts );
-      host_data.vgamma     .resize( gga_dim_scal * npts );
-      host_data.tau        .resize( npts * spin_dim_scal );
-      host_data.vtau       .resize( npts * spin_dim_scal );
-    }
+      if( screen_shells ) host_data.screen_scr.resize( 4 * npts * nbe );
 
-    // Alias/Partition out scratch memory
-    auto* basis_eval = host_data.basis_eval.data();
-    auto* den_eval   = host_data.den_scr.data();
-    auto* nbe_scr    = host_data.nbe_scr.data();
-    auto* zmat       = host_data.zmat.data();
-
-    decltype(zmat) zmat_z = nullptr;
-    decltype(zmat) zmat_x = nullptr;
-    decltype(zmat) zmat_y = nullptr;
-    if(!is_rks) {
-      zmat_z = zmat + mgga_dim_scal * nbe * npts;
-    }
-    if(is_gks) {
-      zmat_x = zmat_z + nbe * npts;
-      zmat_y = zmat_x + nbe * npts;
-    }
-     
-    auto* eps        = host_data.eps.data();
-    auto* gamma      = host_data.gamma.data();
-    auto* tau        = host_data.tau.data();
-    auto* lapl       = host_data.lapl.data();
-    auto* vrho       = host_data.vrho.data();
-    auto* vgamma     = host_data.vgamma.data();
-    auto* vtau       = host_data.vtau.data();
-    auto* vlapl      = host_data.vlapl.data();
-
-
-    value_type* dbasis_x_eval = nullptr;
-    value_type* dbasis_y_eval = nullptr;
-    value_type* dbasis_z_eval = nullptr;
-    value_type* d2basis_xx_eval = nullptr;
-    value_type* d2basis_xy_eval = nullptr;
-    value_type* d2basis_xz_eval = nullptr;
-    value_type* d2basis_yy_eval = nullptr;
-    value_type* d2basis_yz_eval = nullptr;
-    value_type* d2basis_zz_eval = nullptr;
-    value_type* lbasis_eval = nullptr;
-    value_type* dden_x_eval = nullptr;
-    value_type* dden_y_eval = nullptr;
-    value_type* dden_z_eval = nullptr;
-    value_type* K = nullptr;
-    value_type* H = nullptr;
-    if (is_gks) { K = zmat + npts * nbe * 4; }
-    value_type* mmat_x      = nullptr;
-    value_type* mmat_y      = nullptr;
-    value_type* mmat_z      = nullptr;
-    value_type* mmat_x_z    = nullptr;
-    value_type* mmat_y_z    = nullptr;
-    value_type* mmat_z_z    = nullptr;
-
-    if( func.is_gga() ) {
-      dbasis_x_eval = basis_eval    + npts * nbe;
-      dbasis_y_eval = dbasis_x_eval + npts * nbe;
-      dbasis_z_eval = dbasis_y_eval + npts * nbe;
-      dden_x_eval   = den_eval    + spin_dim_scal * npts;
-      dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
-      dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
-      if (is_gks) { H = K + 3*npts;}
-    }
+      // Alias/Partition out scratch memory
+      auto* basis_eval = host_data.basis_eval.data();
+      auto* den_eval   = host_data.den_scr.data();
+      auto* nbe_scr    = host_data.nbe_scr.data();
+      auto* zmat       = host_data.zmat.data();
 
-    if ( func.is_mgga() ) {
-      dbasis_x_eval = basis_eval    + npts * nbe;
-      dbasis_y_eval = dbasis_x_eval + npts * nbe;
-      dbasis_z_eval = dbasis_y_eval + npts * nbe;
-      dden_x_eval   = den_eval    + spin_dim_scal * npts;
-      dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
-      dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
-      mmat_x        = zmat + npts * nbe;
-      mmat_y        = mmat_x + npts * nbe;
-      mmat_z        = mmat_y + npts * nbe;
-      if ( needs_laplacian ) {
-        d2basis_xx_eval = dbasis_z_eval + npts * nbe;
-        d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
-        d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
-        d2basis_yy_eval = d2basis_xz_eval + npts * nbe;
-        d2basis_yz_eval = d2basis_yy_eval + npts * nbe;
-        d2basis_zz_eval = d2basis_yz_eval + npts * nbe;
-        lbasis_eval     = d2basis_zz_eval + npts * nbe;
+      decltype(zmat) zmat_z = nullptr;
+      decltype(zmat) zmat_x = nullptr;
+      decltype(zmat) zmat_y = nullptr;
+      if(!is_rks) {
+        zmat_z = zmat + mgga_dim_scal * nbe * npts;
       }
-      if(is_uks) {
-        mmat_x_z = zmat_z + npts * nbe;
-        mmat_y_z = mmat_x_z + npts * nbe;
-        mmat_z_z = mmat_y_z + npts * nbe;
+      if(is_gks) {
+        zmat_x = zmat_z + nbe * npts;
+        zmat_y = zmat_x + nbe * npts;
+      }
+     
+      auto* eps        = host_data.eps.data();
+      auto* gamma      = host_data.gamma.data();
+      auto* tau        = host_data.tau.data();
+      auto* lapl       = host_data.lapl.data();
+      auto* vrho       = host_data.vrho.data();
+      auto* vgamma     = host_data.vgamma.data();
+      auto* vtau       = host_data.vtau.data();
+      auto* vlapl      = host_data.vlapl.data();
+
+
+      value_type* dbasis_x_eval = nullptr;
+      value_type* dbasis_y_eval = nullptr;
+      value_type* dbasis_z_eval = nullptr;
+      value_type* lbasis_eval = nullptr;
+      value_type* dden_x_eval = nullptr;
+      value_type* dden_y_eval = nullptr;
+      value_type* dden_z_eval = nullptr;
+      value_type* K = nullptr;
+      value_type* H = nullptr;
+      if (is_gks) { K = zmat + npts * nbe * 4; }
+      value_type* mmat_x      = nullptr;
+      value_type* mmat_y      = nullptr;
+      value_type* mmat_z      = nullptr;
+      value_type* mmat_x_z    = nullptr;
+      value_type* mmat_y_z    = nullptr;
+      value_type* mmat_z_z    = nullptr;
+
+      if( func.is_gga() ) {
+        dbasis_x_eval = basis_eval    + npts * nbe;
+        dbasis_y_eval = dbasis_x_eval + npts * nbe;
+        dbasis_z_eval = dbasis_y_eval + npts * nbe;
+        dden_x_eval   = den_eval    + spin_dim_scal * npts;
+        dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
+        dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
+        if (is_gks) { H = K + 3*npts;}
       }
-    }
 
+      if ( func.is_mgga() ) {
+        dbasis_x_eval = basis_eval    + npts * nbe;
+        dbasis_y_eval = dbasis_x_eval + npts * nbe;
+        dbasis_z_eval = dbasis_y_eval + npts * nbe;
+        dden_x_eval   = den_eval    + spin_dim_scal * npts;
+        dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
+        dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
+        mmat_x        = zmat + npts * nbe;
+        mmat_y        = mmat_x + npts * nbe;
+        mmat_z        = mmat_y + npts * nbe;
+        if ( needs_laplacian ) {
+          lbasis_eval = dbasis_z_eval + npts * nbe;
+        }
+        if(is_uks) {
+          mmat_x_z = zmat_z + npts * nbe;
+          mmat_y_z = mmat_x_z + npts * nbe;
+          mmat_z_z = mmat_y_z + npts * nbe;
+        }
+      }
 
-    // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
-
-    // Evaluate Collocation (+ Grad and Hessian)
-    if( func.is_mgga() ) {
-      if ( needs_laplacian ) {
-        // TODO: Modify gau2grid to compute Laplacian instead of full hessian
-        lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-          d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-          d2basis_zz_eval);
-        blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
-        blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
-        blas::axpy( nbe * npts, 1., d2basis_zz_eval, 1, lbasis_eval, 1);
-      } else {
-        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+
+      // Evaluate Collocation (+ Grad and Laplacian)
+      if( not this->colloc_cache_.load_points( iT, colloc_ncomp, ipt, npts, basis_eval ) ) {
+        if( func.is_mgga() ) {
+          if ( needs_laplacian ) {
+            lwd->eval_collocation_laplacian( npts, nshells, nbe, points, basis, shell_list,
+              basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval, &host_data.arena );
+          } else {
+            lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+              basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+          }
+        }
+        // Evaluate Collocation (+ Grad)
+        else if( func.is_gga() )
+          lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+        else
+          lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, &host_data.arena );
+        this->colloc_cache_.store_points( iT, colloc_ncomp, ipt, npts, basis_eval );
       }
-    }
-    // Evaluate Collocation (+ Grad)
-    else if( func.is_gga() )
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
-    else
-      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval );
 
-     
-    // Evaluate X matrix (fac * P * B) -> store in Z
-    const auto xmat_fac = is_rks ? 2.0 : 1.0; // TODO Fix for spinor RKS input
-    lwd->eval_xmat( mgga_dim_scal * npts, nbf, nbe, submat_map, xmat_fac, Ps, ldps, basis_eval, nbe,
-      zmat, nbe, nbe_scr );
-		
+      // FP32 collocation, shared by the X matrix and VXC products
+      float* basis_eval_sp = nullptr;
+      if( use_fp32 ) {
+        host_data.basis_eval_fp32.resize( npts * nbe );
+        basis_eval_sp = host_data.basis_eval_fp32.data();
+        std::copy_n( basis_eval, npts * nbe, basis_eval_sp );
+      }
 
-    // X matrix for Pz
-    if(not is_rks) {
-      lwd->eval_xmat( mgga_dim_scal * npts, nbf, nbe, submat_map, 1.0, Pz, ldpz, basis_eval, nbe,
-        zmat_z, nbe, nbe_scr);
-    }
      
-    if(is_gks) {
-      lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Py, ldpy, basis_eval, nbe,
-        zmat_x, nbe, nbe_scr);
-      lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Px, ldpx, basis_eval, nbe,
-        zmat_y, nbe, nbe_scr);
-    }
-     
-    // Evaluate U and V variables
-    if( func.is_mgga() ) {
-      if (is_rks) {
-        lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, lbasis_eval, zmat, nbe, mmat_x, mmat_y, mmat_z, 
-          nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
-      } else if (is_uks) {
-        lwd->eval_uvvar_mgga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, lbasis_eval, zmat, nbe, zmat_z, nbe, 
-          mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe, 
-          den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
+      // Drop shells which only touch negligible density matrix blocks from the
+      // X matrix / density evaluation (X is only formed over the kept shells)
+      const auto& shell_list_v = task.bfn_screening.shell_list;
+      int32_t xnbe = nbe;
+      const submat_map_t* xsubmat_map = &submat_map;
+      value_type* xbasis_eval    = basis_eval;
+      value_type* xdbasis_x_eval = dbasis_x_eval;
+      value_type* xdbasis_y_eval = dbasis_y_eval;
+      value_type* xdbasis_z_eval = dbasis_z_eval;
+      if( screen_shells ) {
+        auto& layout = host_data.shell_layout;
+        layout.assign( basis_map, shell_list_v );
+        const int32_t ncomp = func.is_gga() ? 4 : 1;
+        host_data.shell_scr.resize( nshells );
+        host_data.shell_keep.resize( nshells );
+        auto* phi_max = host_data.shell_scr.data();
+        auto* keep    = host_data.shell_keep.data();
+        std::fill_n( phi_max, nshells, 0. );
+        std::fill_n( keep,    nshells, 0  );
+        for( int32_t c = 0; c < ncomp; ++c )
+          layout.row_max( npts, basis_eval + c*npts*nbe, nbe, phi_max );
+
+        for( int32_t s = 0; s < nshells; ++s )
+        for( int32_t t = 0; t < nshells and not keep[s]; ++t ) {
+          const auto nrm = P_shell_nrm[ shell_list_v[s] + shell_list_v[t]*nshells_bf ];
+          keep[s] = nrm * phi_max[s] * phi_max[t] >= screen_tol;
+        }
+
+        xnbe = layout.nbe( keep );
+        if( xnbe and xnbe < nbe ) {
+          auto* scr = host_data.screen_scr.data();
+          for( int32_t c = 0; c < ncomp; ++c )
+            layout.compact_rows( keep, npts, basis_eval + c*npts*nbe, nbe,
+              scr + c*npts*xnbe, xnbe );
+          xbasis_eval = scr;
+          if( func.is_gga() ) {
+            xdbasis_x_eval = xbasis_eval    + npts*xnbe;
+            xdbasis_y_eval = xdbasis_x_eval + npts*xnbe;
+            xdbasis_z_eval = xdbasis_y_eval + npts*xnbe;
+          }
+
+          layout.kept_submat_map( keep, host_data.xsubmat_map );
+          xsubmat_map = &host_data.xsubmat_map;
+        } else xnbe = nbe;
       }
-    } else if ( func.is_gga() ) {
-      if(is_rks) {
-        lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
-          gamma );
-      } else if(is_uks) {
-        lwd->eval_uvvar_gga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, zmat_z, nbe, den_eval, dden_x_eval, 
-          dden_y_eval, dden_z_eval, gamma );
-      } else if(is_gks) {
-        lwd->eval_uvvar_gga_gks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe, den_eval, dden_x_eval,
-          dden_y_eval, dden_z_eval, gamma, K, H, gks_dtol );
+
+      // Evaluate X matrix (fac * P * B) -> store in Z
+      const auto xmat_fac = is_rks ? 2.0 : 1.0; // TODO Fix for spinor RKS input
+      if( use_fp32 ) {
+        host_data.fp32_scr.resize( xnbe * (xnbe + npts) );
+        auto* fp32_scr       = host_data.fp32_scr.data();
+        auto* xbasis_eval_sp = basis_eval_sp;
+        if( xnbe < nbe ) {
+          host_data.basis_eval_fp32_scr.resize( npts * xnbe );
+          xbasis_eval_sp = host_data.basis_eval_fp32_scr.data();
+          host_data.shell_layout.compact_rows( host_data.shell_keep.data(), npts,
+            basis_eval_sp, nbe, xbasis_eval_sp, xnbe );
+        }
+
+        lwd->eval_xmat_fp32( npts, nbf, xnbe, *xsubmat_map, xmat_fac, Ps, ldps, 
+          xbasis_eval_sp, xnbe, zmat, xnbe, fp32_scr );
+        if(not is_rks) {
+          lwd->eval_xmat_fp32( npts, nbf, xnbe, *xsubmat_map, 1.0, Pz, ldpz, 
+            xbasis_eval_sp, xnbe, zmat_z, xnbe, fp32_scr );
+        }
+      } else {
+        lwd->eval_xmat( mgga_dim_scal * npts, nbf, xnbe, *xsubmat_map, xmat_fac, Ps, ldps, xbasis_eval, xnbe,
+          zmat, xnbe, nbe_scr );
+
+        // X matrix for Pz
+        if(not is_rks) {
+          lwd->eval_xmat( mgga_dim_scal * npts, nbf, xnbe, *xsubmat_map, 1.0, Pz, ldpz, xbasis_eval, xnbe,
+            zmat_z, xnbe, nbe_scr);
+        }
       }
+     
+      if(is_gks) {
+        lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Py, ldpy, basis_eval, nbe,
+          zmat_x, nbe, nbe_scr);
+        lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Px, ldpx, basis_eval, nbe,
+          zmat_y, nbe, nbe_scr);
+      }
+     
+      // Evaluate U and V variables
+      if( func.is_mgga() ) {
+        if (is_rks) {
+          lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval, lbasis_eval, zmat, nbe, mmat_x, mmat_y, mmat_z, 
+            nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
+        } else if (is_uks) {
+          lwd->eval_uvvar_mgga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval, lbasis_eval, zmat, nbe, zmat_z, nbe, 
+            mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe, 
+            den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
+        }
+      } else if ( func.is_gga() ) {
+        if(is_rks) {
+          lwd->eval_uvvar_gga_rks( npts, xnbe, xbasis_eval, xdbasis_x_eval, xdbasis_y_eval,
+            xdbasis_z_eval, zmat, xnbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+            gamma );
+        } else if(is_uks) {
+          lwd->eval_uvvar_gga_uks( npts, xnbe, xbasis_eval, xdbasis_x_eval, xdbasis_y_eval,
+            xdbasis_z_eval, zmat, xnbe, zmat_z, xnbe, den_eval, dden_x_eval, 
+            dden_y_eval, dden_z_eval, gamma );
+        } else if(is_gks) {
+          lwd->eval_uvvar_gga_gks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe, den_eval, dden_x_eval,
+            dden_y_eval, dden_z_eval, gamma, K, H, gks_dtol );
+        }
        
-     } else {
-      if(is_rks) {
-        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, zmat, nbe, den_eval );
-      } else if(is_uks) {
-        lwd->eval_uvvar_lda_uks( npts, nbe, basis_eval, zmat, nbe, zmat_z, nbe,
-          den_eval );
-      } else if(is_gks) {
-        lwd->eval_uvvar_lda_gks( npts, nbe, basis_eval, zmat, nbe, zmat_z, nbe,
-          zmat_x, nbe, zmat_y, nbe, den_eval, K, gks_dtol );
+       } else {
+        if(is_rks) {
+          lwd->eval_uvvar_lda_rks( npts, xnbe, xbasis_eval, zmat, xnbe, den_eval );
+        } else if(is_uks) {
+          lwd->eval_uvvar_lda_uks( npts, xnbe, xbasis_eval, zmat, xnbe, zmat_z, xnbe,
+            den_eval );
+        } else if(is_gks) {
+          lwd->eval_uvvar_lda_gks( npts, nbe, basis_eval, zmat, nbe, zmat_z, nbe,
+            zmat_x, nbe, zmat_y, nbe, den_eval, K, gks_dtol );
+        }
+       }
+
+      // Drop points with negligible total density, all subsequent work (the
+      // functional, Z matrix and VXC increment) runs on the kept points only
+      if( compact_points ) {
+        host_data.point_keep.resize( npts );
+        auto* kept = host_data.point_keep.data();
+        int32_t nkeep = 0;
+        for( int32_t i = 0; i < npts; ++i ) {
+          const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
+          if( den >= point_tol ) kept[nkeep++] = i;
+        }
+        if( not nkeep ) continue;
+
+        if( nkeep < npts ) {
+          const size_t ncomp = func.is_gga() ? 4 : 1;
+          compact_point_blocks( nbe, npts, ncomp, nkeep, kept, basis_eval );
+          if( use_fp32 )
+            compact_point_blocks( nbe, npts, 1, nkeep, kept, basis_eval_sp );
+          compact_point_blocks( sds, npts, ncomp, nkeep, kept, den_eval );
+          if( func.is_gga() )
+            compact_point_blocks( gga_dim_scal, npts, 1, nkeep, kept, gamma );
+
+          host_data.weights_scr.resize( nkeep );
+          auto* weights_scr = host_data.weights_scr.data();
+          for( int32_t k = 0; k < nkeep; ++k ) weights_scr[k] = weights[kept[k]];
+          weights = weights_scr;
+
+          npts = nkeep;
+          if( func.is_gga() ) {
+            dbasis_x_eval = basis_eval    + npts * nbe;
+            dbasis_y_eval = dbasis_x_eval + npts * nbe;
+            dbasis_z_eval = dbasis_y_eval + npts * nbe;
+            dden_x_eval   = den_eval    + sds * npts;
+            dden_y_eval   = dden_x_eval + sds * npts;
+            dden_z_eval   = dden_y_eval + sds * npts;
+          }
+        }
       }
-     }
     
-    // Evaluate XC functional
-    if( func.is_mgga() )
-      func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau);
-    else if( func.is_gga() )
-      func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
-    else
-      func.eval_exc_vxc( npts, den_eval, eps, vrho );
-
-    // Factor weights into XC results
-    for( int32_t i = 0; i < npts; ++i ) {
-      eps[i]  *= weights[i];
-      vrho[sds*i] *= weights[i];
-      if(not is_rks) vrho[sds*i+1] *= weights[i];
-    }
-    if( func.is_gga() ){
+      // Evaluate XC functional
+      if( func.is_mgga() )
+        func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau);
+      else if( func.is_gga() )
+        func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+      else
+        func.eval_exc_vxc( npts, den_eval, eps, vrho );
+
+      // Factor weights into XC results
       for( int32_t i = 0; i < npts; ++i ) {
-         vgamma[gga_dim_scal*i] *= weights[i];
-         if(not is_rks) {
-           vgamma[gga_dim_scal*i+1] *= weights[i];
-           vgamma[gga_dim_scal*i+2] *= weights[i];
-         }
+        eps[i]  *= weights[i];
+        vrho[sds*i] *= weights[i];
+        if(not is_rks) vrho[sds*i+1] *= weights[i];
       }
-    }
-
-    if( func.is_mgga() ){
-      for( int32_t i = 0; i < npts; ++i) {
-        vtau[spin_dim_scal*i]  *= weights[i];
-        vgamma[gga_dim_scal*i] *= weights[i];
-        if(not is_rks) {
-          vgamma[gga_dim_scal*i+1] *= weights[i];
-          vgamma[gga_dim_scal*i+2] *= weights[i];
-          vtau[spin_dim_scal*i+1]  *= weights[i];
+      if( func.is_gga() ){
+        for( int32_t i = 0; i < npts; ++i ) {
+           vgamma[gga_dim_scal*i] *= weights[i];
+           if(not is_rks) {
+             vgamma[gga_dim_scal*i+1] *= weights[i];
+             vgamma[gga_dim_scal*i+2] *= weights[i];
+           }
         }
+      }
 
-        // TODO: Add checks for Lapacian-dependent functionals
-        if( needs_laplacian ) {
-          vlapl[spin_dim_scal*i] *= weights[i];
+      if( func.is_mgga() ){
+        for( int32_t i = 0; i < npts; ++i) {
+          vtau[spin_dim_scal*i]  *= weights[i];
+          vgamma[gga_dim_scal*i] *= weights[i];
           if(not is_rks) {
-            vlapl[spin_dim_scal*i+1] *= weights[i];
+            vgamma[gga_dim_scal*i+1] *= weights[i];
+            vgamma[gga_dim_scal*i+2] *= weights[i];
+            vtau[spin_dim_scal*i+1]  *= weights[i];
+          }
+
+          // TODO: Add checks for Lapacian-dependent functionals
+          if( needs_laplacian ) {
+            vlapl[spin_dim_scal*i] *= weights[i];
+            if(not is_rks) {
+              vlapl[spin_dim_scal*i+1] *= weights[i];
+            }
           }
         }
       }
-    }
 
 
-    // Scalar integrations
-    double NEL_local = 0.0;
-    double EXC_local  = 0.0;
-    for( int32_t i = 0; i < npts; ++i ) {
-      const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
-      NEL_local += weights[i] * den;
-      EXC_local += eps[i]     * den;
-    }
+      // Scalar integrations
+      double NEL_local = 0.0;
+      double EXC_local  = 0.0;
+      for( int32_t i = 0; i < npts; ++i ) {
+        const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
+        NEL_local += weights[i] * den;
+        EXC_local += eps[i]     * den;
+      }
 
-    // Atomic updates
-    #pragma omp atomic
-    EXC_WORK += EXC_local;
-    #pragma omp atomic
-    NEL_WORK += NEL_local;
-
-    if(is_exc_only) continue;
-
-    // Evaluate Z matrix for VXC
-    if( func.is_mgga() ) {
-      if(is_rks) {
-        lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
-                                     dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe);
-        lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe);
-      } else if (is_uks) {
-        lwd->eval_zmat_mgga_vxc_uks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
-                                     dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe, zmat_z, nbe);
-        lwd->eval_mmat_mgga_vxc_uks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe);
+      if( deterministic ) {
+        EXC_task[iT] += EXC_local;
+        NEL_task[iT] += NEL_local;
+      } else {
+        // Atomic updates
+        #pragma omp atomic
+        EXC_WORK += EXC_local;
+        #pragma omp atomic
+        NEL_WORK += NEL_local;
       }
-    }
-    else if( func.is_gga() ) {
-      if(is_rks) {
-        lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe);
-      } else if(is_uks) {
-        lwd->eval_zmat_gga_vxc_uks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe);
-      } else if(is_gks) {
-        lwd->eval_zmat_gga_vxc_gks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe,
-                                K, H);
+
+      if(is_exc_only) continue;
+
+      // Evaluate Z matrix for VXC
+      if( func.is_mgga() ) {
+        if(is_rks) {
+          lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
+                                       dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+                                       dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe);
+          lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+                                       mmat_x, mmat_y, mmat_z, nbe);
+        } else if (is_uks) {
+          lwd->eval_zmat_mgga_vxc_uks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
+                                       dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+                                       dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe, zmat_z, nbe);
+          lwd->eval_mmat_mgga_vxc_uks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+                                       mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe);
+        }
       }
+      else if( func.is_gga() ) {
+        if(is_rks) {
+          lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe);
+        } else if(is_uks) {
+          lwd->eval_zmat_gga_vxc_uks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe, zmat_z, nbe);
+        } else if(is_gks) {
+          lwd->eval_zmat_gga_vxc_gks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe,
+                                  K, H);
+        }
        
-    } else {
-      if(is_rks) {
-        lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
-      } else if(is_uks) {
-        lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe );
-      } else if(is_gks) {
-        lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe, 
-                                    zmat_x, nbe, zmat_y, nbe, K);
+      } else {
+        if(is_rks) {
+          lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
+        } else if(is_uks) {
+          lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe );
+        } else if(is_gks) {
+          lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe, 
+                                      zmat_x, nbe, zmat_y, nbe, K);
+        }
       }
-    }
     
 
      
-    // Incremeta LT of VXC
-    {
+      // Drop shells with negligible VXC contributions, |VXC(mu,nu)| <=
+      // max|B_mu| sum_p |Z_nu(p)| + max|B_nu| sum_p |Z_mu(p)|
+      int32_t vnbe = nbe;
+      const submat_map_t* vsubmat_map = &submat_map;
+      value_type* vbasis_eval = basis_eval;
+      value_type* vzmat       = zmat;
+      value_type* vzmat_z     = zmat_z;
+      if( screen_shells ) {
+        auto& layout = host_data.shell_layout;
+        layout.assign( basis_map, shell_list_v );
+        host_data.shell_scr.resize( 3 * nshells );
+        host_data.shell_keep.resize( nshells );
+        auto* phi_max = host_data.shell_scr.data();
+        auto* z_sum   = phi_max + nshells;
+        auto* zz_sum  = z_sum   + nshells;
+        auto* keep    = host_data.shell_keep.data();
+        std::fill_n( phi_max, 3 * nshells, 0. );
+        layout.row_max( npts, basis_eval, nbe, phi_max );
+        layout.row_sum_max( npts, zmat, nbe, z_sum );
+        if( not is_rks ) {
+          layout.row_sum_max( npts, zmat_z, nbe, zz_sum );
+          for( int32_t s = 0; s < nshells; ++s ) z_sum[s] = std::max( z_sum[s], zz_sum[s] );
+        }
+        const auto phi_max_all = *std::max_element( phi_max, phi_max + nshells );
+        const auto z_sum_all   = *std::max_element( z_sum,   z_sum   + nshells );
+
+        for( int32_t s = 0; s < nshells; ++s )
+          keep[s] = phi_max[s] * z_sum_all + z_sum[s] * phi_max_all >= screen_tol;
+
+        vnbe = layout.nbe( keep );
+        if( vnbe and vnbe < nbe ) {
+          auto* scr = host_data.screen_scr.data();
+          vbasis_eval = scr;
+          vzmat       = vbasis_eval + npts*vnbe;
+          if( use_fp32 ) {
+            host_data.basis_eval_fp32_scr.resize( npts * vnbe );
+            layout.compact_rows( keep, npts, basis_eval_sp, nbe,
+              host_data.basis_eval_fp32_scr.data(), vnbe );
+          } else
+            layout.compact_rows( keep, npts, basis_eval, nbe, vbasis_eval, vnbe );
+          layout.compact_rows( keep, npts, zmat, nbe, vzmat, vnbe );
+          if( not is_rks ) {
+            vzmat_z = vzmat + npts*vnbe;
+            layout.compact_rows( keep, npts, zmat_z, nbe, vzmat_z, vnbe );
+          }
 
-      // Increment VXC
-      lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXCs, ldvxcs, nbe_scr );
-      if(not is_rks) {
-        lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat_z, nbe,VXCz, ldvxcz, nbe_scr);
-      }
-      if(is_gks) {
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_x, nbe, VXCy, ldvxcy,
-          nbe_scr);
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_y, nbe, VXCx, ldvxcx,
-          nbe_scr);
+          layout.kept_submat_map( keep, host_data.vsubmat_map );
+          vsubmat_map = &host_data.vsubmat_map;
+        } else if( not vnbe ) continue;
+        else vnbe = nbe;
       }
+     
+      // Incremeta LT of VXC
+      {
+
+        // Sub-batches of a split task increment the per-task blocks, unless the
+        // shell screening changed the basis layout of the sub-batch
+        const bool to_blk = vxc_block and vsubmat_map == &submat_map;
+        const submat_map_t& inc_map = to_blk ? block_map : *vsubmat_map;
+        const int32_t inc_nbf = to_blk ? nbe : nbf;
+        auto* Vs     = to_blk ? VXCs_blk : VXCs_acc.ptr();
+        auto* Vz     = to_blk ? VXCz_blk : VXCz_acc.ptr();
+        auto  ldvs   = to_blk ? nbe : VXCs_acc.ld();
+        auto  ldvz   = to_blk ? nbe : VXCz_acc.ld();
+        bool  atom_s = to_blk ? false : VXCs_acc.atomic();
+        bool  atom_z = to_blk ? false : VXCz_acc.atomic();
+
+        // Increment VXC
+        if( use_fp32 ) {
+          host_data.fp32_scr.resize( vnbe * (vnbe + npts) );
+          auto* fp32_scr       = host_data.fp32_scr.data();
+          auto* vbasis_eval_sp = vnbe < nbe ? host_data.basis_eval_fp32_scr.data() :
+                                              basis_eval_sp;
+
+          lwd->inc_vxc_fp32( npts, inc_nbf, vnbe, vbasis_eval_sp, inc_map, vzmat, vnbe,
+            Vs, ldvs, fp32_scr, atom_s );
+          if(not is_rks) {
+            lwd->inc_vxc_fp32( npts, inc_nbf, vnbe, vbasis_eval_sp, inc_map, vzmat_z, vnbe,
+              Vz, ldvz, fp32_scr, atom_z );
+          }
+        } else {
+          lwd->inc_vxc( mgga_dim_scal * npts, inc_nbf, vnbe, vbasis_eval, inc_map, vzmat, vnbe, 
+            Vs, ldvs, nbe_scr, atom_s );
+          if(not is_rks) {
+            lwd->inc_vxc( mgga_dim_scal * npts, inc_nbf, vnbe, vbasis_eval, inc_map, vzmat_z, vnbe,
+              Vz, ldvz, nbe_scr, atom_z );
+          }
+        }
+        if(is_gks) {
+          if( vxc_block ) {
+            lwd->inc_vxc( npts, nbe, nbe, basis_eval, block_map, zmat_x, nbe, 
+              VXCy_blk, nbe, nbe_scr, false );
+            lwd->inc_vxc( npts, nbe, nbe, basis_eval, block_map, zmat_y, nbe, 
+              VXCx_blk, nbe, nbe_scr, false );
+          } else {
+            lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_x, nbe, 
+              VXCy_acc.ptr(), VXCy_acc.ld(), nbe_scr, VXCy_acc.atomic() );
+            lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_y, nbe, 
+              VXCx_acc.ptr(), VXCx_acc.ld(), nbe_scr, VXCx_acc.atomic() );
+          }
+        }
        
+      }
+
+    } // Loop over sub-batches
+
+    // Scatter the per-task VXC blocks
+    if( vxc_block ) {
+      auto scatter_block = [&]( auto& acc, const value_type* blk ) {
+        if( acc.atomic() )
+          detail::inc_by_submat_atomic( nbf, nbf, nbe, nbe, acc.ptr(), acc.ld(),
+            blk, nbe, submat_map );
+        else
+          detail::inc_by_submat( nbf, nbf, nbe, nbe, acc.ptr(), acc.ld(),
+            blk, nbe, submat_map );
+      };
+      scatter_block( VXCs_acc, VXCs_blk );
+      if( not is_rks ) scatter_block( VXCz_acc, VXCz_blk );
+      if( is_gks ) {
+        scatter_block( VXCy_acc, VXCy_blk );
+        scatter_block( VXCx_acc, VXCx_blk );
+      }
     }
 
   } // Loop over tasks
 
   } // End OpenMP region
 
+  task_timings.commit( task_begin );
+
+  // Reduce thread private integrands (LT only)
+  VXCs_acc.finalize('L');
+  VXCz_acc.finalize('L');
+  VXCy_acc.finalize('L');
+  VXCx_acc.finalize('L');
+
+  if( deterministic ) {
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      EXC_WORK += EXC_task[iT];
+      NEL_WORK += NEL_task[iT];
+    }
+  }
 
   // Set scalar return values
   *EXC  = EXC_WORK;
   *N_EL = NEL_WORK;
 
-  if(not is_exc_only) {
+  // Packed mode defers the symmetrization to the final unpack
+  if(not is_exc_only and not ks_settings.packed_vxc) {
     // Symmetrize VXC
     for( int32_t j = 0;   j < nbf; ++j ) {
       for( int32_t i = j+1; i < nbf; ++i ) {
@@ -0,0 +1,287 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
+#include "host/blas.hpp"
+#include "host_matrix_accumulator.hpp"
+#include <limits>
+#include <cmath>
+
+namespace GauXC::detail {
+
+/**
+ *  Incremental RKS EXC/VXC (LDA/GGA)
+ *
+ *  VXC = VXC(prev) + sum_{rebuilt tasks} [ Z(new) - Z(old) ] contributions.
+ *  The density, functional and EXC / N_EL are evaluated for every task from
+ *  the full density matrix. The VXC contribution of a task is rebuilt if the
+ *  max-norm change of its density matrix block, accumulated over the calls
+ *  in which it was reused, exceeds ks_settings.incremental_vxc_tol. The
+ *  first call (or any call after the task list changed) rebuilds every task.
+ */
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_incremental_local_work_( const basis_type& basis, const value_type* P,
+                                   int64_t ldp, value_type* VXC, int64_t ldvxc,
+                                   value_type* EXC, value_type *N_EL,
+                                   const IntegratorSettingsKS& ks_settings,
+                                   task_iterator task_begin, task_iterator task_end ) {
+
+  const auto host_acc    = ks_settings.host_accumulation;
+  const auto host_acc_max_bytes = ks_settings.host_accumulation_max_bytes;
+  const bool deterministic = host_acc == HostAccumulation::ThreadPrivate and
+                             ks_settings.deterministic_accumulation;
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& mol   = this->load_balancer_->molecule();
+  const bool  is_gga = func.is_gga();
+  const int32_t nbf = basis.nbf();
+
+  // Sort tasks on size and reuse the per-task setup of previous calls
+  this->plan_.prepare( this->tasks_generation_( task_begin, task_end ), basis,
+    mol, task_begin, task_end );
+
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
+
+  const size_t ntasks = std::distance(task_begin, task_end);
+
+  // (Re)initialize the incremental state if it does not refer to this plan
+  auto& state = this->incremental_vxc_;
+  const bool rebuild_all = not state.valid or
+    state.generation != this->plan_.generation() or state.nbf != nbf or
+    state.is_gga != is_gga;
+  if( rebuild_all ) {
+    state.clear();
+    state.generation = this->plan_.generation();
+    state.nbf        = nbf;
+    state.is_gga     = is_gga;
+    state.P    .assign( nbf * nbf, 0. );
+    state.VXC  .assign( nbf * nbf, 0. );
+    state.coeff.resize( ntasks );
+    state.exc  .assign( ntasks, 0. );
+    state.nel  .assign( ntasks, 0. );
+    state.drift.assign( ntasks, 0. );
+    state.valid = true;
+  }
+
+  // Start from the previous (lower triangle of the) local VXC
+  for( int32_t j = 0; j < nbf; ++j )
+  for( int32_t i = j; i < nbf; ++i )
+    VXC[i + j*ldvxc] = state.VXC[i + j*nbf];
+
+  const auto tol = ks_settings.incremental_vxc_tol;
+
+  HostMatrixAccumulator<value_type> VXC_acc( host_acc, nbf, nbf, VXC, ldvxc, host_acc_max_bytes );
+  ScopedHostTaskSchedule task_schedule( deterministic );
+
+  // Collocation (basis + gradient) reused across calls
+  const size_t colloc_ncomp = is_gga ? 4 : 1;
+  this->colloc_cache_.configure( ks_settings.collocation_cache_bytes,
+    ks_settings.collocation_cache_storage );
+  this->colloc_cache_.prepare( this->tasks_generation_( task_begin, task_end ),
+    basis, task_begin, task_end, colloc_ncomp, true );
+
+  this->prepare_host_data_();
+
+  #pragma omp parallel
+  {
+
+  auto& host_data = this->thread_host_data_(); // Thread local host data
+
+  #pragma omp for schedule(runtime)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = *(task_begin + iT);
+
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
+    const auto& submat_map = this->plan_.submat_map( iT );
+
+    // Screen the VXC rebuild on the change of the density matrix block of
+    // this task (the density and functional are always evaluated)
+    bool skip_vxc = false;
+    if( not rebuild_all ) {
+      value_type dP_max = 0.;
+      for( const auto& col : submat_map )
+      for( int32_t j = col[0]; j < col[0] + col[1]; ++j )
+      for( const auto& row : submat_map )
+      for( int32_t i = row[0]; i < row[0] + row[1]; ++i ) {
+        dP_max = std::max( dP_max,
+          std::abs( P[i + j*ldp] - state.P[i + j*nbf] ) );
+      }
+
+      skip_vxc = state.drift[iT] + dP_max < tol;
+      state.drift[iT] = skip_vxc ? state.drift[iT] + dP_max : 0.;
+    }
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+    const int32_t  nshells = task.bfn_screening.shell_list.size();
+
+    const auto* points      = task.points.data()->data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
+    const int32_t* shell_list = task.bfn_screening.shell_list.data();
+
+    // Allocate enough memory for batch
+    const size_t ncoeff = is_gga ? 4 : 1;
+    host_data.nbe_scr    .resize( nbe * nbe );
+    host_data.zmat       .resize( npts * nbe );
+    host_data.eps        .resize( npts );
+    host_data.vrho       .resize( npts );
+    host_data.basis_eval .resize( colloc_ncomp * npts * nbe );
+    host_data.den_scr    .resize( ncoeff * npts );
+    host_data.gamma      .resize( npts );
+    host_data.vgamma     .resize( 3 * npts );
+
+    // Alias/Partition out scratch memory
+    auto* basis_eval = host_data.basis_eval.data();
+    auto* den_eval   = host_data.den_scr.data();
+    auto* nbe_scr    = host_data.nbe_scr.data();
+    auto* zmat       = host_data.zmat.data();
+    auto* eps        = host_data.eps.data();
+    auto* gamma      = host_data.gamma.data();
+    auto* vrho       = host_data.vrho.data();
+    auto* vgamma     = host_data.vgamma.data();
+
+    value_type* dbasis_x_eval = nullptr;
+    value_type* dbasis_y_eval = nullptr;
+    value_type* dbasis_z_eval = nullptr;
+    value_type* dden_x_eval   = nullptr;
+    value_type* dden_y_eval   = nullptr;
+    value_type* dden_z_eval   = nullptr;
+    if( is_gga ) {
+      dbasis_x_eval = basis_eval    + npts * nbe;
+      dbasis_y_eval = dbasis_x_eval + npts * nbe;
+      dbasis_z_eval = dbasis_y_eval + npts * nbe;
+      dden_x_eval   = den_eval    + npts;
+      dden_y_eval   = dden_x_eval + npts;
+      dden_z_eval   = dden_y_eval + npts;
+    }
+
+    // Evaluate Collocation (+ Grad)
+    const size_t colloc_len = npts * nbe;
+    if( not this->colloc_cache_.load( iT, colloc_ncomp, colloc_len, basis_eval ) ) {
+      if( is_gga )
+        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+      else
+        lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, &host_data.arena );
+      this->colloc_cache_.store( iT, colloc_ncomp, colloc_len, basis_eval );
+    }
+
+    // Evaluate X matrix (2 * P * B) -> store in Z
+    lwd->eval_xmat( npts, nbf, nbe, submat_map, 2.0, P, ldp, basis_eval, nbe,
+      zmat, nbe, nbe_scr );
+
+    // Evaluate U and V variables + XC functional
+    if( is_gga ) {
+      lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+        dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+        gamma );
+      func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+    } else {
+      lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, zmat, nbe, den_eval );
+      func.eval_exc_vxc( npts, den_eval, eps, vrho );
+    }
+
+    // Scalar integrations
+    double NEL_local = 0.0;
+    double EXC_local = 0.0;
+    for( int32_t i = 0; i < npts; ++i ) {
+      NEL_local += weights[i] * den_eval[i];
+      EXC_local += weights[i] * eps[i] * den_eval[i];
+    }
+    state.exc[iT] = EXC_local;
+    state.nel[iT] = NEL_local;
+
+    // Reuse the previous VXC contribution of this task
+    if( skip_vxc ) continue;
+
+    // Weighted potential coefficients of this build, form the difference to
+    // the previous build in place (A -> vrho, B -> vgamma)
+    auto& coeff = state.coeff[iT];
+    if( coeff.size() != ncoeff * npts ) coeff.assign( ncoeff * npts, 0. );
+    for( int32_t i = 0; i < npts; ++i ) {
+      const auto A_new = weights[i] * vrho[i];
+      vrho[i]  = A_new - coeff[i];
+      coeff[i] = A_new;
+    }
+    if( is_gga ) {
+      auto* B_old = coeff.data() + npts;
+      for( int32_t i = 0; i < npts; ++i ) {
+        const auto fact = 2. * weights[i] * vgamma[i];
+        const value_type B_new[3] = { fact * dden_x_eval[i],
+          fact * dden_y_eval[i], fact * dden_z_eval[i] };
+        for( int k = 0; k < 3; ++k ) {
+          vgamma[3*i + k]  = B_new[k] - B_old[3*i + k];
+          B_old[3*i + k]   = B_new[k];
+        }
+      }
+    }
+
+    // Evaluate Z matrix of the VXC difference
+    if( is_gga )
+      lwd->eval_zmat_gga_vxc_rks_ts( npts, nbe, vrho, vgamma, basis_eval,
+        dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, zmat, nbe );
+    else
+      lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
+
+    // Increment LT of VXC
+    lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat, nbe,
+      VXC_acc.ptr(), VXC_acc.ld(), nbe_scr, VXC_acc.atomic() );
+
+  } // Loop over tasks
+
+  } // End OpenMP region
+
+  // Reduce thread private integrands (LT only)
+  VXC_acc.finalize('L');
+
+  // Scalar results are summed in task order from the per-task state
+  double EXC_WORK = 0.0;
+  double NEL_WORK = 0.0;
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    EXC_WORK += state.exc[iT];
+    NEL_WORK += state.nel[iT];
+  }
+  *EXC  = EXC_WORK;
+  *N_EL = NEL_WORK;
+
+  // Symmetrize VXC and save the local VXC / density for the next call
+  for( int32_t j = 0;   j < nbf; ++j ) {
+    for( int32_t i = j+1; i < nbf; ++i ) {
+      VXC[ j + i*ldvxc ] = VXC[ i + j*ldvxc ];
+    }
+  }
+
+  for( int32_t j = 0; j < nbf; ++j )
+  for( int32_t i = 0; i < nbf; ++i ) {
+    state.VXC[i + j*nbf] = VXC[i + j*ldvxc];
+    state.P  [i + j*nbf] = P  [i + j*ldp  ];
+  }
+
+}
+
+}
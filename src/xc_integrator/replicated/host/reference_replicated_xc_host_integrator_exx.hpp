@@ -17,6 +17,9 @@
 #include "integrator_util/exx_screening.hpp"
 #include "host/local_host_work_driver.hpp"
 #include "host/blas.hpp"
+#include "host_matrix_accumulator.hpp"
+#include "host_task_timings.hpp"
+#include "host_task_weights.hpp"
 #include <stdexcept>
 #include <set>
 
@@ -297,11 +300,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   std::sort( tasks.begin(), tasks.end(), task_comparator );
 
 
-  // Check that Partition Weights have been calculated
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified"); 
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
   // Zero out integrands
   for( auto j = 0; j < nbf; ++j )
@@ -345,6 +345,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const double eps_K   = sn_link_settings.k_tol;
   const double eps_E   = sn_link_settings.energy_tol;
 
+  const auto host_acc    = sn_link_settings.host_accumulation;
+  const auto host_acc_max_bytes = sn_link_settings.host_accumulation_max_bytes;
+  const bool deterministic = host_acc == HostAccumulation::ThreadPrivate and 
+                             sn_link_settings.deterministic_accumulation;
+
   int world_rank = 0;
   #ifdef GAUXC_HAS_MPI
   auto comm = this->load_balancer_->runtime().comm();
@@ -361,11 +366,14 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Reset the coulomb screening data
   for(auto& task : tasks) task.cou_screening = XCTask::screening_data();
 
-  // Precompute EK shell screening
+  // Precompute EK shell screening (tasks with on-the-fly weights carry their
+  // unpartitioned weights, which only make the screening more conservative)
   exx_ek_screening( basis, basis_map, shpairs, P_abs.data(), nbf, V_max.data(), 
     nshells_bf, eps_E, eps_K, lwd, tasks.begin(), tasks.end() );
 
-  // Allow for merging of tasks with different iParent
+  // Allow for merging of tasks with different iParent (on-the-fly weights
+  // are partitioned per parent atom, only tasks of equal iParent are merged)
+  if( not task_weights.on_the_fly() )
   for(auto& task : tasks) task.iParent = 0;
 
 #if 1
@@ -426,6 +434,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   cur_uniq_it++;
 
   tasks = std::move(local_work_unique);
+  this->load_balancer_->mark_tasks_modified();
 #endif
 
   std::sort(tasks.begin(),tasks.end(),
@@ -437,19 +446,33 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const size_t ntasks = tasks.size();
   //std::cout << "NTASKS = " << ntasks << std::endl;
   //std::cout << "NTASKS NNZ = " << std::count_if(tasks.begin(),tasks.end(),[](const auto& t){ return t.cou_screening.shell_pair_list.size(); }) << std::endl;
+  // Accumulation target for K
+  HostMatrixAccumulator<value_type> K_acc( host_acc, nbf, nbf, K, ldk, host_acc_max_bytes );
+  ScopedHostTaskSchedule task_schedule( deterministic );
+
+  // Per-task wall times for the measured cost model
+  HostTaskTimings task_timings( this->load_balancer_->cost_model(),
+    { TaskCostClass::EXX, TaskCostSpin::RKS }, ntasks );
+
+  this->prepare_host_data_();
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
-  std::vector<double> K_local(nbf*nbf,0.0);
+  auto& host_data = this->thread_host_data_(); // Thread local host data
 
-  #pragma omp for schedule(dynamic)
+  #pragma omp for schedule(runtime)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
 
+    auto task_timer = task_timings.time( iT );
+
     //std::cout << iT << "/" << ntasks << std::endl;
     // Alias current task
     const auto& task = tasks[iT];
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Early exit
     auto ek_shell_list = task.cou_screening.shell_list;
     if( ek_shell_list.size() == 0 ) {
@@ -463,7 +486,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const int32_t  npts    = task.points.size();
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
 
     // Basis function shell list
     auto shell_list_bfn_ = task.bfn_screening.shell_list;
@@ -489,7 +512,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Evaluate collocation B(mu,i)
     // mu ranges over the bfn shell list and i runs over all points
     lwd->eval_collocation( npts, nshells_bfn, nbe_bfn, points, basis, 
-      shell_list_bfn, basis_eval );
+      shell_list_bfn, basis_eval, &host_data.arena );
 
     const auto nbe_ek = basis.nbf_subset( ek_shell_list.begin(), ek_shell_list.end() );
     const auto nshells_ek = ek_shell_list.size();
@@ -527,13 +550,19 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // nu runs over ek shells
     // i runs over all points
     lwd->inc_exx_k( npts, nbf, nbe_bfn, nbe_ek, basis_eval, submat_map_bfn,
-      ek_submat_map, gmat, nbe_ek, K, ldk, nbe_scr );
+      ek_submat_map, gmat, nbe_ek, K_acc.ptr(), K_acc.ld(), nbe_scr, 
+      K_acc.atomic() );
 
   } // Loop over tasks 
 
 
   } // End OpenMP region
 
+  task_timings.commit( tasks.begin() );
+
+  // Reduce thread private K
+  K_acc.finalize();
+
   // Symmetrize K
   for( auto j = 0; j < nbf; ++j ) 
   for( auto i = 0; i < j;   ++i ) {
@@ -14,7 +14,10 @@
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
 #include "host/blas.hpp"
+#include "host_matrix_accumulator.hpp"
+#include "host_packed_matrix.hpp"
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -73,6 +76,32 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   });
 
 
+  // Packed mode: local work only provides the lower triangles of FXC, which
+  // are reduced (together with N_EL) in a single packed buffer
+  const auto* ks_ptr = dynamic_cast<const IntegratorSettingsKS*>(&ks_settings);
+  if( ks_ptr and ks_ptr->packed_vxc ) {
+
+    const size_t npacked = packed_lower_size(nbf);
+    const size_t nmat    = FXCz ? 2 : 1;
+    std::vector<value_type> packed( nmat * npacked + 1 );
+    pack_lower( nbf, FXCs, ldfxcs, packed.data() );
+    if( FXCz ) pack_lower( nbf, FXCz, ldfxcz, packed.data() + npacked );
+    packed[nmat*npacked] = N_EL;
+
+    this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+      if( not this->reduction_driver_->takes_host_memory() )
+        GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+      this->reduction_driver_->allreduce_inplace( packed.data(), packed.size(),
+        ReductionOp::Sum );
+    });
+
+    unpack_lower_symmetric( nbf, packed.data(), FXCs, ldfxcs );
+    if( FXCz ) unpack_lower_symmetric( nbf, packed.data() + npacked, FXCz, ldfxcz );
+    N_EL = packed[nmat*npacked];
+    return;
+
+  }
+
   // Reduce Results
   this->timer_.time_op("XCIntegrator.Allreduce", [&](){
 
@@ -109,6 +138,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     ks_settings = *tmp;
   }
 
+  const auto host_acc    = ks_settings.host_accumulation;
+  const auto host_acc_max_bytes = ks_settings.host_accumulation_max_bytes;
+  const bool deterministic = host_acc == HostAccumulation::ThreadPrivate and 
+                             ks_settings.deterministic_accumulation;
+
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
 
@@ -122,24 +156,16 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("Laplacian Not Supported Yet for FXC Contraction");
   }
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
 
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( task_begin, task_end, task_comparator );
+  this->plan_.prepare( this->tasks_generation_( task_begin, task_end ), basis,
+    mol, task_begin, task_end );
+  const auto& basis_map = this->plan_.basis_map();
 
-  // Check that Partition Weights have been calculated
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
 
   // Zero out integrands
@@ -164,12 +190,32 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Loop over tasks
   const size_t ntasks = std::distance(task_begin, task_end);
 
+  // Accumulation targets for the integrands
+  HostMatrixAccumulator<value_type> FXCa_acc( host_acc, nbf, nbf, FXCa, ldfxca, host_acc_max_bytes );
+  HostMatrixAccumulator<value_type> FXCb_acc( host_acc, nbf, nbf, FXCb, ldfxcb, host_acc_max_bytes );
+
+  // Per-task scalar contributions (summed in task order if deterministic)
+  std::vector<double> NEL_task;
+  if( deterministic ) NEL_task.resize(ntasks);
+
+  ScopedHostTaskSchedule task_schedule( deterministic );
+
+  // Collocation (basis + derivatives) reused across calls
+  const size_t colloc_ncomp = func.is_lda() ? 1 : 
+                              (func.is_mgga() and needs_laplacian) ? 5 : 4;
+  this->colloc_cache_.configure( ks_settings.collocation_cache_bytes,
+    ks_settings.collocation_cache_storage );
+  this->colloc_cache_.prepare( this->tasks_generation_( task_begin, task_end ),
+    basis, task_begin, task_end, colloc_ncomp, true );
+
+  this->prepare_host_data_();
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
 
-  #pragma omp for schedule(dynamic)
+  #pragma omp for schedule(runtime)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
      
     //std::cout << iT << "/" << ntasks << std::endl;
@@ -177,13 +223,16 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     const auto& task = *(task_begin + iT);
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
     const int32_t  nshells = task.bfn_screening.shell_list.size();
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
     // Allocate enough memory for batch
@@ -246,7 +295,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       host_data.FXC_C          .resize(npts * spin_dim_scal);
 
       if ( needs_laplacian ) {
-        host_data.basis_eval .resize( 11 * npts * nbe ); // basis + grad (3) + hess (6) + lapl 
+        host_data.basis_eval .resize( 5 * npts * nbe ); // basis + grad (3) + lapl
         host_data.lapl       .resize( spin_dim_scal * npts );
         host_data.vlapl      .resize( spin_dim_scal * npts );
         host_data.v2lapl2    .resize(npts * spin_dim_rhorho);
@@ -303,12 +352,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     value_type* dbasis_x_eval = nullptr;
     value_type* dbasis_y_eval = nullptr;
     value_type* dbasis_z_eval = nullptr;
-    value_type* d2basis_xx_eval = nullptr;
-    value_type* d2basis_xy_eval = nullptr;
-    value_type* d2basis_xz_eval = nullptr;
-    value_type* d2basis_yy_eval = nullptr;
-    value_type* d2basis_yz_eval = nullptr;
-    value_type* d2basis_zz_eval = nullptr;
     value_type* lbasis_eval = nullptr;
     value_type* dden_x_eval = nullptr;
     value_type* dden_y_eval = nullptr;
@@ -340,13 +383,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       mmat_y        = mmat_x + npts * nbe;
       mmat_z        = mmat_y + npts * nbe;
       if ( needs_laplacian ) {
-        d2basis_xx_eval = dbasis_z_eval + npts * nbe;
-        d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
-        d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
-        d2basis_yy_eval = d2basis_xz_eval + npts * nbe;
-        d2basis_yz_eval = d2basis_yy_eval + npts * nbe;
-        d2basis_zz_eval = d2basis_yz_eval + npts * nbe;
-        lbasis_eval     = d2basis_zz_eval + npts * nbe;
+        lbasis_eval = dbasis_z_eval + npts * nbe;
       }
       if(is_uks) {
         mmat_x_z = zmat_z + npts * nbe;
@@ -357,33 +394,29 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 
     // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
-
-    // Evaluate Collocation (+ Grad and Hessian)
-    if( func.is_mgga() ) {
-      if ( needs_laplacian ) {
-        // TODO: Modify gau2grid to compute Laplacian instead of full hessian
-        lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-          d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-          d2basis_zz_eval);
-        blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
-        blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
-        blas::axpy( nbe * npts, 1., d2basis_zz_eval, 1, lbasis_eval, 1);
-      } else {
-        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    const auto& submat_map = this->plan_.submat_map( iT );
+
+    // Evaluate Collocation (+ Grad and Laplacian)
+    const size_t colloc_len = npts * nbe;
+    if( not this->colloc_cache_.load( iT, colloc_ncomp, colloc_len, basis_eval ) ) {
+      if( func.is_mgga() ) {
+        if ( needs_laplacian ) {
+          lwd->eval_collocation_laplacian( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval, &host_data.arena );
+        } else {
+          lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+        }
       }
+      // Evaluate Collocation (+ Grad)
+      else if( func.is_gga() )
+        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, &host_data.arena );
+      else
+        lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, &host_data.arena );
+      this->colloc_cache_.store( iT, colloc_ncomp, colloc_len, basis_eval );
     }
-    // Evaluate Collocation (+ Grad)
-    else if( func.is_gga() )
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
-    else
-      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval );
 
      
     // Evaluate X matrix (fac * P * B) -> store in Z
@@ -526,9 +559,13 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 
 
-    // Atomic updates
-    #pragma omp atomic
-    NEL_WORK += NEL_local;
+    if( deterministic ) {
+      NEL_task[iT] = NEL_local;
+    } else {
+      // Atomic updates
+      #pragma omp atomic
+      NEL_WORK += NEL_local;
+    }
     // Evaluate Z matrix for VXC
     if( func.is_mgga() ) {
       if(is_rks) {
@@ -566,33 +603,44 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     {
 
       // Increment VXC
-      lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, FXCa, ldfxca, nbe_scr );
+      lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, 
+        FXCa_acc.ptr(), FXCa_acc.ld(), nbe_scr, FXCa_acc.atomic() );
       if( not is_rks )
-        lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat_z, nbe, FXCb, ldfxcb, nbe_scr);
+        lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat_z, nbe, 
+          FXCb_acc.ptr(), FXCb_acc.ld(), nbe_scr, FXCb_acc.atomic() );
     }
 
   } // Loop over tasks
 
   } // End OpenMP region
 
+  // Reduce thread private integrands (LT only)
+  FXCa_acc.finalize('L');
+  FXCb_acc.finalize('L');
+
+  if( deterministic ) 
+    for( size_t iT = 0; iT < ntasks; ++iT ) NEL_WORK += NEL_task[iT];
 
   // Set scalar return values
   *N_EL = NEL_WORK;
 
+  // Packed mode defers the symmetrization to the final unpack
+  if( not ks_settings.packed_vxc ) {
     // Symmetrize VXC
-  for( int32_t j = 0;   j < nbf; ++j ) 
-    for( int32_t i = j+1; i < nbf; ++i ) 
-      FXCa[ j + i*ldfxca ] = FXCa[ i + j*ldfxca ];
-      
-  if ( FXCz )
     for( int32_t j = 0;   j < nbf; ++j ) 
       for( int32_t i = j+1; i < nbf; ++i ) 
-        FXCb[ j + i*ldfxcb ] = FXCb[ i + j*ldfxcb ];
+        FXCa[ j + i*ldfxca ] = FXCa[ i + j*ldfxca ];
+      
+    if ( FXCz )
+      for( int32_t j = 0;   j < nbf; ++j ) 
+        for( int32_t i = j+1; i < nbf; ++i ) 
+          FXCb[ j + i*ldfxcb ] = FXCb[ i + j*ldfxcb ];
+  }
 
   if( FXCz ) 
-    // now convert to the final form of FXCs and FXCz
+    // now convert to the final form of FXCs and FXCz (LT only if packed)
     for ( int32_t j = 0;   j < nbf; ++j ) 
-      for( int32_t i = 0; i < nbf; ++i ) {
+      for( int32_t i = ks_settings.packed_vxc ? j : 0; i < nbf; ++i ) {
         value_type tmp_a = FXCa[ i + j*ldfxca ];
         value_type tmp_b = FXCb[ i + j*ldfxcb ];
         FXCs[ i + j*ldfxcs ] = 0.5 * ( tmp_a + tmp_b );
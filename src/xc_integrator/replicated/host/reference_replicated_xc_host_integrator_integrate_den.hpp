@@ -14,6 +14,7 @@
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host_task_weights.hpp"
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -69,35 +70,33 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const auto& basis = this->load_balancer_->basis();
   const auto& mol   = this->load_balancer_->molecule();
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
 
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
-
+  // Sort tasks on size and reuse the per-task setup of previous calls
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( tasks.begin(), tasks.end(), task_comparator );
+  this->plan_.prepare( this->load_balancer_->tasks_generation(), basis, mol,
+    tasks.begin(), tasks.end() );
+  const auto& basis_map = this->plan_.basis_map();
 
 
-  // Compute Partition Weights
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified"); 
-  }
+  // Partition weights (stored or on-the-fly)
+  HostTaskWeights task_weights( lwd, *this->load_balancer_ );
 
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
   double N_EL_WORK = 0.0;
 
+  // Reuse cached collocation (the cache is only configured by KS calls)
+  this->colloc_cache_.prepare( this->load_balancer_->tasks_generation(), basis,
+    tasks.begin(), tasks.end(), 1, false );
+
+  this->prepare_host_data_();
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& host_data = this->thread_host_data_(); // Thread local host data
   double N_EL_LOCAL = 0.;
 
   #pragma omp for schedule(dynamic)
@@ -107,13 +106,16 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     const auto& task = tasks[iT];
 
+    // Tasks without basis support only retain their points / weights
+    if( task.bfn_screening.shell_list.empty() ) continue;
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
     const int32_t  nshells = task.bfn_screening.shell_list.size();
 
     const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
+    const auto* weights     = task_weights( task, host_data.part_weights );
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
     // Allocate enough memory for batch
@@ -133,13 +135,14 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 
     // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
+    const auto& submat_map = this->plan_.submat_map( iT );
 
     // Evaluate Collocation (+ Grad)
-    lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
-      basis_eval );
+    if( not this->colloc_cache_.load( iT, 1, npts * nbe, basis_eval ) ) {
+      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
+        basis_eval, &host_data.arena );
+      this->colloc_cache_.store( iT, 1, npts * nbe, basis_eval );
+    }
 
 
     // Evaluate X matrix (P * B) -> store in Z
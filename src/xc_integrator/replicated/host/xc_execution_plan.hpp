@@ -0,0 +1,121 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset_map.hpp>
+#include <gauxc/molecule.hpp>
+#include <gauxc/xc_task.hpp>
+#include "integrator_util/integrator_common.hpp"
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+
+namespace GauXC  {
+namespace detail {
+
+/** Reusable setup of the replicated host task loops
+ *
+ *  Holds the state which only depends on the LoadBalancer (and not on the
+ *  density or functional), such that repeated integrator calls over the same
+ *  tasks skip it entirely:
+ *    - the cost ordering of the task list,
+ *    - the BasisSetMap of the (basis, molecule) pair,
+ *    - the compressed submatrix map of every task.
+ *
+ *  The plan is keyed on the LoadBalancer task generation (process-wide
+ *  unique, see LoadBalancer::tasks_generation) and rebuilt whenever the
+ *  tasks are bound with a different (or no) generation. Callers which modify
+ *  tasks in place must LoadBalancer::mark_tasks_modified.
+ */
+class XCExecutionPlan {
+
+public:
+
+  using submat_map_t = std::vector< std::array<int32_t, 3> >;
+
+  /// Strict, content-based total order on tasks (decreasing npts x nbe)
+  static bool task_order( const XCTask& a, const XCTask& b ) {
+    const auto ca = a.points.size() * a.bfn_screening.nbe;
+    const auto cb = b.points.size() * b.bfn_screening.nbe;
+    if( ca != cb ) return ca > cb;
+    if( a.iParent != b.iParent ) return a.iParent < b.iParent;
+    if( a.points.size() != b.points.size() )
+      return a.points.size() < b.points.size();
+    if( a.points.empty() ) return false;
+    return a.points.front() < b.points.front();
+  }
+
+private:
+
+  size_t                       tasks_generation_ = 0; ///< Of the bound tasks
+  std::unique_ptr<BasisSetMap> basis_map_;
+  std::vector<submat_map_t>    submat_maps_;
+  size_t                       generation_ = 0;
+
+public:
+
+  /** Bind the plan to a task range (call outside of parallel regions)
+   *
+   *  @param[in] tasks_generation LoadBalancer task generation of the range
+   *                             (0 if it is not the LoadBalancer's local
+   *                             tasks, the plan is then always rebuilt)
+   *
+   *  Sorts [task_begin, task_end) into task_order (skipped if already
+   *  sorted) and rebuilds the per-task data unless the plan was built for
+   *  the same task generation (the order within a generation is fixed).
+   */
+  template <typename TaskIterator>
+  void prepare( size_t tasks_generation, const BasisSet<double>& basis,
+    const Molecule& mol, TaskIterator task_begin, TaskIterator task_end ) {
+
+    bool stale = tasks_generation == 0 or tasks_generation != tasks_generation_;
+    if( not std::is_sorted( task_begin, task_end, task_order ) ) {
+      std::sort( task_begin, task_end, task_order );
+      stale = true;
+    }
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    if( not stale and submat_maps_.size() == ntasks ) return;
+
+    basis_map_ = std::make_unique<BasisSetMap>( basis, mol );
+    tasks_generation_ = tasks_generation;
+    ++generation_;
+
+    const int32_t nbf = basis.nbf();
+    submat_maps_.resize( ntasks );
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      const auto& task = *(task_begin + iT);
+      std::tie( submat_maps_[iT], std::ignore ) =
+        gen_compressed_submat_map( *basis_map_, task.bfn_screening.shell_list,
+          nbf, nbf );
+    }
+
+  }
+
+  /// Incremented whenever the per-task data is rebuilt (state derived from
+  /// the task order must be discarded when this changes)
+  inline size_t generation() const { return generation_; }
+
+  inline const BasisSetMap&  basis_map() const { return *basis_map_; }
+  inline const submat_map_t& submat_map( size_t iT ) const {
+    return submat_maps_[iT];
+  }
+
+};
+
+}
+}
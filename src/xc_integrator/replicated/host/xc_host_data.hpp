@@ -12,51 +12,160 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include <algorithm>
 
 #include <gauxc/gauxc_config.hpp>
+#include "xc_data/host_arena.hpp"
+#include "host_shell_screening.hpp"
 
 namespace GauXC {
 
+/** Scratch array carved out of a host_arena
+ *
+ *  Mimics the subset of the std::vector interface used by the host
+ *  integrators. `resize` never initializes memory and only draws from the
+ *  arena when the requested size exceeds the current capacity. The previous
+ *  block is then returned to the arena (grown in place if it is the most
+ *  recent allocation) and its contents are not preserved. The capacity
+ *  reached before a `release` is drawn at once on the next first use, such
+ *  that repeated integrations do not grow the arena.
+ */
+template <typename F>
+class host_scratch {
+
+  host_arena* arena_    = nullptr;
+  F*          ptr_      = nullptr;
+  size_t      size_     = 0;
+  size_t      capacity_ = 0;
+  size_t      hint_     = 0; ///< Capacity prior to the last release
+
+public:
+
+  host_scratch() = default;
+  host_scratch( host_arena* arena ) : arena_(arena) { }
+
+  inline void resize( size_t n ) {
+    if( n > capacity_ ) {
+      const size_t cap = ptr_ ? n : std::max( n, hint_ );
+      ptr_      = arena_->template reallocate<F>( ptr_, capacity_, cap );
+      capacity_ = cap;
+    }
+    size_ = n;
+  }
+
+  /// Drop the arena storage (must precede host_arena::reset)
+  inline void release() {
+    hint_ = std::max( hint_, capacity_ );
+    ptr_  = nullptr;
+    size_ = capacity_ = 0;
+  }
+
+  inline F*       data()       { return ptr_; }
+  inline const F* data() const { return ptr_; }
+  inline size_t   size() const { return size_; }
+
+  inline F&       operator[]( size_t i )       { return ptr_[i]; }
+  inline const F& operator[]( size_t i ) const { return ptr_[i]; }
+
+};
+
+/// Thread local scratch data for the host integrators
 template <typename F>
 struct XCHostData {
 
-  std::vector<F> eps;
-  std::vector<F> gamma;
-  std::vector<F> tau;
-  std::vector<F> lapl;
-  std::vector<F> vrho;
-  std::vector<F> vgamma;
-  std::vector<F> vtau;
-  std::vector<F> vlapl;
+  host_arena arena; ///< Backing storage for all scratch arrays
+
+  host_scratch<F> eps;
+  host_scratch<F> gamma;
+  host_scratch<F> tau;
+  host_scratch<F> lapl;
+  host_scratch<F> vrho;
+  host_scratch<F> vgamma;
+  host_scratch<F> vtau;
+  host_scratch<F> vlapl;
  
-  std::vector<F> zmat;
-  std::vector<F> gmat;
-  std::vector<F> nbe_scr;
-  std::vector<F> den_scr;
-  std::vector<F> basis_eval;
+  host_scratch<F> zmat;
+  host_scratch<F> gmat;
+  host_scratch<F> nbe_scr;
+  host_scratch<F> den_scr;
+  host_scratch<F> basis_eval;
+  host_scratch<F> shell_basis_eval; ///< Collocation derivatives of a single shell
+  host_scratch<F> ylm_scr;
+  host_scratch<F> screen_scr;
+  host_scratch<F> shell_scr;    ///< Per-shell norms of the screened shells
+  host_scratch<F> weights_scr;
+  host_scratch<int32_t> point_keep; ///< Indices of the points kept by compaction
+  host_scratch<F> part_weights; ///< On-the-fly partitioned task weights
+  host_scratch<F> vxc_blk;      ///< Per-task VXC blocks of sub-batched tasks
+
+  // Per-task shell screening (maps and layout retain their capacity)
+  host_scratch<int32_t>              shell_keep;
+  detail::TaskShellLayout            shell_layout;
+  std::vector<std::array<int32_t,3>> xsubmat_map; ///< Submatrix map of the shells kept for X
+  std::vector<std::array<int32_t,3>> vsubmat_map; ///< Submatrix map of the shells kept for VXC
+
+  // Mixed precision
+  host_scratch<float> basis_eval_fp32;     ///< FP32 collocation, converted once per task
+  host_scratch<float> basis_eval_fp32_scr; ///< FP32 collocation of the screened shells
+  host_scratch<float> fp32_scr;
 
   // Second order derivatives
-  std::vector<F> v2rho2;
-  std::vector<F> v2rhogamma;
-  std::vector<F> v2rholapl;
-  std::vector<F> v2rhotau;
-  std::vector<F> v2gamma2;
-  std::vector<F> v2gammalapl;
-  std::vector<F> v2gammatau;
-  std::vector<F> v2lapl2;
-  std::vector<F> v2lapltau;
-  std::vector<F> v2tau2;
+  host_scratch<F> v2rho2;
+  host_scratch<F> v2rhogamma;
+  host_scratch<F> v2rholapl;
+  host_scratch<F> v2rhotau;
+  host_scratch<F> v2gamma2;
+  host_scratch<F> v2gammalapl;
+  host_scratch<F> v2gammatau;
+  host_scratch<F> v2lapl2;
+  host_scratch<F> v2lapltau;
+  host_scratch<F> v2tau2;
 
   // For Fxc contraction
-  std::vector<F> FXC_A;
-  std::vector<F> FXC_B;
-  std::vector<F> FXC_C;
-  std::vector<F> tden_scr;
-  std::vector<F> ttau;
-  std::vector<F> tlapl;
-
-   
-  inline XCHostData() {}
+  host_scratch<F> FXC_A;
+  host_scratch<F> FXC_B;
+  host_scratch<F> FXC_C;
+  host_scratch<F> tden_scr;
+  host_scratch<F> ttau;
+  host_scratch<F> tlapl;
+
+  // List of all scratch arrays
+  inline auto scratch_arrays() {
+    return std::vector<host_scratch<F>*>{ &eps, &gamma, &tau, &lapl, &vrho,
+      &vgamma, &vtau, &vlapl, &zmat, &gmat, &nbe_scr, &den_scr, &basis_eval,
+      &shell_basis_eval, &ylm_scr, &screen_scr, &shell_scr, &weights_scr, &part_weights, &vxc_blk, &v2rho2, &v2rhogamma, &v2rholapl, &v2rhotau, &v2gamma2,
+      &v2gammalapl, &v2gammatau, &v2lapl2, &v2lapltau, &v2tau2, &FXC_A, &FXC_B,
+      &FXC_C, &tden_scr, &ttau, &tlapl };
+  }
+
+  inline auto scratch_arrays_fp32() {
+    return std::vector<host_scratch<float>*>{ &basis_eval_fp32, &basis_eval_fp32_scr, &fp32_scr };
+  }
+
+  inline auto scratch_arrays_i32() {
+    return std::vector<host_scratch<int32_t>*>{ &shell_keep, &point_keep };
+  }
+
+  inline XCHostData() {
+    for( auto* s : scratch_arrays() ) *s = host_scratch<F>( &arena );
+    for( auto* s : scratch_arrays_fp32() ) *s = host_scratch<float>( &arena );
+    for( auto* s : scratch_arrays_i32() ) *s = host_scratch<int32_t>( &arena );
+  }
+
+  XCHostData( const XCHostData& ) = delete;
+
+  /** Prepare for a new integration
+   *
+   *  Invalidates all scratch arrays and coalesces the arena such that at least
+   *  `sz` elements may be carved out of a single allocation.
+   */
+  inline void reset( size_t sz = 0 ) {
+    for( auto* s : scratch_arrays() ) s->release();
+    for( auto* s : scratch_arrays_fp32() ) s->release();
+    for( auto* s : scratch_arrays_i32() ) s->release();
+    arena.reserve( sz * sizeof(F) );
+    arena.reset();
+  }
 
 };
 
@@ -10,6 +10,7 @@
  * See LICENSE.txt for details
  */
 #include <gauxc/xc_integrator/replicated/replicated_xc_integrator_impl.hpp>
+#include <gauxc/task_cost_model.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -27,6 +28,12 @@ template <typename ValueType>
 ReplicatedXCIntegratorImpl<ValueType>::
   ~ReplicatedXCIntegratorImpl() noexcept = default;
 
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::fit_cost_model_() {
+  if( auto model = load_balancer_->cost_model() )
+    model->fit( load_balancer_->runtime() );
+}
+
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   integrate_den( int64_t m, int64_t n, const value_type* P,
@@ -74,6 +81,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                 value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
 
     eval_exc_vxc_(m,n,P,ldp,VXC,ldvxc,EXC,ks_settings);
+    fit_cost_model_();
 
 }
 
@@ -91,6 +99,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                       Pz,ldpz,
                       VXCs,ldvxcs,
                       VXCz,ldvxcz,EXC, ks_settings);
+    fit_cost_model_();
 
 }
 
@@ -118,6 +127,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                       VXCz,ldvxcz,
                       VXCy,ldvxcy,
                       VXCx,ldvxcx,EXC, ks_settings);
+    fit_cost_model_();
 
 }
 
@@ -147,6 +157,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
             const IntegratorSettingsEXX& settings ) {
 
     eval_exx_(m,n,P,ldp,K,ldk,settings);
+    fit_cost_model_();
 
 }
 
@@ -203,9 +214,10 @@ void ReplicatedXCIntegratorImpl<ValueType>::
 
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
-  eval_dd_psi_potential( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx) {
+  eval_dd_psi_potential( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx,
+                         const IntegratorSettingsXC& ks_settings ) {
   
-  eval_dd_psi_potential_(m, n, X, max_Ylm, Vddx);
+  eval_dd_psi_potential_(m, n, X, max_Ylm, Vddx, ks_settings);
   
 }
   
@@ -120,7 +120,8 @@ protected:
                      int64_t ldp, unsigned max_Ylm, value_type* ddPsi, int64_t ldPsi ) override;
 
   /// ddX PhiX
-  void eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx ) override;
+  void eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx,
+                               const IntegratorSettingsXC& ks_settings ) override;
 
 
   // Implementation details of exc_vxc (for RKS/UKS/GKS deduced from input character)
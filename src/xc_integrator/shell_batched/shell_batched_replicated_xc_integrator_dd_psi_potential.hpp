@@ -19,9 +19,10 @@ namespace detail {
 
 template <typename BaseIntegratorType, typename IncoreIntegratorType>
 void ShellBatchedReplicatedXCIntegrator<BaseIntegratorType, IncoreIntegratorType>::
-  eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx ) {
+  eval_dd_psi_potential_( int64_t m, int64_t n, const value_type* X, unsigned max_Ylm, value_type* Vddx,
+                          const IntegratorSettingsXC& ks_settings ) {
   GAUXC_GENERIC_EXCEPTION("ShellBatched DD-PSI-DERIV NYI");                 
-  util::unused(m,n,X,max_Ylm, Vddx);
+  util::unused(m,n,X,max_Ylm, Vddx, ks_settings);
 }
 
 }
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <future>
 #include <set>
+#include <algorithm>
 
 namespace GauXC  {
 namespace detail {
@@ -235,6 +236,11 @@ void ShellBatchedReplicatedXCIntegrator<BaseIntegratorType, IncoreIntegratorType
   // device task
   std::future<void> task_future;
 
+  // Tasks without basis support only retain their points / weights
+  task_end = std::partition( task_begin, task_end, []( const auto& t ) {
+    return not t.bfn_screening.shell_list.empty();
+  } );
+
   auto task_it = task_begin;
   while( task_it != task_end ) {
 
@@ -0,0 +1,145 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy).
+ *
+ * (c) 2024-2025, Microsoft Corporation
+ *
+ * All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "buffer_adaptor.hpp"
+#include <vector>
+#include <optional>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+
+namespace GauXC {
+
+/** Growable host stack allocator
+ *
+ *  Carves aligned, uninitialized sub-buffers out of host memory chunks via
+ *  buffer_adaptor. Chunks are allocated lazily by the first thread that
+ *  allocates from the arena (i.e. they are first-touched by their owner).
+ *  When the current chunk is exhausted a new chunk is appended so that
+ *  outstanding buffers remain valid. The most recent buffer may be released
+ *  or grown in place (stack discipline), other released buffers are only
+ *  reclaimed by `reset`. `reset` invalidates all outstanding buffers and
+ *  coalesces the chunks into a single block sized to the high-water mark of
+ *  live buffers, such that a steady-state workload is served by one
+ *  allocation.
+ */
+class host_arena {
+
+  static constexpr size_t chunk_alignment = 64;
+
+  struct chunk_deleter {
+    void operator()( void* ptr ) const noexcept { std::free(ptr); }
+  };
+  using chunk_type = std::unique_ptr<void, chunk_deleter>;
+
+  std::vector<chunk_type>       chunks_;
+  std::optional<buffer_adaptor> stack_;
+  size_t                        capacity_ = 0; ///< Allocated bytes
+  size_t                        reserve_  = 0; ///< Requested bytes
+  size_t                        used_     = 0; ///< Bytes held by live buffers
+  size_t                        peak_     = 0; ///< High-water mark of used_
+
+  static inline size_t padded( size_t sz ) {
+    return chunk_alignment * ((sz + chunk_alignment - 1) / chunk_alignment);
+  }
+
+  inline void add_chunk( size_t sz ) {
+    sz = padded( sz );
+    void* ptr = std::aligned_alloc( chunk_alignment, sz );
+    if( not ptr )
+      GAUXC_GENERIC_EXCEPTION("host_arena std::bad_alloc nalloc = " +
+        std::to_string(sz));
+
+    chunks_.emplace_back( ptr );
+    stack_.emplace( ptr, sz );
+    capacity_ += sz;
+  }
+
+public:
+
+  host_arena() = default;
+  host_arena( const host_arena& ) = delete;
+  host_arena( host_arena&& ) noexcept = default;
+
+  /// Ensure that the arena will be able to hold at least sz bytes after the
+  /// next reset (allocation is deferred to the first aligned_alloc)
+  inline void reserve( size_t sz ) { reserve_ = std::max( reserve_, sz ); }
+
+  /// Invalidate all outstanding buffers and coalesce memory chunks
+  inline void reset() {
+    const size_t sz = std::max( peak_, reserve_ );
+    used_ = peak_ = 0;
+    if( chunks_.size() == 1 and capacity_ >= sz ) {
+      stack_.emplace( chunks_.front().get(), capacity_ );
+      return;
+    }
+
+    chunks_.clear();
+    stack_.reset();
+    capacity_ = 0;
+    reserve_  = sz;
+  }
+
+  template <typename T>
+  T* aligned_alloc( size_t len, size_t align = chunk_alignment ) {
+
+    if( len == 0ul ) return nullptr;
+
+    const size_t nbytes = len * sizeof(T);
+    used_ += padded( nbytes );
+    peak_  = std::max( peak_, used_ );
+    if( stack_ ) {
+      void*  top   = stack_->stack();
+      size_t nleft = stack_->nleft();
+      if( std::align( align, nbytes, top, nleft ) )
+        return stack_->aligned_alloc<T>( len, align ).ptr;
+    }
+
+    // Grow geometrically, honoring any outstanding reservation
+    add_chunk( std::max( { nbytes + align, capacity_, reserve_ } ) );
+    reserve_ = 0;
+    return stack_->aligned_alloc<T>( len, align ).ptr;
+
+  }
+
+  /// Release a buffer, its memory is returned to the stack if it is the
+  /// most recent allocation and reclaimed on the next reset otherwise
+  template <typename T>
+  void deallocate( T* ptr, size_t len ) {
+
+    if( not ptr ) return;
+
+    const size_t nbytes = len * sizeof(T);
+    used_ -= padded( nbytes );
+    if( stack_ and (char*)ptr + nbytes == stack_->stack() )
+      stack_.emplace( ptr, stack_->nleft() + nbytes );
+
+  }
+
+  /** Grow a buffer to len elements
+   *
+   *  The most recent allocation is grown in place if the current chunk
+   *  allows (preserving its contents), otherwise a new buffer is drawn from
+   *  the arena and the contents are not preserved.
+   */
+  template <typename T>
+  T* reallocate( T* ptr, size_t old_len, size_t len ) {
+    deallocate( ptr, old_len );
+    return aligned_alloc<T>( len );
+  }
+
+  inline size_t capacity() const { return capacity_; }
+  inline size_t nchunks()  const { return chunks_.size(); }
+
+};
+
+}
@@ -118,12 +118,30 @@ void test_fxc_contractioin(ExecutionSpace ex, const RuntimeEnvironment& rt,
     integrator_kernel, lwd_kernel, reduction_kernel);
   auto integrator = integrator_factory.get_instance(func, lb);
 
+  IntegratorSettingsKS ks_settings;
+  ks_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+
   // Test FXC contraction
   if (rks) {
     // Call FXC contraction
     auto FXC = integrator.eval_fxc_contraction(P, tP);
     auto FXC_diff_nrm = (FXC - FXC_ref).norm();
     CHECK(FXC_diff_nrm / basis.nbf() < 1e-10);
+
+    // Check thread private accumulation
+    if( ex == ExecutionSpace::Host ) {
+      auto FXC1 = integrator.eval_fxc_contraction(P, tP, ks_settings);
+      CHECK((FXC1 - FXC_ref).norm() / basis.nbf() < 1e-10);
+    }
+
+    // Check packed lower triangular reduction
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS packed_settings;
+      packed_settings.packed_vxc = true;
+      auto FXC2 = integrator.eval_fxc_contraction(P, tP, packed_settings);
+      CHECK((FXC2 - FXC_ref).norm() / basis.nbf() < 1e-10);
+      CHECK((FXC2 - FXC2.transpose()).norm() == 0.);
+    }
   } else if (uks) {
     // Call FXC contraction
     auto [FXCs, FXCz] = integrator.eval_fxc_contraction(P, Pz, tP, tPz);
@@ -132,6 +150,24 @@ void test_fxc_contractioin(ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto FXCz_diff_nrm = (FXCz - FXCz_ref).norm();
     CHECK(FXCs_diff_nrm / basis.nbf() < 1e-10);
     CHECK(FXCz_diff_nrm / basis.nbf() < 1e-10);
+
+    // Check thread private accumulation
+    if( ex == ExecutionSpace::Host ) {
+      auto [FXCs1, FXCz1] = integrator.eval_fxc_contraction(P, Pz, tP, tPz, ks_settings);
+      CHECK((FXCs1 - FXC_ref).norm() / basis.nbf() < 1e-10);
+      CHECK((FXCz1 - FXCz_ref).norm() / basis.nbf() < 1e-10);
+    }
+
+    // Check packed lower triangular reduction
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS packed_settings;
+      packed_settings.packed_vxc = true;
+      auto [FXCs2, FXCz2] = integrator.eval_fxc_contraction(P, Pz, tP, tPz, packed_settings);
+      CHECK((FXCs2 - FXC_ref).norm() / basis.nbf() < 1e-10);
+      CHECK((FXCz2 - FXCz_ref).norm() / basis.nbf() < 1e-10);
+      CHECK((FXCs2 - FXCs2.transpose()).norm() == 0.);
+      CHECK((FXCz2 - FXCz2.transpose()).norm() == 0.);
+    }
   
   }
 }
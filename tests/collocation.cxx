@@ -57,6 +57,14 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
   SECTION( "Host Eval Hessian" ) {
     test_host_collocation_deriv2( basis, ref_data );
   }
+
+  SECTION( "Host Eval Laplacian" ) {
+    test_host_collocation_laplacian( basis, ref_data );
+  }
+
+  SECTION( "Host Native Eval" ) {
+    test_host_native_collocation( basis, ref_data );
+  }
 #endif
 
 #ifdef GAUXC_HAS_CUDA
@@ -104,3 +112,17 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
 #endif
 
 }
+
+#if defined(GAUXC_HAS_HOST) && defined(GAUXC_HAS_GAU2GRID)
+TEST_CASE( "High Angular Momentum", "[collocation]" ) {
+
+  SECTION( "Cartesian" ) {
+    test_host_native_collocation_high_l( SphericalType(false) );
+  }
+
+  SECTION( "Spherical" ) {
+    test_host_native_collocation_high_l( SphericalType(true) );
+  }
+
+}
+#endif
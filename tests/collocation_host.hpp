@@ -12,6 +12,8 @@
 #ifdef GAUXC_HAS_HOST
 #include "collocation_common.hpp"
 #include "host/reference/collocation.hpp"
+#include "host/native_collocation.hpp"
+#include <numeric>
 
 void generate_collocation_data( const Molecule& mol, const BasisSet<double>& basis,
                                 std::ofstream& out_file, size_t ntask_save = 10 ) {
@@ -246,5 +248,222 @@ void test_host_collocation_deriv2( const BasisSet<double>& basis, std::ifstream&
       CHECK( d2eval_zz[i] == Approx( d.d2eval_zz[i] ) );
   }
 
+}
+
+void test_host_collocation_laplacian( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        lapl_eval( nbf * npts );
+
+
+    gau2grid_collocation_laplacian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(), lapl_eval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_x[i] == Approx( d.deval_x[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_y[i] == Approx( d.deval_y[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_z[i] == Approx( d.deval_z[i] ) );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( lapl_eval[i] == 
+        Approx( d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i] ).margin(1e-12) );
+  }
+
+}
+
+// The native kernels zero basis functions beyond the shell cutoff radius,
+// compare to the reference with margins consistent with the shell tolerance
+void test_host_native_collocation( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  const double val_margin = 1e-10, grad_margin = 5e-9, hess_margin = 5e-8;
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        d2eval_xx( nbf * npts ),
+                        d2eval_xy( nbf * npts ),
+                        d2eval_xz( nbf * npts ),
+                        d2eval_yy( nbf * npts ),
+                        d2eval_yz( nbf * npts ),
+                        d2eval_zz( nbf * npts ),
+                        lapl_eval( nbf * npts );
+
+    native_collocation( npts, mask.size(), nbf, pts.data()->data(), basis,
+      mask.data(), eval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ).margin(val_margin) );
+
+    native_collocation_gradient( npts, mask.size(), nbf, pts.data()->data(),
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(),
+      deval_z.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ).margin(val_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_x[i] == Approx( d.deval_x[i] ).margin(grad_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_y[i] == Approx( d.deval_y[i] ).margin(grad_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_z[i] == Approx( d.deval_z[i] ).margin(grad_margin) );
+
+    native_collocation_hessian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(),
+      d2eval_xx.data(), d2eval_xy.data(), d2eval_xz.data(),
+      d2eval_yy.data(), d2eval_yz.data(), d2eval_zz.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xx[i] == Approx( d.d2eval_xx[i] ).margin(hess_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xy[i] == Approx( d.d2eval_xy[i] ).margin(hess_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xz[i] == Approx( d.d2eval_xz[i] ).margin(hess_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_yy[i] == Approx( d.d2eval_yy[i] ).margin(hess_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_yz[i] == Approx( d.d2eval_yz[i] ).margin(hess_margin) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_zz[i] == Approx( d.d2eval_zz[i] ).margin(hess_margin) );
+
+    native_collocation_laplacian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(), lapl_eval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( lapl_eval[i] == 
+        Approx( d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i] ).margin(hess_margin) );
+  }
+
+}
+
+// High angular momentum (L = 3..6) shells against gau2grid, at points inside
+// the cutoff radius of every shell (no screening applies)
+void test_host_native_collocation_high_l( SphericalType pure ) {
+
+  const std::array<double,3> center = { 0.1, -0.2, 0.3 };
+
+  BasisSet<double> basis;
+  for( int32_t l = 3; l <= 6; ++l ) {
+    Shell<double>::prim_array alpha = {{ 4.5, 1.2, 0.35 }};
+    Shell<double>::prim_array coeff = {{ 0.2, 0.5, 0.4  }};
+    basis.emplace_back( PrimSize(3), AngularMomentum(l), pure, alpha, coeff,
+      center );
+  }
+
+  double rmax = std::numeric_limits<double>::infinity();
+  for( const auto& sh : basis ) rmax = std::min( rmax, sh.cutoff_radius() );
+
+  // Not a multiple of the native point block
+  const size_t npts = 203;
+  std::mt19937 gen( 17 );
+  std::uniform_real_distribution<double> dist( -1., 1. );
+  std::vector<std::array<double,3>> pts;
+  while( pts.size() < npts ) {
+    std::array<double,3> x = { dist(gen), dist(gen), dist(gen) };
+    const auto r2 = x[0]*x[0] + x[1]*x[1] + x[2]*x[2];
+    if( r2 >= 1. ) continue;
+    pts.push_back({ center[0] + 0.95 * rmax * x[0], 
+                    center[1] + 0.95 * rmax * x[1],
+                    center[2] + 0.95 * rmax * x[2] });
+  }
+
+  const size_t nshells = basis.size();
+  const size_t nbf     = basis.nbf();
+  std::vector<int32_t> mask( nshells );
+  std::iota( mask.begin(), mask.end(), 0 );
+
+  using buffer_array = std::array<std::vector<double>, 11>;
+  buffer_array ref, nat;
+  for( auto& b : ref ) b.resize( nbf * npts );
+  for( auto& b : nat ) b.resize( nbf * npts );
+
+  // Derivatives grow with L and the exponents, compare at round-off
+  // relative to the largest magnitude of each quantity
+  auto compare = [&]( std::initializer_list<size_t> quantities ) {
+    for( auto k : quantities ) {
+      double scale = 0.;
+      for( auto v : ref[k] ) scale = std::max( scale, std::abs(v) );
+      for( size_t i = 0; i < nbf * npts; ++i )
+        CHECK( nat[k][i] ==
+          Approx( ref[k][i] ).epsilon( 1e-12 ).margin( 1e-13 * scale ) );
+    }
+  };
+
+  gau2grid_collocation( npts, nshells, nbf, pts.data()->data(), basis,
+    mask.data(), ref[0].data() );
+  native_collocation( npts, nshells, nbf, pts.data()->data(), basis,
+    mask.data(), nat[0].data() );
+  compare({ 0 });
+
+  gau2grid_collocation_gradient( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), ref[0].data(), ref[1].data(), ref[2].data(),
+    ref[3].data() );
+  native_collocation_gradient( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), nat[0].data(), nat[1].data(), nat[2].data(),
+    nat[3].data() );
+  compare({ 0, 1, 2, 3 });
+
+  gau2grid_collocation_hessian( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), ref[0].data(), ref[1].data(), ref[2].data(),
+    ref[3].data(), ref[4].data(), ref[5].data(), ref[6].data(), 
+    ref[7].data(), ref[8].data(), ref[9].data() );
+  native_collocation_hessian( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), nat[0].data(), nat[1].data(), nat[2].data(),
+    nat[3].data(), nat[4].data(), nat[5].data(), nat[6].data(), 
+    nat[7].data(), nat[8].data(), nat[9].data() );
+  compare({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+
+  gau2grid_collocation_laplacian( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), ref[0].data(), ref[1].data(), ref[2].data(),
+    ref[3].data(), ref[10].data() );
+  native_collocation_laplacian( npts, nshells, nbf, pts.data()->data(),
+    basis, mask.data(), nat[0].data(), nat[1].data(), nat[2].data(),
+    nat[3].data(), nat[10].data() );
+  compare({ 0, 1, 2, 3, 10 });
+
 }
 #endif
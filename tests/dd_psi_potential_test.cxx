@@ -92,6 +92,12 @@ void test_dd_psi (
     auto ddPsiPotential_nrm = (ddPsiPotential - ddPsi_potential_ref).norm();
     CHECK( ddPsiPotential_nrm / basis.nbf() < 1e-10 );
 
+    // Check thread private accumulation
+    IntegratorSettingsKS ks_settings;
+    ks_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+    auto ddPsiPotential1 = integrator.eval_dd_psi_potential(ddX, lmax, ks_settings);
+    CHECK( (ddPsiPotential1 - ddPsi_potential_ref).norm() / basis.nbf() < 1e-10 );
+
 }
 
 TEST_CASE( "DD PSI & PSI POTENTIAL", "[dd]" ) {
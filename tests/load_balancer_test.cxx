@@ -11,7 +11,17 @@
  */
 #include "ut_common.hpp"
 #include <gauxc/load_balancer.hpp>
+#include <gauxc/molecular_weights.hpp>
 #include <gauxc/molgrid/defaults.hpp>
+#include <sstream>
+#include <cmath>
+#include <numeric>
+#include <gauxc/util/mpi.hpp>
+#include <gauxc/util/geometry.hpp>
+#include <random>
+#include <filesystem>
+#include <fstream>
+#include "host/shell_spatial_index.hpp"
 
 using namespace GauXC;
 
@@ -160,3 +170,527 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
 
 
 }
+
+TEST_CASE( "TaskCostModel", "[load_balancer]" ) {
+
+  const TaskCostModel::key_type gga_key = { TaskCostClass::GGA, TaskCostSpin::RKS };
+  const TaskCostModel::key_type lda_key = { TaskCostClass::LDA, TaskCostSpin::UKS };
+
+  // Synthetic timings t = 2e-9 * npts * nbe^2 + 5e-8 * npts
+  std::vector<XCTask> tasks;
+  for( int npts : {64, 128, 256, 512} )
+  for( int nbe  : {10, 40, 90, 160, 250} ) {
+    XCTask task;
+    task.npts = npts;
+    task.bfn_screening.nbe = nbe;
+    tasks.emplace_back( std::move(task) );
+  }
+
+  TaskCostModel model;
+  for( auto& task : tasks ) {
+    const double n = task.npts, b = task.bfn_screening.nbe;
+    model.record( gga_key, task, 2e-9 * n * b * b + 5e-8 * n );
+  }
+  model.fit();
+
+  REQUIRE( model.calibrated( gga_key ) );
+  CHECK( not model.calibrated( lda_key ) );
+  CHECK( model.xc_key() == gga_key );
+
+  const auto& c = model.coefficients( gga_key );
+  CHECK( c[0] == Approx( 2e-9 ) );
+  CHECK( c[1] == Approx( 0. ).margin( 1e-14 ) );
+  CHECK( c[2] == Approx( 5e-8 ) );
+
+  // Uncalibrated keys fall back to the analytic heuristic
+  CHECK( model.cost( lda_key, tasks[3] ) == tasks[3].cost_exc_vxc(0) );
+  CHECK( model.cost( gga_key, tasks[3] ) == 
+    size_t( std::llround( 1e9 * model.predict( gga_key, tasks[3] ) ) ) );
+
+  // Export / import
+  std::stringstream ss;
+  model.write( ss );
+  TaskCostModel model_in;
+  model_in.read( ss );
+  REQUIRE( model_in.calibrated( gga_key ) );
+  for( auto& task : tasks )
+    CHECK( model_in.predict( gga_key, task ) == Approx( model.predict( gga_key, task ) ) );
+
+  // Collective fit: each rank records a share of the samples (pending until
+  // the fit), all ranks obtain the model of the full sample set
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+  TaskCostModel model_rt;
+  for( size_t i = world.comm_rank(); i < tasks.size(); i += world.comm_size() ) {
+    const double n = tasks[i].npts, b = tasks[i].bfn_screening.nbe;
+    model_rt.record( gga_key, tasks[i], 2e-9 * n * b * b + 5e-8 * n );
+  }
+  CHECK( not model_rt.calibrated( gga_key ) );
+  model_rt.fit( world );
+  REQUIRE( model_rt.calibrated( gga_key ) );
+  CHECK( model_rt.xc_key() == gga_key );
+  for( int i = 0; i < TaskCostModel::nfeatures; ++i )
+    CHECK( model_rt.coefficients( gga_key )[i] == 
+      Approx( c[i] ).margin( 1e-14 ) );
+
+}
+
+TEST_CASE( "Rebalance", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(false) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb = lb_factory.get_instance( world, mol, mg, basis );
+
+  auto load = [&]() {
+    auto& tasks = lb.get_tasks();
+    return std::accumulate( tasks.begin(), tasks.end(), 0ul,
+      []( size_t a, const auto& t ){ return a + t.cost_exc_vxc(1); } );
+  };
+
+  auto npts_before = lb.total_npts();
+  auto load_before = load();
+  lb.rebalance_exc_vxc();
+  auto npts_after  = lb.total_npts();
+  auto load_after  = load();
+
+#ifdef GAUXC_HAS_MPI
+  // Points are conserved and the maximum load does not increase
+  npts_before = allreduce( npts_before, MPI_SUM, world.comm() );
+  npts_after  = allreduce( npts_after,  MPI_SUM, world.comm() );
+  load_before = allreduce( load_before, MPI_MAX, world.comm() );
+  load_after  = allreduce( load_after,  MPI_MAX, world.comm() );
+#endif
+
+  CHECK( npts_after == npts_before );
+  CHECK( load_after <= load_before );
+
+  for( const auto& task : lb.get_tasks() ) {
+    CHECK( task.points.size()  == size_t(task.npts) );
+    CHECK( task.weights.size() == size_t(task.npts) );
+  }
+
+}
+
+TEST_CASE( "DistributedLoadBalancer", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  auto summary = [&]( const std::vector<XCTask>& tasks ) {
+    std::array<double,2> s = {0., 0.}; // (npts, sum of weights)
+    for( const auto& t : tasks ) {
+      s[0] += t.points.size();
+      s[1] += std::accumulate( t.weights.begin(), t.weights.end(), 0. );
+    }
+#ifdef GAUXC_HAS_MPI
+    std::array<double,2> s_red;
+    allreduce( s.data(), s_red.data(), 2, MPI_SUM, world.comm() );
+    s = s_red;
+#endif
+    return s;
+  };
+
+  LoadBalancerFactory rep_factory( ExecutionSpace::Host, "Default" );
+  auto rep_lb = rep_factory.get_instance( world, mol, mg, basis );
+  const auto ref = summary( rep_lb.get_tasks() );
+
+  LoadBalancerFactory dist_factory( ExecutionSpace::Host, "Distributed" );
+  auto dist_lb = dist_factory.get_instance( world, mol, mg, basis );
+
+  // Same quadrature as the replicated generation
+  auto dist = summary( dist_lb.get_tasks() );
+  CHECK( dist[0] == ref[0] );
+  CHECK( dist[1] == Approx( ref[1] ) );
+
+  // ... also after the (optional) post-generation rebalance
+  dist_lb.rebalance_exc_vxc();
+  dist = summary( dist_lb.get_tasks() );
+  CHECK( dist[0] == ref[0] );
+  CHECK( dist[1] == Approx( ref[1] ) );
+
+}
+
+TEST_CASE( "ShellSpatialIndex", "[load_balancer]" ) {
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+  detail::ShellSpatialIndex index( basis );
+  REQUIRE( index.nshells() == basis.size() );
+
+  std::mt19937 gen( 5 );
+  std::uniform_real_distribution<double> pos( -12., 12. ), width( 0.05, 4. );
+
+  for( int iq = 0; iq < 500; ++iq ) {
+
+    std::array<double,3> lo, up;
+    for( int d = 0; d < 3; ++d ) {
+      lo[d] = pos(gen);
+      up[d] = lo[d] + width(gen);
+    }
+
+    // Reference: test every shell
+    std::vector<int32_t> ref;
+    for( size_t iSh = 0; iSh < basis.size(); ++iSh )
+      if( geometry::cube_sphere_intersect( lo, up, basis[iSh].O(), 
+          basis[iSh].cutoff_radius() ) ) ref.emplace_back( iSh );
+
+    CHECK( index.query( lo, up ) == ref );
+
+  }
+
+}
+
+TEST_CASE( "TaskCache", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(false) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  const auto dir    = std::filesystem::temp_directory_path();
+  const auto prefix = (dir / "gauxc_task_cache_test").string();
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb = lb_factory.get_instance( world, mol, mg, basis );
+  lb.state().weight_alg = XCWeightAlg::SSF; // Emulate stored modified weights
+  lb.state().modified_weights_are_stored = true;
+  lb.save_task_cache( prefix );
+
+  // Cache is keyed on the weight scheme
+  auto lb_miss = lb_factory.get_instance( world, mol, mg, basis );
+  CHECK( not lb_miss.load_task_cache( prefix, XCWeightAlg::Becke ) );
+  CHECK( not lb_miss.state().modified_weights_are_stored );
+
+  // ... and on the basis
+  auto basis_sph = make_631Gd( mol, SphericalType(true) );
+  auto lb_sph = lb_factory.get_instance( world, mol, mg, basis_sph );
+  CHECK( not lb_sph.load_task_cache( prefix, XCWeightAlg::SSF ) );
+
+  // ... on the generation mode
+  LoadBalancerFactory lb_dist_factory( ExecutionSpace::Host, "Distributed" );
+  auto lb_dist = lb_dist_factory.get_instance( world, mol, mg, basis );
+  CHECK( not lb_dist.load_task_cache( prefix, XCWeightAlg::SSF ) );
+
+  // ... and on the task layout
+  auto lb_refine = lb_factory.get_instance( world, mol, mg, basis );
+  lb_refine.refine_tasks( TaskGranularitySettings{} );
+  CHECK( lb_refine.task_layout() != 0 );
+  lb_refine.save_task_cache( prefix );
+  auto lb_layout = lb_factory.get_instance( world, mol, mg, basis );
+  CHECK( not lb_layout.load_task_cache( prefix, XCWeightAlg::SSF, 
+    lb_refine.task_layout() ) );
+  REQUIRE( lb_layout.load_task_cache( prefix, XCWeightAlg::NOTPARTITIONED, 
+    lb_refine.task_layout() ) );
+  CHECK( lb_layout.task_layout() == lb_refine.task_layout() );
+  CHECK( lb_layout.get_tasks().size() == lb_refine.get_tasks().size() );
+
+  auto lb_load = lb_factory.get_instance( world, mol, mg, basis );
+  REQUIRE( lb_load.load_task_cache( prefix, XCWeightAlg::SSF ) );
+  CHECK( lb_load.state().modified_weights_are_stored );
+  CHECK( lb_load.state().weight_alg == XCWeightAlg::SSF );
+
+  const auto& ref   = lb.get_tasks();
+  const auto& tasks = lb_load.get_tasks();
+  REQUIRE( tasks.size() == ref.size() );
+  for( size_t i = 0; i < tasks.size(); ++i ) {
+    CHECK( tasks[i].iParent == ref[i].iParent );
+    CHECK( tasks[i].npts    == ref[i].npts );
+    CHECK( tasks[i].points  == ref[i].points );
+    CHECK( tasks[i].weights == ref[i].weights );
+    CHECK( tasks[i].dist_nearest == ref[i].dist_nearest );
+    CHECK( tasks[i].bfn_screening.shell_list == ref[i].bfn_screening.shell_list );
+    CHECK( tasks[i].bfn_screening.nbe == ref[i].bfn_screening.nbe );
+  }
+
+  // Corrupt files throw (after the collective), the LoadBalancer is untouched
+  const auto rank_suffix = ".rank" + std::to_string( world.comm_rank() ) + ".gtc";
+  for( const auto& f : std::filesystem::directory_iterator(dir) ) {
+    const auto fname = f.path().filename().string();
+    if( fname.rfind("gauxc_task_cache_test", 0) == 0 and 
+        fname.size() > rank_suffix.size() and
+        fname.compare( fname.size() - rank_suffix.size(), rank_suffix.size(),
+          rank_suffix ) == 0 )
+      std::ofstream( f.path(), std::ios::binary | std::ios::trunc ) << "GAUXC";
+  }
+  auto lb_corrupt = lb_factory.get_instance( world, mol, mg, basis );
+  CHECK_THROWS( lb_corrupt.load_task_cache( prefix, XCWeightAlg::SSF ) );
+  CHECK( not lb_corrupt.state().modified_weights_are_stored );
+  CHECK( lb_corrupt.task_layout() == 0 );
+
+  for( const auto& f : std::filesystem::directory_iterator(dir) )
+    if( f.path().filename().string().rfind("gauxc_task_cache_test", 0) == 0 )
+      std::filesystem::remove( f.path() );
+
+}
+
+TEST_CASE( "UpdateGeometry", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(false) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  // Displaced geometries: small (most screening is kept) and large
+  Molecule mol_small = mol, mol_large = mol;
+  mol_small[0].x += 0.01; mol_small[1].y -= 0.02; mol_small[2].z += 0.015;
+  mol_large[0].x += 0.30; mol_large[1].y -= 0.45; mol_large[2].z += 0.20;
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  MolecularWeightsFactory mw_factory( ExecutionSpace::Host, "Default",
+    MolecularWeightsSettings{} );
+  auto mw = mw_factory.get_instance();
+
+  // (npts, integral of a sum of unit gaussians on the atoms). Only
+  // negligible (far) points may be screened differently than in a fresh
+  // generation, the integral is insensitive to those.
+  auto summary = [&]( const std::vector<XCTask>& tasks, const Molecule& m ) {
+    std::array<double,2> s = {0., 0.};
+    for( const auto& t : tasks )
+    for( size_t i = 0; i < t.points.size(); ++i ) {
+      const auto& p = t.points[i];
+      s[0] += 1.;
+      for( const auto& atom : m ) {
+        const double dx = p[0] - atom.x, dy = p[1] - atom.y, dz = p[2] - atom.z;
+        s[1] += t.weights[i] * std::exp( -(dx*dx + dy*dy + dz*dz) );
+      }
+    }
+#ifdef GAUXC_HAS_MPI
+    std::array<double,2> s_red;
+    allreduce( s.data(), s_red.data(), 2, MPI_SUM, world.comm() );
+    s = s_red;
+#endif
+    return s;
+  };
+
+  SECTION("Requires Retained Weights") {
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    mw.modify_weights( lb );
+    CHECK_THROWS( lb.update_geometry( mol_small ) );
+  }
+
+  SECTION("Changed Atoms") {
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    Molecule mol_bad = mol;
+    mol_bad[0].Z = AtomicNumber(9);
+    CHECK_THROWS( lb.update_geometry( mol_bad ) );
+  }
+
+  SECTION("Reuse") {
+
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    CHECK( lb.tasks_generation() == 0 );
+    lb.state().retain_unpartitioned_weights = true;
+    mw.modify_weights( lb );
+    const auto npts = summary( lb.get_tasks(), mol )[0];
+
+    for( const auto& new_mol : { mol_small, mol_large, mol } ) {
+
+      // Every update yields tasks of a new generation
+      const auto generation = lb.tasks_generation();
+      CHECK( generation != 0 );
+      lb.update_geometry( new_mol );
+      CHECK( lb.tasks_generation() != generation );
+      CHECK( not lb.state().modified_weights_are_stored );
+      CHECK( Molecule(lb.molecule()) == new_mol );
+      mw.modify_weights( lb );
+
+      auto new_basis = make_631Gd( new_mol, SphericalType(false) );
+      auto ref_lb = lb_factory.get_instance( world, new_mol, mg, new_basis );
+      mw.modify_weights( ref_lb );
+      CHECK( ref_lb.tasks_generation() != lb.tasks_generation() );
+
+      const auto ref = summary( ref_lb.get_tasks(), new_mol );
+      const auto upd = summary( lb.get_tasks(),     new_mol );
+      CHECK( upd[0] == npts ); // Tasks (and their points) are never dropped
+      CHECK( upd[1] == Approx( ref[1] ) );
+      CHECK( upd[1] == Approx( new_mol.size() * std::pow( M_PI, 1.5 ) ).epsilon(1e-5) );
+
+      // Shells follow their atoms
+      const auto& upd_basis = lb.basis();
+      REQUIRE( upd_basis.size() == new_basis.size() );
+      for( size_t iSh = 0; iSh < new_basis.size(); ++iSh ) 
+      for( int d = 0; d < 3; ++d )
+        CHECK( upd_basis[iSh].O()[d] == Approx( new_basis[iSh].O()[d] ) );
+
+      // Screening is conservative w.r.t. the new geometry
+      for( const auto& t : lb.get_tasks() ) {
+        std::array<double,3> lo, up;
+        lo.fill(  std::numeric_limits<double>::infinity() );
+        up.fill( -std::numeric_limits<double>::infinity() );
+        for( const auto& p : t.points )
+        for( int d = 0; d < 3; ++d ) {
+          lo[d] = std::min( lo[d], p[d] );
+          up[d] = std::max( up[d], p[d] );
+        }
+        const auto& sl = t.bfn_screening.shell_list;
+        for( size_t iSh = 0; iSh < upd_basis.size(); ++iSh ) 
+        if( geometry::cube_sphere_intersect( lo, up, upd_basis[iSh].O(),
+            upd_basis[iSh].cutoff_radius() ) )
+          CHECK( std::binary_search( sl.begin(), sl.end(), int32_t(iSh) ) );
+      }
+
+    }
+
+  }
+
+}
+
+TEST_CASE( "RefineTasks", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(false) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto ref_lb = lb_factory.get_instance( world, mol, mg, basis );
+  auto lb     = lb_factory.get_instance( world, mol, mg, basis );
+
+  const auto& ref = ref_lb.get_tasks();
+  size_t ref_max_cost = 0, ref_npts = 0;
+  double ref_wsum = 0.;
+  for( const auto& t : ref ) {
+    ref_max_cost = std::max( ref_max_cost, t.cost_exc_vxc(1) );
+    ref_npts += t.points.size();
+    ref_wsum += std::accumulate( t.weights.begin(), t.weights.end(), 0. );
+  }
+
+  TaskGranularitySettings settings;
+  settings.max_cost       = ref_max_cost / 4.;
+  settings.min_npts_x_nbe = 64 * 32;
+  lb.refine_tasks( settings );
+
+  const auto& tasks = lb.get_tasks();
+  size_t npts = 0, max_cost = 0;
+  double wsum = 0.;
+  for( const auto& t : tasks ) {
+    REQUIRE( t.points.size() == t.weights.size() );
+    max_cost = std::max( max_cost, t.cost_exc_vxc(1) );
+    REQUIRE( t.npts == (int32_t)t.points.size() );
+    npts += t.points.size();
+    wsum += std::accumulate( t.weights.begin(), t.weights.end(), 0. );
+
+    // Split up to the granularity of a single point
+    CHECK( t.cost_exc_vxc(1) <= settings.max_cost + 
+      t.bfn_screening.nbe * (2. + t.bfn_screening.nbe) );
+
+    // Screening remains conservative
+    std::array<double,3> lo, up;
+    lo.fill(  std::numeric_limits<double>::infinity() );
+    up.fill( -std::numeric_limits<double>::infinity() );
+    for( const auto& p : t.points )
+    for( int d = 0; d < 3; ++d ) {
+      lo[d] = std::min( lo[d], p[d] );
+      up[d] = std::max( up[d], p[d] );
+    }
+    const auto& sl = t.bfn_screening.shell_list;
+    REQUIRE( std::is_sorted( sl.begin(), sl.end() ) );
+    int32_t nbe = 0;
+    for( auto sh : sl ) nbe += basis[sh].size();
+    CHECK( t.bfn_screening.nbe == nbe );
+    for( size_t iSh = 0; iSh < basis.size(); ++iSh ) 
+    if( geometry::cube_sphere_intersect( lo, up, basis[iSh].O(),
+        basis[iSh].cutoff_radius() ) )
+      CHECK( std::binary_search( sl.begin(), sl.end(), int32_t(iSh) ) );
+  }
+
+  // Points and weights are preserved
+  CHECK( npts == ref_npts );
+  CHECK( max_cost < ref_max_cost );
+  CHECK( wsum == Approx( ref_wsum ) );
+
+  // With a calibrated cost model, split and merge decisions are both made
+  // on the model costs
+  auto model = std::make_shared<TaskCostModel>();
+  const auto key = model->xc_key();
+  for( const auto& t : ref ) {
+    const double n = t.points.size(), nbe = t.bfn_screening.nbe;
+    model->record( key, t, 1e-9 * ( n*nbe*nbe + 10.*n*nbe + 100.*n ) );
+  }
+  model->fit();
+  REQUIRE( model->calibrated( key ) );
+
+  size_t ref_max_model_cost = 0;
+  for( const auto& t : ref ) 
+    ref_max_model_cost = std::max( ref_max_model_cost, model->cost( key, t ) );
+
+  auto model_lb = lb_factory.get_instance( world, mol, mg, basis );
+  model_lb.set_cost_model( model );
+  TaskGranularitySettings model_settings;
+  model_settings.max_cost       = ref_max_model_cost / 4.;
+  model_settings.min_npts_x_nbe = 64 * 32;
+  model_lb.refine_tasks( model_settings );
+
+  size_t model_npts = 0;
+  for( const auto& t : model_lb.get_tasks() ) {
+    model_npts += t.points.size();
+    // Split up to the granularity of a single point
+    CHECK( model->cost( key, t ) <= model_settings.max_cost + 
+      1e9 * model->predict( key, t ) / t.points.size() + 1. );
+  }
+  CHECK( model_npts == ref_npts );
+
+}
+
+TEST_CASE( "CompactTasks", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(false) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb = lb_factory.get_instance( world, mol, mg, basis );
+
+  const auto ref      = lb.get_tasks();
+  const auto ref_npts = lb.total_npts();
+  const auto ref_nbe  = lb.max_nbe();
+  const auto ref_vol  = lb.tasks_volume();
+
+  lb.compact_tasks();
+  CHECK( lb.tasks_are_compact() );
+  CHECK( lb.tasks_volume() <= ref_vol );
+  CHECK( lb.total_npts() == ref_npts );
+  CHECK( lb.max_nbe() == ref_nbe );
+
+  const auto& lb_const = lb;
+  CHECK_THROWS( lb_const.get_tasks() );
+
+  // Expanded on access
+  const auto& tasks = lb.get_tasks();
+  CHECK( not lb.tasks_are_compact() );
+  REQUIRE( tasks.size() == ref.size() );
+  for( size_t i = 0; i < tasks.size(); ++i ) {
+    CHECK( tasks[i].iParent == ref[i].iParent );
+    CHECK( tasks[i].npts    == ref[i].npts );
+    CHECK( tasks[i].points  == ref[i].points );
+    CHECK( tasks[i].weights == ref[i].weights );
+    CHECK( tasks[i].dist_nearest == ref[i].dist_nearest );
+    CHECK( tasks[i].bfn_screening.shell_list == ref[i].bfn_screening.shell_list );
+    CHECK( tasks[i].bfn_screening.nbe == ref[i].bfn_screening.nbe );
+  }
+
+}
@@ -395,4 +395,67 @@ TEST_CASE("Weights First Derivative contracted HOST fidiff", "[weights_fdiff]")
   //                                     PruningScheme::Unpruned, 1.0e-5, 1.0e-6);}
   
 
-}
\ No newline at end of file
+}
+
+// Compare the contracted weight derivative of the HOST-OPT driver (screened
+// over per-task local atom sets) to the reference implementation
+void test_weight_1st_deri_host_opt_contracted(const std::string& reference_file,
+  XCWeightAlg weight_alg) {
+
+  auto rt = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+  Molecule mol;
+  BasisSet<double> basis;
+  read_hdf5_record(mol, reference_file, "/MOLECULE");
+  read_hdf5_record(basis, reference_file, "/BASIS");
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory(ExecutionSpace::Host, "Default");
+  auto lb = lb_factory.get_instance(rt, mol, mg, basis);
+
+  MolecularWeightsFactory mw_factory(ExecutionSpace::Host, "Default",
+    MolecularWeightsSettings{weight_alg, false});
+  auto mw = mw_factory.get_instance();
+  mw.modify_weights(lb);
+
+  auto lwd_ref = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Default", LocalWorkSettings() );
+  auto lwd_opt = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "HOST-OPT", LocalWorkSettings() );
+  auto* lwd_ref_host = dynamic_cast<LocalHostWorkDriver*>(lwd_ref.get());
+  auto* lwd_opt_host = dynamic_cast<LocalHostWorkDriver*>(lwd_opt.get());
+
+  const auto& meta = lb.molmeta();
+  lwd_opt_host->prepare_partition_weights(weight_alg, mol, meta);
+
+  const size_t natoms = mol.size();
+  std::vector<double> grad_ref(3 * natoms, 0.), grad_opt(3 * natoms, 0.);
+  std::vector<double> w_times_f;
+  for(const auto& task : lb.get_tasks()) {
+    w_times_f.resize(task.npts);
+    for(size_t i = 0; i < task.npts; i++)
+      w_times_f[i] = task.weights[i] * static_cast<double>(rand()) / RAND_MAX;
+
+    lwd_ref_host->eval_weight_1st_deriv_contracted(weight_alg, mol, meta, task,
+      w_times_f.data(), grad_ref.data());
+    lwd_opt_host->eval_weight_1st_deriv_contracted(weight_alg, mol, meta, task,
+      w_times_f.data(), grad_opt.data());
+  }
+
+  for(size_t i = 0; i < 3 * natoms; i++) {
+    INFO("Atom " << i / 3 << ", Coord " << i % 3);
+    CHECK(grad_opt[i] == Approx(grad_ref[i]).margin(1e-10));
+  }
+
+}
+
+TEST_CASE("Weights First Derivative contracted HOST-OPT", "[weights_fdiff]") {
+
+  SECTION( "Benzene Becke" ) {
+  test_weight_1st_deri_host_opt_contracted(GAUXC_REF_DATA_PATH "/benzene_svwn5_cc-pvdz_ufg_ssf.hdf5", XCWeightAlg::Becke);}
+
+  SECTION( "Benzene SSF" ) {
+  test_weight_1st_deri_host_opt_contracted(GAUXC_REF_DATA_PATH "/benzene_svwn5_cc-pvdz_ufg_ssf.hdf5", XCWeightAlg::SSF);}
+
+}
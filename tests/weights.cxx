@@ -58,6 +58,11 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
                           std::ios::binary );
   test_host_weights( ref_data, XCWeightAlg::Becke );
   }
+  SECTION("Becke Blocked") {
+  std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_becke.bin", 
+                          std::ios::binary );
+  test_host_opt_weights( ref_data, XCWeightAlg::Becke );
+  }
   SECTION("LKO") {
   std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_lko.bin", 
                           std::ios::binary );
@@ -75,6 +80,9 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   SECTION( "Host Weights" ) {
     test_host_weights( ref_data, XCWeightAlg::SSF );
   }
+  SECTION( "Host Cell List Weights" ) {
+    test_host_opt_weights( ref_data, XCWeightAlg::SSF );
+  }
 #endif
 
 #ifdef GAUXC_HAS_DEVICE
@@ -16,6 +16,7 @@
 
 #ifdef GAUXC_HAS_HOST
 #include "host/reference/weights.hpp"
+#include "host/cell_list_weights.hpp"
 using namespace GauXC;
 
 void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
@@ -57,5 +58,42 @@ void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
     }
   }
 
+}
+
+void test_host_opt_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
+
+  ref_weights_data ref_data;
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  switch(weight_alg) {
+    case XCWeightAlg::Becke:
+      blocked_becke_weights_host( 
+        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
+        ref_data.tasks_unm.end() );
+      break;
+    case XCWeightAlg::SSF:
+      cell_list_ssf_weights_host( 
+        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
+        ref_data.tasks_unm.end() );
+      break;
+    default:
+      GAUXC_GENERIC_EXCEPTION("Weight Alg Not Supported");
+  }
+
+  size_t ntasks = ref_data.tasks_unm.size();
+  for( size_t itask = 0; itask < ntasks; ++itask ) {
+    auto& task     = ref_data.tasks_unm.at(itask);
+    auto& ref_task = ref_data.tasks_mod.at(itask);
+
+    size_t npts = task.weights.size();
+    for( size_t i = 0; i < npts; ++i ) {
+      CHECK( task.weights.at(i) ==
+             Approx(ref_task.weights.at(i)).margin(1e-12) );
+    }
+  }
+
 }
 #endif
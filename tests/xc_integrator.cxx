@@ -21,6 +21,8 @@
 #include <highfive/H5File.hpp>
 #include <Eigen/Core>
 
+#include "xc_integrator/replicated/host/host_point_compaction.hpp"
+
 using namespace GauXC;
 
 
@@ -186,6 +188,17 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     integrator_kernel, lwd_kernel, reduction_kernel );
   auto integrator = integrator_factory.get_instance( func, lb );
 
+  // Integrator over a LoadBalancer with on-the-fly weight partitioning
+  // (weights are never stored)
+  auto make_otf_integrator = [&]() {
+    auto otf_lb = lb_factory.get_instance(rt, mol, mg, basis);
+    MolecularWeightsSettings otf_settings;
+    otf_settings.on_the_fly = true;
+    MolecularWeightsFactory otf_mw_factory( ex, "Default", otf_settings );
+    otf_mw_factory.get_instance().modify_weights(otf_lb);
+    return integrator_factory.get_instance( func, otf_lb );
+  };
+
   // Integrate Density
   if( check_integrate_den and rks) {
     auto N_EL_ref = std::accumulate( mol.begin(), mol.end(), 0ul,
@@ -215,6 +228,106 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto EXC2 = integrator.eval_exc( P );
     CHECK(EXC2 == Approx(EXC));
 
+    // Check incremental builds (LDA/GGA only)
+    if( ex == ExecutionSpace::Host and not func.is_mgga() ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.incremental_vxc = true;
+
+      // Full build (repeated builds are checked with the settings table)
+      integrator.eval_exc_vxc( P, ks_settings );
+
+      // Perturbed density: incremental must match a full build
+      matrix_type P2 = 1.01 * P;
+      auto [ EXC8, VXC8 ] = integrator.eval_exc_vxc( P2, ks_settings );
+      IntegratorSettingsKS full_settings;
+      auto [ EXC9, VXC9 ] = integrator.eval_exc_vxc( P2, full_settings );
+      CHECK( EXC8 == Approx( EXC9 ) );
+      CHECK( ( VXC8 - VXC9 ).norm() / basis.nbf() < 1e-10 );
+
+      // Perturb the block of the last shell above the tolerance and every
+      // other element below it: tasks without the last shell reuse their
+      // VXC, but EXC / N_EL are always evaluated with the new density
+      ks_settings.incremental_vxc_tol = 1e-8;
+      auto [ EXC10, VXC10 ] = integrator.eval_exc_vxc( P2, ks_settings );
+      CHECK( EXC10 == Approx( EXC9 ) );
+
+      const int32_t sh_sz = basis.back().size();
+      const int32_t sh_st = basis.nbf() - sh_sz;
+      matrix_type P3 = P2;
+      P3.array() += 0.4e-8;
+      P3.block( sh_st, sh_st, sh_sz, sh_sz ).array() += 1e-3;
+      auto [ EXC11, VXC11 ] = integrator.eval_exc_vxc( P3, ks_settings );
+      auto [ EXC12, VXC12 ] = integrator.eval_exc_vxc( P3, full_settings );
+      CHECK( EXC11 == Approx( EXC12 ) );
+      CHECK( ( VXC11 - VXC12 ).norm() / basis.nbf() < 1e-7 );
+
+      // Every block below the tolerance: all tasks reuse their VXC
+      matrix_type P4 = P3;
+      P4.array() += 0.4e-8;
+      auto [ EXC13, VXC13 ] = integrator.eval_exc_vxc( P4, ks_settings );
+      auto [ EXC14, VXC14 ] = integrator.eval_exc_vxc( P4, full_settings );
+      CHECK( EXC13 == Approx( EXC14 ).epsilon(1e-12) );
+      CHECK( EXC13 != EXC11 );
+      CHECK( ( VXC13 - VXC11 ).norm() == 0. );
+      CHECK( ( VXC13 - VXC14 ).norm() / basis.nbf() < 1e-7 );
+    }
+
+    // Check density matrix driven shell screening (LDA/GGA only)
+    if( ex == ExecutionSpace::Host and not func.is_mgga() ) {
+      // A looser tolerance drops shells: the (bitwise reproducible) result
+      // changes, within the error bound of the screening
+      IntegratorSettingsKS det_settings;
+      det_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+      det_settings.deterministic_accumulation = true;
+      auto [ EXC10a, VXC10a ] = integrator.eval_exc_vxc( P, det_settings );
+      det_settings.density_screening_tol = 1e-8;
+      auto [ EXC10b, VXC10b ] = integrator.eval_exc_vxc( P, det_settings );
+      CHECK( ( VXC10b - VXC10a ).norm() > 0. );
+      CHECK( EXC10b == Approx( EXC10a ).epsilon(1e-6) );
+      CHECK( ( VXC10b - VXC10a ).norm() / basis.nbf() < 1e-6 );
+    }
+
+    // Check grid point compaction (LDA/GGA only)
+    if( ex == ExecutionSpace::Host and not func.is_mgga() ) {
+      // A looser tolerance drops points: the (bitwise reproducible) result
+      // changes, within the error bound of the compaction
+      IntegratorSettingsKS det_settings;
+      det_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+      det_settings.deterministic_accumulation = true;
+      auto [ EXC11a, VXC11a ] = integrator.eval_exc_vxc( P, det_settings );
+      det_settings.point_density_tol = 1e-8;
+      auto [ EXC11b, VXC11b ] = integrator.eval_exc_vxc( P, det_settings );
+      CHECK( ( VXC11b - VXC11a ).norm() > 0. );
+      CHECK( EXC11b == Approx( EXC11a ).epsilon(1e-6) );
+      CHECK( ( VXC11b - VXC11a ).norm() / basis.nbf() < 1e-6 );
+    }
+
+    // Check on-the-fly weight partitioning
+    if( ex == ExecutionSpace::Host ) {
+      auto otf_integrator = make_otf_integrator();
+      auto [ EXC15, VXC15 ] = otf_integrator.eval_exc_vxc( P );
+      CHECK( not otf_integrator.load_balancer().state().modified_weights_are_stored );
+      CHECK( EXC15 == Approx( EXC_ref ) );
+      CHECK( ( VXC15 - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+    }
+
+    // Check compacted tasks (expanded by the first evaluation and kept
+    // expanded, such that later evaluations reuse the same tasks)
+    if( ex == ExecutionSpace::Host ) {
+      auto cmp_integrator = integrator_factory.get_instance( func, lb );
+      auto& cmp_lb = cmp_integrator.load_balancer();
+      cmp_lb.compact_tasks();
+      size_t generation = 0;
+      for( int i = 0; i < 2; ++i ) {
+        auto [ EXC17, VXC17 ] = cmp_integrator.eval_exc_vxc( P );
+        CHECK( not cmp_lb.tasks_are_compact() );
+        if( i ) CHECK( cmp_lb.tasks_generation() == generation );
+        generation = cmp_lb.tasks_generation();
+        CHECK( EXC17 == Approx( EXC_ref ) );
+        CHECK( ( VXC17 - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+      }
+    }
+
   } else if (uks) {
     auto [ EXC, VXC, VXCz ] = integrator.eval_exc_vxc( P, Pz );
 
@@ -237,6 +350,32 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     // Check EXC-only path
     auto EXC2 = integrator.eval_exc( P, Pz );
     CHECK(EXC2 == Approx(EXC));
+
+    // Check density matrix driven shell screening (LDA/GGA only)
+    if( ex == ExecutionSpace::Host and not func.is_mgga() ) {
+      // A looser tolerance drops shells, within the error bound of the
+      // screening
+      IntegratorSettingsKS det_settings;
+      det_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+      det_settings.deterministic_accumulation = true;
+      auto [ EXC5, VXC5, VXCz5 ] = integrator.eval_exc_vxc( P, Pz, det_settings );
+      det_settings.density_screening_tol = 1e-8;
+      auto [ EXC6, VXC6, VXCz6 ] = integrator.eval_exc_vxc( P, Pz, det_settings );
+      CHECK( ( VXC6 - VXC5 ).norm() + ( VXCz6 - VXCz5 ).norm() > 0. );
+      CHECK( EXC6 == Approx( EXC5 ).epsilon(1e-6) );
+      CHECK( ( VXC6  - VXC5  ).norm() / basis.nbf() < 1e-6 );
+      CHECK( ( VXCz6 - VXCz5 ).norm() / basis.nbf() < 1e-6 );
+    }
+
+    // Check on-the-fly weight partitioning
+    if( ex == ExecutionSpace::Host ) {
+      auto otf_integrator = make_otf_integrator();
+      auto [ EXC7, VXC7, VXCz7 ] = otf_integrator.eval_exc_vxc( P, Pz );
+      CHECK( not otf_integrator.load_balancer().state().modified_weights_are_stored );
+      CHECK( EXC7 == Approx( EXC_ref ) );
+      CHECK( ( VXC7  - VXC_ref  ).norm() / basis.nbf() < 1e-10 );
+      CHECK( ( VXCz7 - VXCz_ref ).norm() / basis.nbf() < 1e-10 );
+    }
   } else if (gks) {
     auto [ EXC, VXC, VXCz, VXCy, VXCx ] = integrator.eval_exc_vxc( P, Pz, Py, Px );
 
@@ -268,10 +407,155 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     // Check EXC-only path
     auto EXC2 = integrator.eval_exc( P, Pz, Py, Px );
     CHECK(EXC2 == Approx(EXC));
+
+    // Shell screening is not applied to GKS
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.density_screening_tol = 1e-8;
+      auto [ EXC4, VXC4, VXCz4, VXCy4, VXCx4 ] = 
+        integrator.eval_exc_vxc( P, Pz, Py, Px, ks_settings );
+      CHECK( EXC4 == Approx( EXC_ref ) );
+      CHECK( ( VXC4  - VXC_ref  ).norm() / basis.nbf() < 1e-10 );
+      CHECK( ( VXCz4 - VXCz_ref ).norm() / basis.nbf() < 1e-10 );
+      CHECK( ( VXCy4 - VXCy_ref ).norm() / basis.nbf() < 1e-10 );
+      CHECK( ( VXCx4 - VXCx_ref ).norm() / basis.nbf() < 1e-10 );
+    }
+  }
+
+  // Check Host IntegratorSettingsKS variants against the reference. Settings
+  // which do not apply to the functional / spin type are ignored and must
+  // reproduce the reference as well.
+  if( ex == ExecutionSpace::Host ) {
+
+    static constexpr double approx_eps = 100 * std::numeric_limits<float>::epsilon();
+    struct settings_case {
+      std::string          name;
+      IntegratorSettingsKS settings;
+      double vxc_tol      = 1e-10; ///< Bound on ||VXC - VXC_ref|| / nbf
+      double exc_eps      = approx_eps; ///< Relative tolerance of EXC
+      int    ncalls       = 1;     ///< Repeated calls (cross-call state)
+      bool   reproducible = false; ///< Repeated calls are bitwise identical
+      bool   symmetric    = false; ///< VXC is exactly symmetric
+    };
+
+    auto ks = []( auto&& configure ) {
+      IntegratorSettingsKS s;
+      configure( s );
+      return s;
+    };
+
+    const std::vector<settings_case> cases = {
+      { "ThreadPrivate", ks( []( auto& s ) {
+          s.host_accumulation = HostAccumulation::ThreadPrivate; 
+        }) },
+      { "ThreadPrivate (deterministic)", ks( []( auto& s ) {
+          s.host_accumulation = HostAccumulation::ThreadPrivate;
+          s.deterministic_accumulation = true;
+        }), 1e-10, approx_eps, 2, true },
+      // Private copies exceeding the memory bound fall back to atomics
+      { "ThreadPrivate (bounded)", ks( []( auto& s ) {
+          s.host_accumulation = HostAccumulation::ThreadPrivate;
+          s.host_accumulation_max_bytes = 1;
+        }) },
+      // The first call populates the cache
+      { "Collocation cache", ks( []( auto& s ) {
+          s.collocation_cache_bytes = 1ul << 30;
+        }), 1e-10, approx_eps, 2 },
+      { "Collocation cache (FP32)", ks( []( auto& s ) {
+          s.collocation_cache_bytes = 1ul << 30;
+          s.collocation_cache_storage = CollocationCacheStorage::FP32;
+        }), 1e-6, 1e-6, 2 },
+      // The first build is a full build, the second skips every task
+      { "Incremental", ks( []( auto& s ) {
+          s.incremental_vxc = true;
+        }), 1e-10, approx_eps, 2 },
+      // Incremental builds take precedence over the other settings
+      { "Incremental + screening + sub-batching", ks( []( auto& s ) {
+          s.incremental_vxc = true;
+          s.density_screening_tol = 1e-14;
+          s.point_chunk_size = 48;
+        }), 1e-10, approx_eps, 2 },
+      { "Density screening", ks( []( auto& s ) {
+          s.density_screening_tol = 1e-14;
+        }) },
+      { "Point compaction", ks( []( auto& s ) {
+          s.point_density_tol = 1e-14;
+        }) },
+      { "Mixed precision", ks( []( auto& s ) {
+          s.mixed_precision = true;
+          s.mixed_precision_scf_error = 1.;
+        }), 1e-5, 1e-5 },
+      // Converged SCF: FP64 throughout
+      { "Mixed precision (converged)", ks( []( auto& s ) {
+          s.mixed_precision = true;
+          s.mixed_precision_scf_error = 1e-8;
+        }) },
+      { "Mixed precision + screening + compaction", ks( []( auto& s ) {
+          s.mixed_precision = true;
+          s.mixed_precision_scf_error = 1.;
+          s.density_screening_tol = 1e-14;
+          s.point_density_tol     = 1e-14;
+        }), 1e-5, 1e-5 },
+      { "Packed", ks( []( auto& s ) {
+          s.packed_vxc = true;
+        }), 1e-10, approx_eps, 1, false, true },
+      // Split tasks accumulate VXC into per-task blocks (with sub-batched
+      // collocation reuse)
+      { "Point sub-batching", ks( []( auto& s ) {
+          s.point_chunk_size = 48;
+          s.collocation_cache_bytes = 1ul << 30;
+        }), 1e-10, approx_eps, 2 },
+    };
+
+    // EXC and every spin component of VXC
+    auto eval_exc_vxc = [&]( const IntegratorSettingsKS& settings ) {
+      std::pair< double, std::vector<matrix_type> > res;
+      if( rks ) {
+        auto [ EXC_s, VXC_s ] = integrator.eval_exc_vxc( P, settings );
+        res = { EXC_s, { VXC_s } };
+      } else if( uks ) {
+        auto [ EXC_s, VXC_s, VXCz_s ] = 
+          integrator.eval_exc_vxc( P, Pz, settings );
+        res = { EXC_s, { VXC_s, VXCz_s } };
+      } else {
+        auto [ EXC_s, VXC_s, VXCz_s, VXCy_s, VXCx_s ] = 
+          integrator.eval_exc_vxc( P, Pz, Py, Px, settings );
+        res = { EXC_s, { VXC_s, VXCz_s, VXCy_s, VXCx_s } };
+      }
+      return res;
+    };
+
+    std::vector<const matrix_type*> VXC_refs = { &VXC_ref };
+    if( not rks ) VXC_refs.push_back( &VXCz_ref );
+    if( gks ) { 
+      VXC_refs.push_back( &VXCy_ref ); 
+      VXC_refs.push_back( &VXCx_ref ); 
+    }
+
+    for( const auto& c : cases ) {
+      INFO( "IntegratorSettingsKS: " << c.name );
+      std::pair< double, std::vector<matrix_type> > prev;
+      for( int i = 0; i < c.ncalls; ++i ) {
+        auto res = eval_exc_vxc( c.settings );
+        const auto& [ EXC_c, VXC_c ] = res;
+        CHECK( EXC_c == Approx( EXC_ref ).epsilon( c.exc_eps ) );
+        for( size_t k = 0; k < VXC_c.size(); ++k ) {
+          CHECK( ( VXC_c[k] - *VXC_refs[k] ).norm() / basis.nbf() < c.vxc_tol );
+          if( c.symmetric ) 
+            CHECK( ( VXC_c[k] - VXC_c[k].transpose() ).norm() == 0. );
+          if( c.reproducible and i ) 
+            CHECK( ( VXC_c[k] - prev.second[k] ).norm() == 0. );
+        }
+        if( c.reproducible and i ) CHECK( EXC_c == prev.first );
+        prev = std::move(res);
+      }
+    }
+
   }
 
 
 
+
   // Check EXC Grad
   if( check_grad and has_exc_grad_full ) {
     IntegratorSettingsEXC_GRAD exc_grad_settings;
@@ -283,6 +567,17 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto EXC_GRAD_diff_nrm = (EXC_GRAD_ref_map - EXC_GRAD_map).norm();
     INFO("comparing full gradient");
     CHECK( EXC_GRAD_diff_nrm / std::sqrt(3.0*mol.size()) < 1e-8 );
+
+    // On-the-fly weight partitioning
+    if( ex == ExecutionSpace::Host ) {
+      auto otf_integrator = make_otf_integrator();
+      auto EXC_GRAD_otf = rks ? 
+        otf_integrator.eval_exc_grad( P, exc_grad_settings ) : 
+        otf_integrator.eval_exc_grad( P, Pz, exc_grad_settings );
+      map_type EXC_GRAD_otf_map( EXC_GRAD_otf.data(), mol.size(), 3 );
+      CHECK( (EXC_GRAD_ref_map - EXC_GRAD_otf_map).norm() / 
+        std::sqrt(3.0*mol.size()) < 1e-8 );
+    }
   }
   if( check_grad and has_exc_grad_HellFey ) {
     IntegratorSettingsEXC_GRAD exc_grad_settings;
@@ -294,6 +589,17 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto EXC_GRAD_diff_nrm = (EXC_GRAD_ref_map - EXC_GRAD_map).norm();
     INFO("comparing Hellmann-Feynman gradient");
     CHECK( EXC_GRAD_diff_nrm / std::sqrt(3.0*mol.size()) < 1e-8 );
+
+    // On-the-fly weight partitioning
+    if( ex == ExecutionSpace::Host ) {
+      auto otf_integrator = make_otf_integrator();
+      auto EXC_GRAD_otf = rks ? 
+        otf_integrator.eval_exc_grad( P, exc_grad_settings ) : 
+        otf_integrator.eval_exc_grad( P, Pz, exc_grad_settings );
+      map_type EXC_GRAD_otf_map( EXC_GRAD_otf.data(), mol.size(), 3 );
+      CHECK( (EXC_GRAD_ref_map - EXC_GRAD_otf_map).norm() / 
+        std::sqrt(3.0*mol.size()) < 1e-8 );
+    }
   }
 
 
@@ -307,6 +613,21 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto K = integrator.eval_exx( P );
     CHECK((K - K.transpose()).norm() < std::numeric_limits<double>::epsilon()); // Symmetric
     CHECK( (K - K_ref).norm() / basis.nbf() < 1e-7 );
+
+    IntegratorSettingsSNLinK sn_link_settings;
+    sn_link_settings.host_accumulation = HostAccumulation::ThreadPrivate;
+    auto K1 = integrator.eval_exx( P, sn_link_settings );
+    CHECK( (K1 - K_ref).norm() / basis.nbf() < 1e-7 );
+
+    // On-the-fly weight partitioning (the weights are still not stored)
+    if( ex == ExecutionSpace::Host ) {
+      auto otf_integrator = make_otf_integrator();
+      for( int i = 0; i < 2; ++i ) {
+        auto K2 = otf_integrator.eval_exx( P );
+        CHECK( not otf_integrator.load_balancer().state().modified_weights_are_stored );
+        CHECK( (K2 - K_ref).norm() / basis.nbf() < 1e-7 );
+      }
+    }
   }
 
 }
@@ -329,6 +650,10 @@ void test_integrator(std::string reference_file, functional_type& func, PruningS
         test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
           pruning_scheme, false, false, false, "ShellBatched" );
       }
+      SECTION("HOST-OPT") {
+        test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
+          pruning_scheme, true, true, true, "Default", "Default", "HOST-OPT" );
+      }
     }
 #endif
 
@@ -390,6 +715,27 @@ functional_type make_functional(ExchCXX::Functional func_key, ExchCXX::Spin spin
 }
 
 
+TEST_CASE( "Host Point Compaction", "[xc-integrator]" ) {
+
+  // 2 blocks of (3,5) values, value = 100*block + 10*point + row
+  const size_t m = 3, npts = 5, ncomp = 2;
+  std::vector<double> A( ncomp * m * npts );
+  for( size_t c = 0; c < ncomp; ++c )
+  for( size_t i = 0; i < npts;  ++i )
+  for( size_t j = 0; j < m;     ++j )
+    A[ j + i*m + c*m*npts ] = 100*c + 10*i + j;
+
+  const std::vector<int32_t> kept = { 1, 2, 4 };
+  detail::compact_point_blocks( m, npts, ncomp, kept.size(), kept.data(),
+    A.data() );
+
+  for( size_t c = 0; c < ncomp;       ++c )
+  for( size_t k = 0; k < kept.size(); ++k )
+  for( size_t j = 0; j < m;           ++j )
+    CHECK( A[ j + k*m + c*m*kept.size() ] == 100*c + 10*kept[k] + j );
+
+}
+
 TEST_CASE( "XC Integrator", "[xc-integrator]" ) {
 
   auto pol     = ExchCXX::Spin::Polarized;